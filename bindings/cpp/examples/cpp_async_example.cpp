@@ -0,0 +1,79 @@
+/**
+ * @file cpp_async_example.cpp
+ * @brief Example usage of the asynchronous Session operations with a poll() event loop
+ *
+ * @copyright
+ * Copyright 2019 Deutsche Telekom AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <poll.h>
+#include <unistd.h>
+#include <vector>
+
+#include "Session.hpp"
+
+using namespace std;
+
+int
+main(int argc, char **argv)
+{
+    try {
+        auto conn = std::make_shared<sysrepo::Connection>();
+        const char *xpaths[] = {"/ietf-interfaces:interfaces", "/ietf-netconf-acm:nacm", "/ietf-yang-library:*"};
+
+        /* submit a request on each session, none of them blocks and they are executed by the shared threads */
+        vector<shared_ptr<sysrepo::Session>> sessions;
+        vector<future<libyang::S_Data_Node>> requests;
+        vector<struct pollfd> pfds;
+        for (auto xpath : xpaths) {
+            auto sess = std::make_shared<sysrepo::Session>(conn);
+            requests.push_back(sess->async_get_data(xpath));
+            pfds.push_back({sess->async_event_pipe(), POLLIN, 0});
+            sessions.push_back(sess);
+        }
+
+        /* wait for the completions of all the sessions in one event loop */
+        size_t done = 0;
+        while (done < requests.size()) {
+            if (poll(pfds.data(), pfds.size(), -1) == -1) {
+                break;
+            }
+
+            for (auto &pfd : pfds) {
+                char buf[16];
+                while (read(pfd.fd, buf, sizeof buf) > 0) {}
+            }
+
+            /* collect all the finished requests */
+            for (auto &req : requests) {
+                if (req.valid() && (req.wait_for(chrono::seconds(0)) == future_status::ready)) {
+                    auto data = req.get();
+                    if (data) {
+                        cout << data->print_mem(LYD_XML, LYP_FORMAT) << endl;
+                    }
+                    ++done;
+                }
+            }
+        }
+    } catch( const std::exception& e ) {
+        cout << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
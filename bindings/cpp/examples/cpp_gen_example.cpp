@@ -0,0 +1,90 @@
+/**
+ * @file cpp_gen_example.cpp
+ * @brief Example usage of the typed accessors generated by sysrepo-cpp-gen for test-examples
+ *
+ * @copyright
+ * Copyright 2019 Deutsche Telekom AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <libyang/Libyang.hpp>
+#include "Session.hpp"
+#include "Generated.hpp"
+
+/* generated during the build by "sysrepo-cpp-gen test-examples.yang" */
+#include "test-examples.hpp"
+
+using namespace std;
+
+#define ITEM_COUNT 100
+
+int
+main(int argc, char **argv)
+{
+    uint32_t count = 0, sum = 0;
+
+    try {
+        auto conn = std::make_shared<sysrepo::Connection>();
+
+        if (argc > 1) {
+            /* install the module from the given path, it is installed once there are no connections */
+            try {
+                conn->install_module(argv[1], nullptr, {});
+            } catch (const sysrepo::sysrepo_exception &ex) {
+                if (ex.error_code() != SR_ERR_EXISTS) {
+                    throw;
+                }
+            }
+            conn = nullptr;
+            conn = std::make_shared<sysrepo::Connection>();
+        }
+        auto sess = std::make_shared<sysrepo::Session>(conn);
+
+        /* resolve all the schema nodes once */
+        test_examples::Schema schema(sess->get_context()->swig_ctx());
+
+        /* create the data */
+        test_examples::Edit edit(schema);
+        auto perf = edit.perf();
+        for (uint32_t i = 0; i < ITEM_COUNT; ++i) {
+            perf.add_item(i).set_value(i * 2);
+        }
+        sess->edit_batch(edit.release(), "merge");
+        sess->apply_changes();
+
+        /* read the data back */
+        auto tree = sess->get_data(test_examples::paths::perf);
+        for (auto item : test_examples::Data(schema, tree).perf().item()) {
+            if (!item.has_value() || (item.value() != item.id() * 2)) {
+                cerr << "Unexpected value of item " << item.id() << endl;
+                return EXIT_FAILURE;
+            }
+            ++count;
+            sum += item.value();
+        }
+        cout << "Read " << count << " items with the value sum " << sum << endl;
+
+        /* clean up */
+        sess->delete_item(test_examples::paths::perf);
+        sess->apply_changes();
+    } catch (const exception &e) {
+        cerr << "Error: " << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return (count == ITEM_COUNT) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file cpp_get_items_perf_example.cpp
+ * @brief Benchmark of the shared_ptr-based Vals and the move-only Vals_Array wrappers on a large result set
+ *
+ * @copyright
+ * Copyright 2019 Deutsche Telekom AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Session.hpp"
+
+using namespace std;
+
+#define ITEM_COUNT 10000
+#define ROUND_COUNT 20
+
+static long
+elapsed_us(chrono::steady_clock::time_point start)
+{
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *xpath = "/test-examples:perf/item/value";
+    size_t item_count = ITEM_COUNT;
+    uint64_t sum_old = 0, sum_new = 0;
+
+    if (argc > 1) {
+        item_count = strtoul(argv[1], nullptr, 10);
+    }
+
+    try {
+        auto conn = std::make_shared<sysrepo::Connection>();
+        auto sess = std::make_shared<sysrepo::Session>(conn);
+
+        /* create the data */
+        vector<sysrepo::Edit_Item> items;
+        for (size_t i = 0; i < item_count; ++i) {
+            items.emplace_back("/test-examples:perf/item[id='" + to_string(i) + "']/value", to_string(i));
+        }
+        sess->set_items(items);
+        sess->apply_changes();
+
+        /* get and iterate, shared_ptr-based wrappers */
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < ROUND_COUNT; ++r) {
+            auto values = sess->get_items(xpath);
+            for (size_t i = 0; values && (i < values->val_cnt()); ++i) {
+                sum_old += values->val(i)->data()->get_uint32();
+            }
+        }
+        long get_old = elapsed_us(start) / ROUND_COUNT;
+
+        /* get and iterate, move-only array */
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < ROUND_COUNT; ++r) {
+            auto values = sess->get_items_array(xpath);
+            for (sysrepo::Val_Ref val : values) {
+                sum_new += val.as<uint32_t>();
+            }
+        }
+        long get_new = elapsed_us(start) / ROUND_COUNT;
+
+        /* iterate only, shared_ptr-based wrappers */
+        auto values_old = sess->get_items(xpath);
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < ROUND_COUNT; ++r) {
+            for (size_t i = 0; values_old && (i < values_old->val_cnt()); ++i) {
+                sum_old += values_old->val(i)->data()->get_uint32();
+            }
+        }
+        long iter_old = elapsed_us(start) / ROUND_COUNT;
+
+        /* iterate only, move-only array */
+        auto values_new = sess->get_items_array(xpath);
+        start = chrono::steady_clock::now();
+        for (int r = 0; r < ROUND_COUNT; ++r) {
+            for (sysrepo::Val_Ref val : values_new) {
+                sum_new += val.as<uint32_t>();
+            }
+        }
+        long iter_new = elapsed_us(start) / ROUND_COUNT;
+
+        if (sum_old != sum_new) {
+            cout << "Results differ!" << endl;
+        }
+
+        cout << item_count << " values, average of " << ROUND_COUNT << " rounds:" << endl;
+        cout << "get + iterate   Vals: " << get_old << " us, Vals_Array: " << get_new << " us" << endl;
+        cout << "iterate         Vals: " << iter_old << " us, Vals_Array: " << iter_new << " us" << endl;
+
+        /* cleanup */
+        sess->delete_item("/test-examples:perf");
+        sess->apply_changes();
+    } catch( const std::exception& e ) {
+        cout << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file cpp_subscribe_view_example.cpp
+ * @brief Example usage of the lightweight subscriptions oper_get_items_subscribe_view() and rpc_subscribe_view(),
+ * no objects are allocated for their callback calls
+ *
+ * @copyright
+ * Copyright 2019 Deutsche Telekom AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include <libyang/Libyang.hpp>
+#include "Session.hpp"
+#include "utils/values.h"
+
+using namespace std;
+
+#define ITEM_COUNT 5
+
+int
+main(int argc, char **argv)
+{
+    const char *module_name = "test-examples";
+
+    try {
+        auto conn = std::make_shared<sysrepo::Connection>();
+        auto sess = std::make_shared<sysrepo::Session>(conn);
+        auto subscribe = std::make_shared<sysrepo::Subscribe>(sess);
+
+        /* the context is used for creating the operational data, get it only once */
+        struct ly_ctx *ly_ctx = conn->get_context()->swig_ctx();
+
+        /* operational data are created directly in the parent tree */
+        auto oper_cb = [ly_ctx] (sysrepo::Session &session, const char *module_name, const char *path,
+                const char *request_xpath, uint32_t request_id, struct lyd_node **parent) {
+            char xpath[64], value[16];
+            struct lyd_node *node;
+
+            cout << "\n ========== CALLBACK CALLED TO PROVIDE \"" << path << "\" DATA ==========\n" << endl;
+
+            for (uint32_t i = 0; i < ITEM_COUNT; ++i) {
+                snprintf(xpath, sizeof xpath, "/test-examples:perf/item[id='%u']/value", i);
+                snprintf(value, sizeof value, "%u", i * 10);
+
+                node = lyd_new_path(*parent, ly_ctx, xpath, value, LYD_ANYDATA_CONSTSTRING, 0);
+                if (!node) {
+                    return SR_ERR_LY;
+                }
+                if (!*parent) {
+                    *parent = node;
+                }
+            }
+
+            return SR_ERR_OK;
+        };
+
+        /* RPC output values are filled in the array allocated by the output view */
+        auto rpc_cb = [] (sysrepo::Session &session, const char *op_path, const sysrepo::Vals_View &input,
+                sr_event_t event, uint32_t request_id, sysrepo::Vals_Output &output) {
+            sr_val_t *vals;
+
+            cout << "\n ========== RPC \"" << op_path << "\" CALLED ==========\n" << endl;
+
+            for (const auto &val : input) {
+                sysrepo::Val_Ref ref(val);
+                if (ref.type() == SR_STRING_T) {
+                    cout << ref.xpath() << " = " << ref.as<const char *>() << endl;
+                }
+            }
+
+            vals = output.reallocate(2);
+            if (sr_val_set_xpath(&vals[0], "/test-examples:activate-software-image/status")
+                    || sr_val_set_str_data(&vals[0], SR_STRING_T, "The image acmefw-2.3 is being installed.")) {
+                return SR_ERR_NOMEM;
+            }
+            if (sr_val_set_xpath(&vals[1], "/test-examples:activate-software-image/version")
+                    || sr_val_set_str_data(&vals[1], SR_STRING_T, "2.3")) {
+                return SR_ERR_NOMEM;
+            }
+
+            return SR_ERR_OK;
+        };
+
+        cout << "\n ========== SUBSCRIBE TO OPERATIONAL DATA AND RPC ==========\n" << endl;
+        subscribe->oper_get_items_subscribe_view(module_name, oper_cb, "/test-examples:perf");
+        subscribe->rpc_subscribe_view("/test-examples:activate-software-image", rpc_cb, 0, SR_SUBSCR_CTX_REUSE);
+
+        cout << "\n ========== READ OPERATIONAL DATA ==========\n" << endl;
+        sess->session_switch_ds(SR_DS_OPERATIONAL);
+        auto values = sess->get_items_array("/test-examples:perf/item/value");
+        for (size_t i = 0; i < values.size(); ++i) {
+            cout << values[i].xpath() << " = " << values[i].as<uint32_t>() << endl;
+        }
+        sess->session_switch_ds(SR_DS_RUNNING);
+
+        cout << "\n ========== START RPC CALL ==========\n" << endl;
+        auto in_vals = std::make_shared<sysrepo::Vals>(1);
+        in_vals->val(0)->set("/test-examples:activate-software-image/image-name", "acmefw-2.3", SR_STRING_T);
+        auto out_vals = sess->rpc_send("/test-examples:activate-software-image", in_vals);
+
+        cout << "\n ========== PRINT RETURN VALUE ==========\n" << endl;
+        for (size_t n = 0; n < out_vals->val_cnt(); ++n) {
+            cout << out_vals->val(n)->to_string();
+        }
+
+        cout << "\n ========== END PROGRAM ==========\n" << endl;
+    } catch (const std::exception &e) {
+        cerr << "Error: " << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
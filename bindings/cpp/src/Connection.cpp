@@ -81,6 +81,41 @@ void Connection::install_module(const char *schema_path, const char *search_dir,
     }
 }
 
+void Connection::install_modules(std::vector<std::string> schema_paths, const char *search_dir,
+        std::vector<std::vector<std::string>> features)
+{
+    int ret;
+    std::vector<const char *> paths;
+    std::vector<std::vector<const char *>> feats;
+    std::vector<const char **> feat_arrays;
+    std::vector<int> feat_counts;
+
+    if (!features.empty() && (features.size() != schema_paths.size())) {
+        throw_exception(SR_ERR_INVAL_ARG);
+    }
+
+    for (auto &path : schema_paths) {
+        paths.push_back(path.c_str());
+    }
+
+    /* features of every module, any module without features gets an empty array */
+    feats.resize(schema_paths.size());
+    for (uint32_t i = 0; i < features.size(); ++i) {
+        for (auto &feat : features[i]) {
+            feats[i].push_back(feat.c_str());
+        }
+    }
+    for (auto &mod_feats : feats) {
+        feat_arrays.push_back(mod_feats.data());
+        feat_counts.push_back(mod_feats.size());
+    }
+
+    ret = sr_install_modules(_conn, paths.data(), paths.size(), search_dir, feat_arrays.data(), feat_counts.data());
+    if (ret != SR_ERR_OK) {
+        throw_exception(ret);
+    }
+}
+
 void Connection::install_module_data(const char *module_name, const char *data, const char *data_path, LYD_FORMAT format)
 {
     int ret;
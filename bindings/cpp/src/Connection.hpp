@@ -56,6 +56,9 @@ public:
 
     /** Wrapper for [sr_install_module](@ref sr_install_module) */
     void install_module(const char *schema_path, const char *search_dir, std::vector<std::string> features);
+    /** Wrapper for [sr_install_modules](@ref sr_install_modules) */
+    void install_modules(std::vector<std::string> schema_paths, const char *search_dir,
+            std::vector<std::vector<std::string>> features = {});
     /** Wrapper for [sr_install_module_data](@ref sr_install_module_data) */
     void install_module_data(const char *module_name, const char *data, const char *data_path, LYD_FORMAT format);
     /** Wrapper for [sr_remove_module](@ref sr_remove_module) */
@@ -0,0 +1,119 @@
+/**
+ * @file Generated.cpp
+ * @brief Implementation of the support for typed accessors generated by sysrepo-cpp-gen.
+ *
+ * @copyright
+ * Copyright 2016 - 2019 Deutsche Telekom AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+
+#include "Sysrepo.hpp"
+#include "Generated.hpp"
+
+namespace sysrepo {
+namespace gen {
+
+const struct lys_node *schema_node(const struct ly_ctx *ctx, const char *path)
+{
+    const struct lys_node *schema = ly_ctx_get_node(ctx, nullptr, path, 0);
+    if (!schema) {
+        throw_exception(SR_ERR_NOT_FOUND);
+    }
+    return schema;
+}
+
+static struct lyd_node *link_node(struct lyd_node *node, struct lyd_node **edit)
+{
+    if (!node) {
+        throw_exception(SR_ERR_LY);
+    }
+    if (edit) {
+        if (!*edit) {
+            *edit = node;
+        } else if (lyd_insert_sibling(edit, node)) {
+            lyd_free(node);
+            throw_exception(SR_ERR_LY);
+        }
+    }
+    return node;
+}
+
+struct lyd_node *new_inner(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema)
+{
+    return link_node(lyd_new(parent, lys_node_module(schema), schema->name), parent ? nullptr : edit);
+}
+
+struct lyd_node *get_inner(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema)
+{
+    const struct lyd_node *node;
+
+    node = parent ? find_child(parent, schema) : find_sibling(*edit, schema);
+    if (node) {
+        return const_cast<struct lyd_node *>(node);
+    }
+    return new_inner(parent, edit, schema);
+}
+
+struct lyd_node *new_leaf(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, const char *value)
+{
+    return link_node(lyd_new_leaf(parent, lys_node_module(schema), schema->name, value), parent ? nullptr : edit);
+}
+
+struct lyd_node *new_leaf_bool(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, bool value)
+{
+    return new_leaf(parent, edit, schema, value ? "true" : "false");
+}
+
+struct lyd_node *new_leaf_int(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, int64_t value)
+{
+    char buf[24];
+
+    snprintf(buf, sizeof buf, "%" PRId64, value);
+    return new_leaf(parent, edit, schema, buf);
+}
+
+struct lyd_node *new_leaf_uint(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, uint64_t value)
+{
+    char buf[24];
+
+    snprintf(buf, sizeof buf, "%" PRIu64, value);
+    return new_leaf(parent, edit, schema, buf);
+}
+
+struct lyd_node *new_leaf_dec64(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, double value,
+        int dig)
+{
+    char buf[32];
+
+    snprintf(buf, sizeof buf, "%.*f", dig, value);
+    return new_leaf(parent, edit, schema, buf);
+}
+
+libyang::S_Data_Node Edit_Tree::release()
+{
+    struct lyd_node *tree = _tree;
+
+    if (!tree) {
+        return nullptr;
+    }
+    _tree = nullptr;
+    return std::make_shared<libyang::Data_Node>(tree, std::make_shared<libyang::Deleter>(tree));
+}
+
+}
+}
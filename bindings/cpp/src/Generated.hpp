@@ -0,0 +1,183 @@
+/**
+ * @file Generated.hpp
+ * @brief Support for typed accessors generated by sysrepo-cpp-gen.
+ *
+ * @copyright
+ * Copyright 2016 - 2019 Deutsche Telekom AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GENERATED_H
+#define GENERATED_H
+
+#include <cstdint>
+#include <iterator>
+
+#include <libyang/libyang.h>
+#include <libyang/Tree_Data.hpp>
+
+#include "Sysrepo.hpp"
+
+namespace sysrepo {
+
+/**
+ * @defgroup gen Generated accessors support
+ * @{
+ *
+ * Classes generated by sysrepo-cpp-gen resolve all their schema nodes once and then only compare
+ * schema node pointers while walking data trees, no xpath is ever built or parsed.
+ *
+ * Names are derived from the node names, a name that would collide with another generated one
+ * gets a numeric suffix, for example leaf "has-x" next to leaf "x" is read by has_x_2().
+ * See examples/cpp_gen_example.cpp for a complete example.
+ *
+ * @code
+ * // sysrepo-cpp-gen test-examples (or a path to test-examples.yang)
+ * #include "test-examples.hpp"
+ *
+ * test_examples::Schema schema(sess->get_context()->swig_ctx());
+ * auto tree = sess->get_data(test_examples::paths::perf);
+ * for (auto item : test_examples::Data(schema, tree).perf().item()) {
+ *     uint32_t value = item.value();
+ * }
+ *
+ * test_examples::Edit edit(schema);
+ * edit.perf().add_item(1).set_value(10);
+ * sess->edit_batch(edit.release(), "merge");
+ * @endcode
+ */
+
+namespace gen {
+
+/** Resolves schema node of a data path, throws if it does not exist in the context.*/
+const struct lys_node *schema_node(const struct ly_ctx *ctx, const char *path);
+
+/** Returns the first sibling of a data node.*/
+inline const struct lyd_node *first_sibling(const struct lyd_node *node)
+{
+    if (node) {
+        while (node->prev->next) {
+            node = node->prev;
+        }
+    }
+    return node;
+}
+
+/** Returns the first instance of a schema node among the siblings starting with first.*/
+inline const struct lyd_node *find_sibling(const struct lyd_node *first, const struct lys_node *schema)
+{
+    for (; first; first = first->next) {
+        if (first->schema == schema) {
+            return first;
+        }
+    }
+    return nullptr;
+}
+
+/** Returns the first instance of a schema node among the children of parent.*/
+inline const struct lyd_node *find_child(const struct lyd_node *parent, const struct lys_node *schema)
+{
+    return parent ? find_sibling(parent->child, schema) : nullptr;
+}
+
+/** Returns the next instance of a list or a leaf-list.*/
+inline const struct lyd_node *next_instance(const struct lyd_node *node)
+{
+    return find_sibling(node->next, node->schema);
+}
+
+/** Returns the leaf value of a data node, throws if the node does not exist.*/
+inline const struct lyd_node_leaf_list *leaf(const struct lyd_node *node)
+{
+    if (!node) {
+        throw_exception(SR_ERR_NOT_FOUND);
+    }
+    return reinterpret_cast<const struct lyd_node_leaf_list *>(node);
+}
+
+/** Creates a new inner node, in an edit or under parent if set.*/
+struct lyd_node *new_inner(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema);
+/** Returns an existing inner node or creates a new one, in an edit or under parent if set.*/
+struct lyd_node *get_inner(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema);
+/** Creates a new leaf or leaf-list instance, in an edit or under parent if set.*/
+struct lyd_node *new_leaf(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, const char *value);
+/** Creates a new boolean leaf or leaf-list instance.*/
+struct lyd_node *new_leaf_bool(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, bool value);
+/** Creates a new signed integer leaf or leaf-list instance.*/
+struct lyd_node *new_leaf_int(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, int64_t value);
+/** Creates a new unsigned integer leaf or leaf-list instance.*/
+struct lyd_node *new_leaf_uint(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, uint64_t value);
+/** Creates a new decimal64 leaf or leaf-list instance with the given fraction digits.*/
+struct lyd_node *new_leaf_dec64(struct lyd_node *parent, struct lyd_node **edit, const struct lys_node *schema, double value,
+        int dig);
+
+/**
+ * @brief Range of all the instances of a list or a leaf-list, iterating does not allocate anything.
+ * @class Instances
+ */
+template <class T, class S>
+class Instances
+{
+public:
+    class iterator : public std::iterator<std::forward_iterator_tag, T>
+    {
+    public:
+        iterator(const S *schema, const struct lyd_node *node) : _schema(schema), _node(node) {};
+        T operator*() const {return T(*_schema, _node);};
+        iterator &operator++() {_node = next_instance(_node); return *this;};
+        bool operator==(const iterator &other) const {return _node == other._node;};
+        bool operator!=(const iterator &other) const {return _node != other._node;};
+
+    private:
+        const S *_schema;
+        const struct lyd_node *_node;
+    };
+
+    /** Constructor from the first instance, internal use only.*/
+    Instances(const S &schema, const struct lyd_node *first) : _schema(&schema), _first(first) {};
+    /** Whether there are no instances.*/
+    bool empty() const {return !_first;};
+    iterator begin() const {return iterator(_schema, _first);};
+    iterator end() const {return iterator(_schema, nullptr);};
+
+private:
+    const S *_schema;
+    const struct lyd_node *_first;
+};
+
+/**
+ * @brief Owner of an edit tree built by generated edit classes.
+ * @class Edit_Tree
+ */
+class Edit_Tree
+{
+public:
+    Edit_Tree() : _tree(nullptr) {};
+    Edit_Tree(const Edit_Tree &) = delete;
+    Edit_Tree &operator=(const Edit_Tree &) = delete;
+    ~Edit_Tree() {lyd_free_withsiblings(_tree);};
+    /** Whether nothing was created yet.*/
+    bool empty() const {return !_tree;};
+    /** Hands the edit over to be used with [edit_batch](@ref Session::edit_batch), the tree is empty afterwards.*/
+    libyang::S_Data_Node release();
+
+protected:
+    struct lyd_node *_tree;
+};
+
+}
+
+/**@} */
+}
+#endif
@@ -21,7 +21,9 @@
  */
 
 #include <cassert>
+#include <fcntl.h>
 #include <iostream>
+#include <unistd.h>
 
 #include "Sysrepo.hpp"
 #include "Internal.hpp"
@@ -82,4 +84,127 @@ void Deleter::update_vals_with_count(sr_val_t *val, size_t cnt)
     c._cnt = cnt;
 }
 
+/* maximum number of threads executing asynchronous operations of all the sessions */
+#define ASYNC_POOL_MAX_THREADS 8
+
+/* queue whose task is being executed by this thread */
+static thread_local Async_Queue *async_current = nullptr;
+
+Async_Queue::Async_Queue() : _scheduled(false) {
+    if (pipe(_pipe) == -1) {
+        throw_exception(SR_ERR_SYS);
+    }
+    /* completions are only signalled, never block on a full pipe */
+    fcntl(_pipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(_pipe[1], F_SETFL, O_NONBLOCK);
+}
+Async_Queue::~Async_Queue() {
+    close(_pipe[0]);
+    close(_pipe[1]);
+}
+void Async_Queue::submit(std::function<void()> task) {
+    bool schedule;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _tasks.push_back(std::move(task));
+        schedule = !_scheduled;
+        _scheduled = true;
+    }
+    if (schedule) {
+        Async_Pool::get().schedule(shared_from_this());
+    }
+}
+void Async_Queue::wait() {
+    if (async_current == this) {
+        /* a task itself */
+        return;
+    }
+
+    std::unique_lock<std::mutex> guard(_lock);
+    _idle.wait(guard, [this] {return !_scheduled;});
+}
+bool Async_Queue::run_next() {
+    std::function<void()> task;
+    char c = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        task = std::move(_tasks.front());
+        _tasks.pop_front();
+    }
+
+    async_current = this;
+    task();
+    async_current = nullptr;
+
+    /* signal the completion */
+    if (write(_pipe[1], &c, 1) == -1) {
+        /* pipe full, the reader is already notified */
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (!_tasks.empty()) {
+            return true;
+        }
+        _scheduled = false;
+    }
+    _idle.notify_all();
+    return false;
+}
+
+Async_Pool &Async_Pool::get() {
+    static Async_Pool pool;
+    return pool;
+}
+Async_Pool::Async_Pool() : _stop(false) {
+    unsigned count = std::thread::hardware_concurrency();
+
+    if (count < 2) {
+        count = 2;
+    } else if (count > ASYNC_POOL_MAX_THREADS) {
+        count = ASYNC_POOL_MAX_THREADS;
+    }
+    for (unsigned i = 0; i < count; ++i) {
+        _threads.emplace_back(&Async_Pool::run, this);
+    }
+}
+Async_Pool::~Async_Pool() {
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _stop = true;
+    }
+    _cond.notify_all();
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+}
+void Async_Pool::schedule(std::shared_ptr<Async_Queue> queue) {
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _ready.push_back(std::move(queue));
+    }
+    _cond.notify_one();
+}
+void Async_Pool::run() {
+    while (1) {
+        std::shared_ptr<Async_Queue> queue;
+        {
+            std::unique_lock<std::mutex> guard(_lock);
+            _cond.wait(guard, [this] {return _stop || !_ready.empty();});
+            if (_ready.empty()) {
+                /* stopped and all the tasks finished */
+                return;
+            }
+            queue = std::move(_ready.front());
+            _ready.pop_front();
+        }
+
+        /* one task at a time so that other sessions are not starved */
+        if (queue->run_next()) {
+            schedule(std::move(queue));
+        }
+    }
+}
+
 }
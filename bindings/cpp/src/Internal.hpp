@@ -23,8 +23,14 @@
 #ifndef INTERNAL_H
 #define INTERNAL_H
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "sysrepo.h"
 
@@ -65,5 +71,50 @@ private:
     Free_Type _t;
 };
 
+/* Asynchronous operations of a session, executed in order by the shared Async_Pool */
+class Async_Queue : public std::enable_shared_from_this<Async_Queue>
+{
+public:
+    Async_Queue();
+    ~Async_Queue();
+
+    void submit(std::function<void()> task);
+    /* waits until all the submitted tasks are finished, returns immediately in a task of this queue */
+    void wait();
+    int event_pipe() {return _pipe[0];};
+
+private:
+    friend class Async_Pool;
+    /* executes the first task, returns whether there are more */
+    bool run_next();
+
+    std::deque<std::function<void()>> _tasks;
+    std::mutex _lock;
+    std::condition_variable _idle;
+    bool _scheduled;
+    int _pipe[2];
+};
+
+/* Bounded set of threads shared by all the sessions, runs at most one task of a session at a time */
+class Async_Pool
+{
+public:
+    static Async_Pool &get();
+    /* waits for all the scheduled tasks */
+    ~Async_Pool();
+
+    void schedule(std::shared_ptr<Async_Queue> queue);
+
+private:
+    Async_Pool();
+    void run();
+
+    std::deque<std::shared_ptr<Async_Queue>> _ready;
+    std::mutex _lock;
+    std::condition_variable _cond;
+    bool _stop;
+    std::vector<std::thread> _threads;
+};
+
 }
 #endif
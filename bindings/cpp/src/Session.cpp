@@ -177,6 +177,18 @@ S_Vals Session::get_items(const char *xpath, uint32_t timeout_ms, const sr_get_o
     throw_exception(ret);
 }
 
+Vals_Array Session::get_items_array(const char *xpath, uint32_t timeout_ms, const sr_get_oper_options_t opts)
+{
+    sr_val_t *vals = nullptr;
+    size_t cnt = 0;
+
+    int ret = sr_get_items(_sess, xpath, timeout_ms, opts, &vals, &cnt);
+    if (SR_ERR_OK != ret) {
+        throw_exception(ret);
+    }
+    return Vals_Array(vals, cnt);
+}
+
 libyang::S_Data_Node Session::get_subtree(const char *path, uint32_t timeout_ms)
 {
     struct lyd_node *subtree;
@@ -205,6 +217,34 @@ libyang::S_Data_Node Session::get_data(const char *xpath, uint32_t max_depth, ui
     throw_exception(ret);
 }
 
+S_Borrowed_Data Session::get_data_borrowed(const char *xpath, uint32_t timeout_ms, const sr_get_oper_options_t opts)
+{
+    sr_borrowed_data_t *data;
+    const struct ly_set *nodes;
+
+    int ret = sr_get_data_borrowed(_sess, xpath, timeout_ms, opts, &data, &nodes);
+    if (SR_ERR_OK == ret) {
+        return std::make_shared<Borrowed_Data>(data, nodes);
+    }
+    throw_exception(ret);
+}
+
+S_Iter_Value Session::get_items_iter(const char *xpath, uint32_t timeout_ms, const sr_get_oper_options_t opts)
+{
+    auto iter = std::make_shared<Iter_Value>(nullptr, _sess);
+
+    int ret = sr_get_items_iter(_sess, xpath, timeout_ms, opts, &iter->_iter);
+    if (SR_ERR_OK == ret) {
+        return iter;
+    }
+    throw_exception(ret);
+}
+
+S_Val Session::get_item_next(S_Iter_Value iter)
+{
+    return iter->next();
+}
+
 void Session::set_item(const char *path, S_Val value, const sr_edit_options_t opts)
 {
     sr_val_t *val = value ? value->_val : nullptr;
@@ -223,6 +263,22 @@ void Session::set_item_str(const char *path, const char *value, const char *orig
     }
 }
 
+void Session::set_items(const std::vector<Edit_Item> &items, const char *origin, \
+        const sr_edit_options_t opts)
+{
+    std::vector<sr_edit_item_t> edit_items;
+
+    edit_items.reserve(items.size());
+    for (auto &item : items) {
+        edit_items.push_back({item.xpath.c_str(), item.has_value ? item.value.c_str() : nullptr, origin, opts});
+    }
+
+    int ret = sr_set_items(_sess, edit_items.data(), edit_items.size());
+    if (ret != SR_ERR_OK) {
+        throw_exception(ret);
+    }
+}
+
 void Session::delete_item(const char *path, const sr_edit_options_t opts)
 {
     int ret = sr_delete_item(_sess, path, opts);
@@ -370,7 +426,13 @@ S_Tree_Change Session::get_change_tree_next(S_Iter_Change iter)
     throw_exception(ret);
 }
 
-Session::~Session() {}
+Session::~Session()
+{
+    /* wait for the asynchronous operations */
+    if (_async) {
+        _async->wait();
+    }
+}
 
 S_Vals Session::rpc_send(const char *path, S_Vals input, uint32_t timeout_ms)
 {
@@ -403,6 +465,64 @@ libyang::S_Data_Node Session::rpc_send(libyang::S_Data_Node input, uint32_t time
     return std::make_shared<libyang::Data_Node>(output, std::make_shared<libyang::Deleter>(output));
 }
 
+Async_Queue *Session::async_queue()
+{
+    std::call_once(_async_once, [this] {_async = std::make_shared<Async_Queue>();});
+    return _async.get();
+}
+
+int Session::async_event_pipe()
+{
+    return async_queue()->event_pipe();
+}
+
+std::future<S_Vals> Session::async_rpc_send(const char *path, S_Vals input, uint32_t timeout_ms)
+{
+    std::string path_str(path);
+    auto task = std::make_shared<std::packaged_task<S_Vals()>>(
+            [this, path_str, input, timeout_ms] {
+                return rpc_send(path_str.c_str(), input, timeout_ms);
+            });
+
+    async_queue()->submit([task] {(*task)();});
+    return task->get_future();
+}
+
+std::future<libyang::S_Data_Node> Session::async_rpc_send(libyang::S_Data_Node input, uint32_t timeout_ms)
+{
+    auto task = std::make_shared<std::packaged_task<libyang::S_Data_Node()>>(
+            [this, input, timeout_ms] {
+                return rpc_send(input, timeout_ms);
+            });
+
+    async_queue()->submit([task] {(*task)();});
+    return task->get_future();
+}
+
+std::future<void> Session::async_apply_changes(uint32_t timeout_ms, int wait)
+{
+    auto task = std::make_shared<std::packaged_task<void()>>(
+            [this, timeout_ms, wait] {
+                apply_changes(timeout_ms, wait);
+            });
+
+    async_queue()->submit([task] {(*task)();});
+    return task->get_future();
+}
+
+std::future<libyang::S_Data_Node> Session::async_get_data(const char *xpath, uint32_t max_depth, uint32_t timeout_ms, \
+        const sr_get_oper_options_t opts)
+{
+    std::string xpath_str(xpath);
+    auto task = std::make_shared<std::packaged_task<libyang::S_Data_Node()>>(
+            [this, xpath_str, max_depth, timeout_ms, opts] {
+                return get_data(xpath_str.c_str(), max_depth, timeout_ms, opts);
+            });
+
+    async_queue()->submit([task] {(*task)();});
+    return task->get_future();
+}
+
 void Session::event_notif_send(const char *path, S_Vals values)
 {
     int ret = sr_event_notif_send(_sess, path, values->_vals, values->val_cnt());
@@ -686,6 +806,199 @@ void Subscribe::oper_get_items_subscribe(const char *module_name, OperGetItemsCb
     call_reg();
 }
 
+void Subscribe::module_change_subscribe_view(const char *module_name, ModuleChangeViewCb cb, const char *xpath, uint32_t priority, sr_subscr_options_t opts)
+{
+    check_custom_loop_options(opts);
+    module_change_view_cbs.emplace_back(cb);
+
+    opts |= SR_SUBSCR_CTX_REUSE;
+    int ret = sr_module_change_subscribe(
+            sess->_sess,
+            module_name,
+            xpath,
+            [] (sr_session_ctx_t *session,
+                const char *module_name,
+                const char *xpath,
+                sr_event_e event,
+                uint32_t request_id,
+                void *private_data)
+            {
+                auto view_cb = reinterpret_cast<View_Cb<ModuleChangeViewCb>*>(private_data);
+                view_cb->sess._sess = session;
+                return view_cb->cb(view_cb->sess, module_name, xpath, event, request_id);
+            },
+            (void*)&(module_change_view_cbs.back()),
+            priority,
+            opts,
+            &ctx);
+    if (ret != SR_ERR_OK) {
+        throw_exception(ret);
+    }
+    call_reg();
+}
+
+void Subscribe::rpc_subscribe_view(const char *xpath, RpcViewCb cb, uint32_t priority, sr_subscr_options_t opts)
+{
+    check_custom_loop_options(opts);
+    rpc_view_cbs.emplace_back(cb);
+
+    opts |= SR_SUBSCR_CTX_REUSE;
+    int ret = sr_rpc_subscribe(
+            sess->_sess,
+            xpath,
+            [] (sr_session_ctx_t *session,
+                const char *op_path,
+                const sr_val_t *input,
+                const size_t input_cnt,
+                sr_event_t event,
+                uint32_t request_id,
+                sr_val_t **output,
+                size_t *output_cnt,
+                void *private_data)
+            {
+                auto view_cb = reinterpret_cast<View_Cb<RpcViewCb>*>(private_data);
+                Vals_View in_vals(input, input_cnt);
+                Vals_Output out_vals(output, output_cnt);
+                view_cb->sess._sess = session;
+                return view_cb->cb(view_cb->sess, op_path, in_vals, event, request_id, out_vals);
+            },
+            (void*)&(rpc_view_cbs.back()),
+            priority,
+            opts,
+            &ctx);
+    if (ret != SR_ERR_OK) {
+        throw_exception(ret);
+    }
+    call_reg();
+}
+
+void Subscribe::rpc_subscribe_tree_view(const char *xpath, RpcTreeViewCb cb, uint32_t priority, sr_subscr_options_t opts)
+{
+    check_custom_loop_options(opts);
+    rpc_tree_view_cbs.emplace_back(cb);
+
+    opts |= SR_SUBSCR_CTX_REUSE;
+    int ret = sr_rpc_subscribe_tree(
+            sess->_sess,
+            xpath,
+            [] (sr_session_ctx_t *session,
+                const char *op_path,
+                const struct lyd_node *input,
+                sr_event_t event,
+                uint32_t request_id,
+                struct lyd_node *output,
+                void *private_data)
+            {
+                auto view_cb = reinterpret_cast<View_Cb<RpcTreeViewCb>*>(private_data);
+                view_cb->sess._sess = session;
+                return view_cb->cb(view_cb->sess, op_path, input, event, request_id, output);
+            },
+            (void*)&(rpc_tree_view_cbs.back()),
+            priority,
+            opts,
+            &ctx);
+    if (ret != SR_ERR_OK) {
+        throw_exception(ret);
+    }
+    call_reg();
+}
+
+void Subscribe::event_notif_subscribe_view(const char *module_name, EventNotifViewCb cb, const char *xpath, time_t start_time, time_t stop_time, sr_subscr_options_t opts)
+{
+    check_custom_loop_options(opts);
+    event_notif_view_cbs.emplace_back(cb);
+
+    opts |= SR_SUBSCR_CTX_REUSE;
+    int ret = sr_event_notif_subscribe(
+            sess->_sess,
+            module_name,
+            xpath,
+            start_time,
+            stop_time,
+            [] (sr_session_ctx_t *session,
+                const sr_ev_notif_type_t notif_type,
+                const char *path,
+                const sr_val_t *values,
+                const size_t values_cnt,
+                time_t timestamp,
+                void *private_data)
+            {
+                auto view_cb = reinterpret_cast<View_Cb<EventNotifViewCb>*>(private_data);
+                Vals_View vals(values, values_cnt);
+                view_cb->sess._sess = session;
+                view_cb->cb(view_cb->sess, notif_type, path, vals, timestamp);
+            },
+            (void*)&(event_notif_view_cbs.back()),
+            opts,
+            &ctx);
+    if (ret != SR_ERR_OK) {
+        throw_exception(ret);
+    }
+    call_reg();
+}
+
+void Subscribe::event_notif_subscribe_tree_view(const char *module_name, EventNotifTreeViewCb cb, const char *xpath, time_t start_time, time_t stop_time, sr_subscr_options_t opts)
+{
+    check_custom_loop_options(opts);
+    event_notif_tree_view_cbs.emplace_back(cb);
+
+    opts |= SR_SUBSCR_CTX_REUSE;
+    int ret = sr_event_notif_subscribe_tree(
+            sess->_sess,
+            module_name,
+            xpath,
+            start_time,
+            stop_time,
+            [] (sr_session_ctx_t *session,
+                const sr_ev_notif_type_t notif_type,
+                const struct lyd_node *notif,
+                time_t timestamp,
+                void *private_data)
+            {
+                auto view_cb = reinterpret_cast<View_Cb<EventNotifTreeViewCb>*>(private_data);
+                view_cb->sess._sess = session;
+                view_cb->cb(view_cb->sess, notif_type, notif, timestamp);
+            },
+            (void*)&(event_notif_tree_view_cbs.back()),
+            opts,
+            &ctx);
+    if (ret != SR_ERR_OK) {
+        throw_exception(ret);
+    }
+    call_reg();
+}
+
+void Subscribe::oper_get_items_subscribe_view(const char *module_name, OperGetItemsViewCb cb, const char *path, sr_subscr_options_t opts)
+{
+    check_custom_loop_options(opts);
+    oper_get_items_view_cbs.emplace_back(cb);
+
+    opts |= SR_SUBSCR_CTX_REUSE;
+    int ret = sr_oper_get_items_subscribe(
+            sess->_sess,
+            module_name,
+            path,
+            [] (sr_session_ctx_t *session,
+                const char *module_name,
+                const char *path,
+                const char *request_xpath,
+                uint32_t request_id,
+                struct lyd_node **parent,
+                void *private_data)
+            {
+                auto view_cb = reinterpret_cast<View_Cb<OperGetItemsViewCb>*>(private_data);
+                view_cb->sess._sess = session;
+                return view_cb->cb(view_cb->sess, module_name, path, request_xpath, request_id, parent);
+            },
+            (void*)&(oper_get_items_view_cbs.back()),
+            opts,
+            &ctx);
+    if (ret != SR_ERR_OK) {
+        throw_exception(ret);
+    }
+    call_reg();
+}
+
 int Subscribe::get_event_pipe()
 {
     int ret, ev_pipe;
@@ -23,10 +23,13 @@
 #ifndef SESSION_H
 #define SESSION_H
 
+#include <future>
 #include <iostream>
 #include <list>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include <libyang/Tree_Data.hpp>
@@ -45,8 +48,29 @@ namespace sysrepo {
  * @{
  */
 
+/**
+ * @brief Single change of [set_items](@ref Session::set_items), a path with an optional value.
+ * @class Edit_Item
+ */
+class Edit_Item
+{
+public:
+    /** Item without a value (list instance, presence container).*/
+    Edit_Item(std::string xpath) : xpath(std::move(xpath)), has_value(false) {};
+    /** Item with a value, which can also be empty.*/
+    Edit_Item(std::string xpath, std::string value) : xpath(std::move(xpath)), value(std::move(value)), has_value(true) {};
+
+    std::string xpath;
+    std::string value;
+    bool has_value;
+};
+
 /**
  * @brief Class for wrapping sr_session_ctx_t.
+ *
+ * Asynchronous operations of all the sessions are executed by a bounded pool of shared threads, those of
+ * one session one by one in order, so use more sessions to run them in parallel. No synchronous operation
+ * may be called on a session while it has some asynchronous operations pending, wait for them first.
  * @class Session
  */
 class Session
@@ -86,17 +110,29 @@ public:
     S_Val get_item(const char *path, uint32_t timeout_ms = 0);
     /** Wrapper for [sr_get_items](@ref sr_get_items) */
     S_Vals get_items(const char *xpath, uint32_t timeout_ms = 0, const sr_get_oper_options_t opts = OPER_DEFAULT);
+    /** Wrapper for [sr_get_items](@ref sr_get_items) returning a move-only array, no object is allocated per value */
+    Vals_Array get_items_array(const char *xpath, uint32_t timeout_ms = 0, const sr_get_oper_options_t opts = OPER_DEFAULT);
     /** Wrapper for [sr_get_subtree](@ref sr_get_subtree) */
     libyang::S_Data_Node get_subtree(const char *path, uint32_t timeout_ms = 0);
     /** Wrapper for [sr_get_data](@ref sr_get_data) */
     libyang::S_Data_Node get_data(const char *xpath, uint32_t max_depth = 0, uint32_t timeout_ms = 0, \
             const sr_get_oper_options_t opts = OPER_DEFAULT);
+    /** Wrapper for [sr_get_data_borrowed](@ref sr_get_data_borrowed), the data are released with the returned object */
+    S_Borrowed_Data get_data_borrowed(const char *xpath, uint32_t timeout_ms = 0, \
+            const sr_get_oper_options_t opts = OPER_DEFAULT);
+    /** Wrapper for [sr_get_items_iter](@ref sr_get_items_iter) */
+    S_Iter_Value get_items_iter(const char *xpath, uint32_t timeout_ms = 0, const sr_get_oper_options_t opts = OPER_DEFAULT);
+    /** Wrapper for [sr_get_item_next](@ref sr_get_item_next), the value is valid only until the next call */
+    S_Val get_item_next(S_Iter_Value iter);
 
     /** Wrapper for [sr_set_item](@ref sr_set_item) */
     void set_item(const char *path, S_Val value = nullptr, const sr_edit_options_t opts = EDIT_DEFAULT);
     /** Wrapper for [sr_set_item_str](@ref sr_set_item_str) */
     void set_item_str(const char *path, const char *value, const char *origin = nullptr, \
             const sr_edit_options_t opts = EDIT_DEFAULT);
+    /** Wrapper for [sr_set_items](@ref sr_set_items), all the items share @p origin and @p opts */
+    void set_items(const std::vector<Edit_Item> &items, const char *origin = nullptr, \
+            const sr_edit_options_t opts = EDIT_DEFAULT);
     /** Wrapper for [sr_delete_item](@ref sr_delete_item) */
     void delete_item(const char *path, const sr_edit_options_t opts = EDIT_DEFAULT);
     /** Wrapper for [sr_move_item](@ref sr_move_item) */
@@ -136,17 +172,37 @@ public:
     /** Wrapper for [sr_rpc_send_tree](@ref sr_rpc_send_tree) */
     libyang::S_Data_Node rpc_send(libyang::S_Data_Node input, uint32_t timeout_ms = 0);
 
+    /** Asynchronous [sr_rpc_send](@ref sr_rpc_send), see async_event_pipe */
+    std::future<S_Vals> async_rpc_send(const char *path, S_Vals input, uint32_t timeout_ms = 0);
+    /** Asynchronous [sr_rpc_send_tree](@ref sr_rpc_send_tree), see async_event_pipe */
+    std::future<libyang::S_Data_Node> async_rpc_send(libyang::S_Data_Node input, uint32_t timeout_ms = 0);
+    /** Asynchronous [sr_apply_changes](@ref sr_apply_changes), see async_event_pipe */
+    std::future<void> async_apply_changes(uint32_t timeout_ms = 0, int wait = 0);
+    /** Asynchronous [sr_get_data](@ref sr_get_data), see async_event_pipe */
+    std::future<libyang::S_Data_Node> async_get_data(const char *xpath, uint32_t max_depth = 0, uint32_t timeout_ms = 0, \
+            const sr_get_oper_options_t opts = OPER_DEFAULT);
+    /** Get a file descriptor that becomes readable (one byte) whenever an asynchronous operation of this session
+     * is finished. The operations are executed in order by the shared threads.*/
+    int async_event_pipe();
+
     /** Wrapper for [sr_event_notif_send](@ref sr_event_notif_send) */
     void event_notif_send(const char *path, S_Vals values);
     /** Wrapper for [sr_event_notif_send_tree](@ref sr_event_notif_send_tree) */
     void event_notif_send(libyang::S_Data_Node notif);
 
+    /** SWIG specific, internal use only.*/
+    sr_session_ctx_t *swig_sess() {return _sess;};
+
     friend class Subscribe;
 
 private:
     sr_session_ctx_t *_sess;
     S_Connection _conn;
     S_Deleter _deleter;
+    std::shared_ptr<Async_Queue> _async;
+    std::once_flag _async_once;
+
+    Async_Queue *async_queue();
 };
 
 using FdRegistration = std::function<void(int, std::function<void()>)>;
@@ -158,6 +214,15 @@ using EventNotifCb = std::function<void(S_Session session, const sr_ev_notif_typ
 using EventNotifTreeCb = std::function<void(S_Session session, const sr_ev_notif_type_t notif_type, const libyang::S_Data_Node notif, time_t timestamp)>;
 using OperGetItemsCb = std::function<int(S_Session session, const char *module_name, const char *path, const char *request_xpath, uint32_t request_id, libyang::S_Data_Node &parent)>;
 
+/* Lightweight callbacks, all the parameters are non-owning and valid only during the callback. The session object
+ * is reused for all the calls of one subscription. */
+using ModuleChangeViewCb = std::function<int(Session &session, const char *module_name, const char *xpath, sr_event_t event, uint32_t request_id)>;
+using RpcViewCb = std::function<int(Session &session, const char *op_path, const Vals_View &input, sr_event_t event, uint32_t request_id, Vals_Output &output)>;
+using RpcTreeViewCb = std::function<int(Session &session, const char *op_path, const struct lyd_node *input, sr_event_t event, uint32_t request_id, struct lyd_node *output)>;
+using EventNotifViewCb = std::function<void(Session &session, const sr_ev_notif_type_t notif_type, const char *path, const Vals_View &vals, time_t timestamp)>;
+using EventNotifTreeViewCb = std::function<void(Session &session, const sr_ev_notif_type_t notif_type, const struct lyd_node *notif, time_t timestamp)>;
+using OperGetItemsViewCb = std::function<int(Session &session, const char *module_name, const char *path, const char *request_xpath, uint32_t request_id, struct lyd_node **parent)>;
+
 /**
  * @brief Class for wrapping sr_subscription_ctx_t.
  * @class Subscribe
@@ -182,6 +247,20 @@ public:
     /** Wrapper for [sr_oper_get_items_subscribe](@ref sr_oper_get_items_subscribe) */
     void oper_get_items_subscribe(const char *module_name, OperGetItemsCb cb, const char *path, sr_subscr_options_t opts = SUBSCR_DEFAULT);
 
+    /** Lightweight [sr_module_change_subscribe](@ref sr_module_change_subscribe) wrapper, no objects are allocated for the calls */
+    void module_change_subscribe_view(const char *module_name, ModuleChangeViewCb cb, const char *xpath = nullptr, uint32_t priority = 0, sr_subscr_options_t opts = SUBSCR_DEFAULT);
+    /** Lightweight [sr_rpc_subscribe](@ref sr_rpc_subscribe) wrapper, no objects are allocated for the calls */
+    void rpc_subscribe_view(const char *xpath, RpcViewCb cb, uint32_t priority = 0, sr_subscr_options_t opts = SUBSCR_DEFAULT);
+    /** Lightweight [sr_rpc_subscribe_tree](@ref sr_rpc_subscribe_tree) wrapper, no objects are allocated for the calls */
+    void rpc_subscribe_tree_view(const char *xpath, RpcTreeViewCb cb, uint32_t priority = 0, sr_subscr_options_t opts = SUBSCR_DEFAULT);
+    /** Lightweight [sr_event_notif_subscribe](@ref sr_event_notif_subscribe) wrapper, no objects are allocated for the calls */
+    void event_notif_subscribe_view(const char *module_name, EventNotifViewCb cb, const char *xpath = nullptr, time_t start_time = 0, time_t stop_time = 0, sr_subscr_options_t opts = SUBSCR_DEFAULT);
+    /** Lightweight [sr_event_notif_subscribe_tree](@ref sr_event_notif_subscribe_tree) wrapper, no objects are allocated for the calls */
+    void event_notif_subscribe_tree_view(const char *module_name, EventNotifTreeViewCb cb, const char *xpath = nullptr, time_t start_time = 0, time_t stop_time = 0, sr_subscr_options_t opts = SUBSCR_DEFAULT);
+    /** Lightweight [sr_oper_get_items_subscribe](@ref sr_oper_get_items_subscribe) wrapper, no objects are allocated for the calls
+     * and the data are created directly in @p parent */
+    void oper_get_items_subscribe_view(const char *module_name, OperGetItemsViewCb cb, const char *path, sr_subscr_options_t opts = SUBSCR_DEFAULT);
+
     /** Wrapper for [sr_process_event](@ref sr_process_events) */
     time_t process_events(S_Session sess = nullptr);
     ~Subscribe();
@@ -204,6 +283,20 @@ private:
     std::list<EventNotifTreeCb> event_notif_tree_cbs;
     std::list<OperGetItemsCb> oper_get_items_cbs;
 
+    /* lightweight callback with its session object reused for every call */
+    template <class Cb>
+    struct View_Cb {
+        View_Cb(Cb cb) : cb(cb), sess((sr_session_ctx_t *)nullptr) {}
+        Cb cb;
+        Session sess;
+    };
+    std::list<View_Cb<ModuleChangeViewCb>> module_change_view_cbs;
+    std::list<View_Cb<RpcViewCb>> rpc_view_cbs;
+    std::list<View_Cb<RpcTreeViewCb>> rpc_tree_view_cbs;
+    std::list<View_Cb<EventNotifViewCb>> event_notif_view_cbs;
+    std::list<View_Cb<EventNotifTreeViewCb>> event_notif_tree_view_cbs;
+    std::list<View_Cb<OperGetItemsViewCb>> oper_get_items_view_cbs;
+
 
     S_Session sess;
     S_Deleter sess_deleter;
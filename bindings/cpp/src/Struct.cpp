@@ -505,15 +505,143 @@ S_Vals Vals_Holder::reallocate(size_t n) {
 }
 Vals_Holder::~Vals_Holder() {}
 
+// Val_Ref
+template <> bool Val_Ref::as<bool>() const {
+    if (_val->type != SR_BOOL_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.bool_val;
+}
+template <> double Val_Ref::as<double>() const {
+    if (_val->type != SR_DECIMAL64_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.decimal64_val;
+}
+template <> int8_t Val_Ref::as<int8_t>() const {
+    if (_val->type != SR_INT8_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.int8_val;
+}
+template <> int16_t Val_Ref::as<int16_t>() const {
+    if (_val->type != SR_INT16_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.int16_val;
+}
+template <> int32_t Val_Ref::as<int32_t>() const {
+    if (_val->type != SR_INT32_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.int32_val;
+}
+template <> int64_t Val_Ref::as<int64_t>() const {
+    if (_val->type != SR_INT64_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.int64_val;
+}
+template <> uint8_t Val_Ref::as<uint8_t>() const {
+    if (_val->type != SR_UINT8_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.uint8_val;
+}
+template <> uint16_t Val_Ref::as<uint16_t>() const {
+    if (_val->type != SR_UINT16_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.uint16_val;
+}
+template <> uint32_t Val_Ref::as<uint32_t>() const {
+    if (_val->type != SR_UINT32_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.uint32_val;
+}
+template <> uint64_t Val_Ref::as<uint64_t>() const {
+    if (_val->type != SR_UINT64_T) throw_exception(SR_ERR_UNSUPPORTED);
+    return _val->data.uint64_val;
+}
+template <> const char *Val_Ref::as<const char *>() const {
+    switch (_val->type) {
+    case SR_BINARY_T:
+        return _val->data.binary_val;
+    case SR_BITS_T:
+        return _val->data.bits_val;
+    case SR_ENUM_T:
+        return _val->data.enum_val;
+    case SR_IDENTITYREF_T:
+        return _val->data.identityref_val;
+    case SR_INSTANCEID_T:
+        return _val->data.instanceid_val;
+    case SR_STRING_T:
+        return _val->data.string_val;
+    case SR_ANYXML_T:
+        return _val->data.anyxml_val;
+    case SR_ANYDATA_T:
+        return _val->data.anydata_val;
+    default:
+        throw_exception(SR_ERR_UNSUPPORTED);
+    }
+}
+
+// Vals_Array
+Vals_Array::Vals_Array(Vals_Array &&other) noexcept : _vals(other._vals), _cnt(other._cnt) {
+    other._vals = nullptr;
+    other._cnt = 0;
+}
+Vals_Array &Vals_Array::operator=(Vals_Array &&other) noexcept {
+    if (this != &other) {
+        sr_free_values(_vals, _cnt);
+        _vals = other._vals;
+        _cnt = other._cnt;
+        other._vals = nullptr;
+        other._cnt = 0;
+    }
+    return *this;
+}
+Vals_Array::~Vals_Array() {
+    sr_free_values(_vals, _cnt);
+}
+
+// Vals_Output
+sr_val_t *Vals_Output::reallocate(size_t n) {
+    int ret = sr_realloc_values(*_cnt, n, _vals);
+    if (ret != SR_ERR_OK)
+        throw_exception(ret);
+    *_cnt = n;
+    return *_vals;
+}
+
 // Change_Iter
 Change_Iter::Change_Iter(sr_change_iter_t *iter) {_iter = iter;}
 Change_Iter::~Change_Iter() {}
 
+// Borrowed_Data
+Borrowed_Data::Borrowed_Data(sr_borrowed_data_t *data, const struct ly_set *nodes) {
+    if (!data || !nodes)
+        throw_exception(SR_ERR_INVAL_ARG);
+    _data = data;
+    _nodes = nodes;
+}
+Borrowed_Data::~Borrowed_Data() {sr_release_data(_data);}
+libyang::S_Data_Node Borrowed_Data::node(size_t n) {
+    if (n >= _nodes->number)
+        throw std::out_of_range("Borrowed_Data::node: index out of range");
+
+    return std::make_shared<libyang::Data_Node>(_nodes->set.d[n]);
+}
+
 // Errors
 Errors::Errors() {_info = nullptr;}
 Errors::~Errors() {}
 
 // Iter_Change
+Iter_Value::Iter_Value(sr_val_iter_t *iter, sr_session_ctx_t *sess) {_iter = iter; _sess = sess;}
+Iter_Value::~Iter_Value() {if (_iter) sr_free_val_iter(_iter);}
+S_Val Iter_Value::next() {
+    sr_val_t *val;
+
+    int ret = sr_get_item_next(_sess, _iter, &val);
+    if (SR_ERR_OK == ret) {
+        /* owned by the iterator */
+        return std::make_shared<Val>(val, nullptr);
+    }
+    if (SR_ERR_NOT_FOUND == ret) {
+        return nullptr;
+    }
+    throw_exception(ret);
+}
+Iter_Value::iterator Iter_Value::begin() {return iterator(this, next());}
+Iter_Value::iterator &Iter_Value::iterator::operator++() {
+    _val = _iter->next();
+    return *this;
+}
+
 Iter_Change::Iter_Change(sr_change_iter_t *iter) {_iter = iter;}
 Iter_Change::~Iter_Change() {if (_iter) sr_free_change_iter(_iter);}
 
@@ -88,6 +88,43 @@ private:
     S_Deleter _deleter;
 };
 
+/**
+ * @brief Non-owning reference to a sr_val_t, its accessors do not allocate anything.
+ * @class Val_Ref
+ */
+class Val_Ref
+{
+public:
+    /** Wrapper for [sr_val_t](@ref sr_val_t), the value must outlive this object.*/
+    Val_Ref(const sr_val_t &val) : _val(&val) {};
+    /** Getter for xpath.*/
+    const char *xpath() const {return _val->xpath;};
+    /** Getter for type.*/
+    sr_type_t type() const {return _val->type;};
+    /** Getter for dflt.*/
+    bool dflt() const {return _val->dflt;};
+    /** Getter for origin.*/
+    const char *origin() const {return _val->origin;};
+    /** Getter for the value as the C++ type T (bool, double, int8_t - uint64_t, or const char * for all
+     * string-based types), throws if the value is of a different type.*/
+    template <typename T> T as() const;
+
+private:
+    const sr_val_t *_val;
+};
+
+template <> bool Val_Ref::as<bool>() const;
+template <> double Val_Ref::as<double>() const;
+template <> int8_t Val_Ref::as<int8_t>() const;
+template <> int16_t Val_Ref::as<int16_t>() const;
+template <> int32_t Val_Ref::as<int32_t>() const;
+template <> int64_t Val_Ref::as<int64_t>() const;
+template <> uint8_t Val_Ref::as<uint8_t>() const;
+template <> uint16_t Val_Ref::as<uint16_t>() const;
+template <> uint32_t Val_Ref::as<uint32_t>() const;
+template <> uint64_t Val_Ref::as<uint64_t>() const;
+template <> const char *Val_Ref::as<const char *>() const;
+
 /**
  * @brief Class for wrapping sr_val_t.
  * @class Val
@@ -168,6 +205,12 @@ public:
     std::string val_to_string();
     /** Wrapper for [sr_dup_val](@ref sr_dup_val) */
     S_Val dup();
+    /** Getter for the value as the C++ type T, see Val_Ref::as */
+    template <typename T> T as() const {
+        if (_val == nullptr)
+            throw_exception(SR_ERR_OPERATION_FAILED);
+        return Val_Ref(*_val).as<T>();
+    };
 
     friend class Session;
     friend class Subscribe;
@@ -235,6 +278,83 @@ private:
     bool _allocate;
 };
 
+/**
+ * @brief Non-owning view of a read-only sr_val_t array, used in lightweight callbacks.
+ * @class Vals_View
+ */
+class Vals_View
+{
+public:
+    /** Wrapper for [sr_val_t](@ref sr_val_t) array, internal use only.*/
+    Vals_View(const sr_val_t *vals, size_t cnt) : _vals(vals), _cnt(cnt) {};
+    /** Getter for array size */
+    size_t size() const {return _cnt;};
+    /** Getter for the n-th value, valid only during the callback.*/
+    const sr_val_t &operator[](size_t n) const {return _vals[n];};
+    /** Getter for the first value, for range-based for loops.*/
+    const sr_val_t *begin() const {return _vals;};
+    /** Getter for the end of the array, for range-based for loops.*/
+    const sr_val_t *end() const {return _vals + _cnt;};
+
+private:
+    const sr_val_t *_vals;
+    size_t _cnt;
+};
+
+/**
+ * @brief Move-only owner of a contiguous sr_val_t array, accessing the values does not allocate anything.
+ * @class Vals_Array
+ */
+class Vals_Array
+{
+public:
+    /** Constructor for an empty array.*/
+    Vals_Array() : _vals(nullptr), _cnt(0) {};
+    /** Takes over [sr_val_t](@ref sr_val_t) array, internal use only.*/
+    Vals_Array(sr_val_t *vals, size_t cnt) : _vals(vals), _cnt(cnt) {};
+    Vals_Array(Vals_Array &&other) noexcept;
+    Vals_Array &operator=(Vals_Array &&other) noexcept;
+    Vals_Array(const Vals_Array &) = delete;
+    Vals_Array &operator=(const Vals_Array &) = delete;
+    /** Wrapper for [sr_free_values](@ref sr_free_values) */
+    ~Vals_Array();
+    /** Getter for array size */
+    size_t size() const {return _cnt;};
+    /** Getter for the n-th value.*/
+    Val_Ref operator[](size_t n) const {return Val_Ref(_vals[n]);};
+    /** Getter for the first value, for range-based for loops.*/
+    const sr_val_t *begin() const {return _vals;};
+    /** Getter for the end of the array, for range-based for loops.*/
+    const sr_val_t *end() const {return _vals + _cnt;};
+    /** Getter for a non-owning view of the values.*/
+    Vals_View view() const {return Vals_View(_vals, _cnt);};
+
+private:
+    sr_val_t *_vals;
+    size_t _cnt;
+};
+
+/**
+ * @brief Non-owning view of the output sr_val_t array of lightweight RPC/action callbacks.
+ * @class Vals_Output
+ */
+class Vals_Output
+{
+public:
+    /** Wrapper for [sr_val_t](@ref sr_val_t) output array, internal use only.*/
+    Vals_Output(sr_val_t **vals, size_t *cnt) : _vals(vals), _cnt(cnt) {};
+    /** Wrapper for [sr_realloc_values](@ref sr_realloc_values), resize the output array to n values.*/
+    sr_val_t *reallocate(size_t n);
+    /** Getter for array size */
+    size_t size() const {return *_cnt;};
+    /** Getter for the n-th value to be filled.*/
+    sr_val_t &operator[](size_t n) {return (*_vals)[n];};
+
+private:
+    sr_val_t **_vals;
+    size_t *_cnt;
+};
+
 /**
  * @brief Class for wrapping sr_change_iter_t.
  * @class Change_Iter
@@ -252,6 +372,29 @@ private:
     sr_change_iter_t *_iter;
 };
 
+/**
+ * @brief Class for wrapping sr_borrowed_data_t, the data are released when the object is destroyed.
+ * @class Borrowed_Data
+ */
+class Borrowed_Data
+{
+public:
+    /** Wrapper for [sr_borrowed_data_t](@ref sr_borrowed_data_t), internal use only.*/
+    Borrowed_Data(sr_borrowed_data_t *data, const struct ly_set *nodes);
+    /** Wrapper for [sr_release_data](@ref sr_release_data) */
+    ~Borrowed_Data();
+    Borrowed_Data(const Borrowed_Data &) = delete;
+    Borrowed_Data &operator=(const Borrowed_Data &) = delete;
+    /** Getter for the count of borrowed nodes */
+    size_t node_cnt() {return _nodes->number;};
+    /** Getter for the n-th borrowed node, it must not be modified nor used after this object is destroyed.*/
+    libyang::S_Data_Node node(size_t n);
+
+private:
+    sr_borrowed_data_t *_data;
+    const struct ly_set *_nodes;
+};
+
 /**
  * @brief Class for wrapping sr_error_info_t.
  * @class Errors
@@ -277,6 +420,46 @@ private:
     const sr_error_info_t *_info;
 };
 
+/**
+ * @brief Class for wrapping sr_val_iter_t, can be used in a range-based for loop.
+ * @class Iter_Value
+ */
+class Iter_Value
+{
+
+public:
+    /** Wrapper for [sr_val_iter_t](@ref sr_val_iter_t).*/
+    Iter_Value(sr_val_iter_t *iter = nullptr, sr_session_ctx_t *sess = nullptr);
+    ~Iter_Value();
+
+    /** Input iterator over the values, each value is valid only until the next one is retrieved.*/
+    class iterator
+    {
+    public:
+        iterator(Iter_Value *iter, S_Val val) : _iter(iter), _val(val) {};
+        S_Val operator*() const {return _val;};
+        iterator &operator++();
+        bool operator!=(const iterator &other) const {return _val != other._val;};
+
+    private:
+        Iter_Value *_iter;
+        S_Val _val;
+    };
+
+    /** Wrapper for [sr_get_item_next](@ref sr_get_item_next), iterator of the first value */
+    iterator begin();
+    /** Iterator past the last value */
+    iterator end() {return iterator(this, nullptr);};
+
+    friend class Session;
+
+private:
+    S_Val next();
+
+    sr_val_iter_t *_iter;
+    sr_session_ctx_t *_sess;
+};
+
 /**
  * @brief Class for wrapping sr_change_iter_t.
  * @class Iter_Change
@@ -38,6 +38,7 @@ namespace sysrepo {
  * @{
  */
 
+class Iter_Value;
 class Iter_Change;
 class Session;
 class Subscribe;
@@ -53,7 +54,9 @@ class Logs;
 class Change;
 class Tree_Change;
 class Deleter;
+class Borrowed_Data;
 
+using S_Iter_Value       = std::shared_ptr<Iter_Value>;
 using S_Iter_Change      = std::shared_ptr<Iter_Change>;
 using S_Session          = std::shared_ptr<Session>;
 using S_Subscribe        = std::shared_ptr<Subscribe>;
@@ -69,6 +72,7 @@ using S_Logs             = std::shared_ptr<Logs>;
 using S_Change           = std::shared_ptr<Change>;
 using S_Tree_Change      = std::shared_ptr<Tree_Change>;
 using S_Deleter          = std::shared_ptr<Deleter>;
+using S_Borrowed_Data    = std::shared_ptr<Borrowed_Data>;
 
 /* this is a workaround for python not recognizing
  * enum's in function default values */
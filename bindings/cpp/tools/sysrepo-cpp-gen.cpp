@@ -0,0 +1,756 @@
+/**
+ * @file sysrepo-cpp-gen.cpp
+ * @brief Generator of typed C++ accessors for installed YANG modules
+ *
+ * @copyright
+ * Copyright 2016 - 2019 Deutsche Telekom AG.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cctype>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
+#include <libgen.h>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <libyang/libyang.h>
+
+#include "sysrepo.h"
+
+using namespace std;
+
+/* schema node with everything needed to generate its accessors */
+struct gen_node {
+    const struct lys_node *schema;
+    string path;        /* data path, compile-time constant */
+    string member;      /* Schema member with the resolved schema node */
+    string cls;         /* class name, for inner nodes and leaf-lists */
+    string qcls;        /* fully qualified class name, cannot be hidden by any accessor */
+    string name;        /* accessor name */
+    vector<gen_node> children;
+};
+
+/* identifiers already used in the flat scopes of a generated header */
+struct gen_names {
+    string ns;              /* module namespace */
+    set<string> members;    /* paths constants and Schema members */
+    set<string> classes;    /* classes in the module namespace */
+};
+
+/* all the accessors that may be generated for a node, all must be unique in the parent classes */
+static const char *accessor_forms[] = {"", "has_", "set_", "add_", NULL};
+/* all the classes that may be generated for a node */
+static const char *class_forms[] = {"", "_Edit", NULL};
+
+/* C++ mapping of a leaf type */
+struct gen_type {
+    string cpp;         /* C++ type */
+    string read;        /* member of struct lyd_node_leaf_list holding the value */
+    string write;       /* support function creating the leaf */
+    string extra;       /* additional arguments of the support function */
+    bool empty;
+};
+
+static const char *reserved[] = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char",
+    "char16_t", "char32_t", "class", "compl", "const", "constexpr", "const_cast", "continue", "decltype", "default",
+    "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for",
+    "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+    "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "return",
+    "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template", "this",
+    "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual",
+    "void", "volatile", "wchar_t", "while", "xor", "xor_eq", NULL
+};
+
+static void
+help_print(void)
+{
+    printf(
+            "Usage:\n"
+            "  sysrepo-cpp-gen [-o <dir>] (<module-name> | <file.yang>)...\n"
+            "\n"
+            "  Generate a header with typed C++ accessors for every specified YANG module installed in sysrepo\n"
+            "  or parsed from a YANG file, imports are searched for in the directory of the file.\n"
+            "  The header is named \"<module-name>.hpp\" and requires \"Generated.hpp\" from sysrepo-cpp.\n"
+            "\n"
+            "Available options:\n"
+            "  -h, --help           Print usage help.\n"
+            "  -o, --output-dir <dir>\n"
+            "                       Directory to write the generated headers into, the current directory by default.\n"
+            "\n");
+}
+
+static void
+error_print(int sr_error, const char *format, ...)
+{
+    va_list ap;
+    char msg[2048];
+
+    if (!sr_error) {
+        sprintf(msg, "sysrepo-cpp-gen error: %s\n", format);
+    } else {
+        sprintf(msg, "sysrepo-cpp-gen error: %s (%s)\n", format, sr_strerror(sr_error));
+    }
+
+    va_start(ap, format);
+    vfprintf(stderr, msg, ap);
+    va_end(ap);
+}
+
+static string
+gen_ident(const char *name)
+{
+    string ident;
+    int i;
+
+    /* no leading or double underscores, they are reserved */
+    for (; *name; ++name) {
+        if (isalnum(*name)) {
+            ident += *name;
+        } else if (!ident.empty() && (ident.back() != '_')) {
+            ident += '_';
+        }
+    }
+    if (!ident.empty() && (ident.back() == '_')) {
+        ident.pop_back();
+    }
+    if (ident.empty() || isdigit(ident[0])) {
+        ident = "n" + ident;
+    }
+    for (i = 0; reserved[i]; ++i) {
+        if (ident == reserved[i]) {
+            ident += '_';
+            break;
+        }
+    }
+
+    return ident;
+}
+
+static string
+gen_join(const string &prefix, const string &ident)
+{
+    if (prefix.empty()) {
+        return ident;
+    }
+
+    /* reserved word suffix is not needed anymore */
+    if (prefix.back() == '_') {
+        return prefix + ident;
+    }
+    return prefix + "_" + ident;
+}
+
+static string
+gen_cls_ident(const string &ident)
+{
+    string cls = ident;
+    size_t i;
+
+    for (i = 0; i < cls.size(); ++i) {
+        if (!i || (cls[i - 1] == '_')) {
+            cls[i] = toupper(cls[i]);
+        }
+    }
+
+    /* capitalized reserved word */
+    if (cls.back() == '_') {
+        cls.pop_back();
+    }
+
+    return cls;
+}
+
+/* returns base, or base with a numeric suffix, so that none of its forms are used in scope yet, and uses them */
+static string
+gen_unique(set<string> &scope, const string &base, const char **prefixes, const char **suffixes)
+{
+    string ident;
+    unsigned n;
+    int i, j;
+    bool unused;
+
+    for (n = 1; ; ++n) {
+        ident = (n == 1) ? base : gen_join(base, to_string(n));
+
+        unused = true;
+        for (i = 0; unused && prefixes[i]; ++i) {
+            for (j = 0; unused && suffixes[j]; ++j) {
+                unused = !scope.count(prefixes[i] + ident + suffixes[j]);
+            }
+        }
+        if (unused) {
+            break;
+        }
+    }
+
+    for (i = 0; prefixes[i]; ++i) {
+        for (j = 0; suffixes[j]; ++j) {
+            scope.insert(prefixes[i] + ident + suffixes[j]);
+        }
+    }
+    return ident;
+}
+
+static gen_type
+gen_leaf_type(const struct lys_node *snode)
+{
+    const struct lys_type *type;
+    gen_type gtype;
+
+    if (snode->nodetype == LYS_LEAF) {
+        type = &((const struct lys_node_leaf *)snode)->type;
+    } else {
+        type = &((const struct lys_node_leaflist *)snode)->type;
+    }
+
+    gtype.empty = false;
+    switch (type->base) {
+    case LY_TYPE_BOOL:
+        gtype.cpp = "bool";
+        gtype.read = "value.bln";
+        gtype.write = "new_leaf_bool";
+        break;
+    case LY_TYPE_INT8:
+    case LY_TYPE_INT16:
+    case LY_TYPE_INT32:
+    case LY_TYPE_INT64:
+    {
+        const char *bits = (type->base == LY_TYPE_INT8) ? "8" : (type->base == LY_TYPE_INT16) ? "16" :
+                (type->base == LY_TYPE_INT32) ? "32" : "64";
+
+        gtype.cpp = string("int") + bits + "_t";
+        gtype.read = string("value.int") + bits;
+        gtype.write = "new_leaf_int";
+        break;
+    }
+    case LY_TYPE_UINT8:
+    case LY_TYPE_UINT16:
+    case LY_TYPE_UINT32:
+    case LY_TYPE_UINT64:
+    {
+        const char *bits = (type->base == LY_TYPE_UINT8) ? "8" : (type->base == LY_TYPE_UINT16) ? "16" :
+                (type->base == LY_TYPE_UINT32) ? "32" : "64";
+
+        gtype.cpp = string("uint") + bits + "_t";
+        gtype.read = string("value.uint") + bits;
+        gtype.write = "new_leaf_uint";
+        break;
+    }
+    case LY_TYPE_DEC64:
+        /* fraction-digits are defined only in the first derived type */
+        while (!type->info.dec64.dig && type->der) {
+            type = &type->der->type;
+        }
+        if (type->info.dec64.dig) {
+            gtype.cpp = "double";
+            gtype.read = "value.dec64 / 1e" + to_string(type->info.dec64.dig);
+            gtype.write = "new_leaf_dec64";
+            gtype.extra = ", " + to_string(type->info.dec64.dig);
+            break;
+        }
+        /* fallthrough */
+    default:
+        /* string, enumeration, identityref, union, leafref, ... are all accessed by their canonical value */
+        gtype.cpp = "const char *";
+        gtype.read = "value_str";
+        gtype.write = "new_leaf";
+        break;
+    case LY_TYPE_EMPTY:
+        gtype.cpp = "bool";
+        gtype.write = "new_leaf";
+        gtype.empty = true;
+        break;
+    }
+
+    return gtype;
+}
+
+static void
+gen_tree(const struct lys_module *ly_mod, const struct lys_node *parent, const gen_node *gparent, gen_names &names,
+        vector<gen_node> &nodes)
+{
+    static const char *none[] = {"", NULL};
+    const struct lys_node *snode = NULL;
+    const struct lys_module *node_mod;
+    set<string> accessors;
+    string seg;
+
+    /* members of the generated classes and names they use */
+    accessors = {"node", "exists", "empty", "release", "Schema", "sysrepo", "libyang"};
+    if (gparent) {
+        accessors.insert(gparent->cls);
+        accessors.insert(gparent->cls + "_Edit");
+    } else {
+        accessors.insert("Data");
+        accessors.insert("Edit");
+    }
+
+    while ((snode = lys_getnext(snode, parent, ly_mod, 0))) {
+        if (!(snode->nodetype & (LYS_CONTAINER | LYS_LIST | LYS_LEAF | LYS_LEAFLIST))) {
+            continue;
+        }
+
+        gen_node gnode;
+        gnode.schema = snode;
+
+        /* nodes augmented from foreign modules are prefixed */
+        node_mod = lys_node_module(snode);
+        seg = gen_ident(snode->name);
+        if (!gparent || (node_mod != lys_node_module(gparent->schema))) {
+            gnode.path = (gparent ? gparent->path : string()) + "/" + node_mod->name + ":" + snode->name;
+            if (gparent) {
+                seg = gen_join(gen_ident(node_mod->name), seg);
+            }
+        } else {
+            gnode.path = gparent->path + "/" + snode->name;
+        }
+        gnode.name = gen_unique(accessors, seg, accessor_forms, none);
+        gnode.member = gen_unique(names.members, gen_join(gparent ? gparent->member : string(), seg), none, none);
+        if (snode->nodetype != LYS_LEAF) {
+            gnode.cls = gen_unique(names.classes, gen_join(gparent ? gparent->cls : string(), gen_cls_ident(seg)),
+                    none, class_forms);
+            gnode.qcls = "::" + names.ns + "::" + gnode.cls;
+        }
+
+        if (snode->nodetype & (LYS_CONTAINER | LYS_LIST)) {
+            gen_tree(NULL, snode, &gnode, names, gnode.children);
+        }
+        nodes.push_back(gnode);
+    }
+}
+
+static void
+gen_paths(ofstream &out, const vector<gen_node> &nodes)
+{
+    for (const gen_node &gnode : nodes) {
+        out << "constexpr const char *" << gnode.member << " = \"" << gnode.path << "\";\n";
+        gen_paths(out, gnode.children);
+    }
+}
+
+static void
+gen_schema_members(ofstream &out, const vector<gen_node> &nodes)
+{
+    for (const gen_node &gnode : nodes) {
+        out << "    const struct lys_node *" << gnode.member << ";\n";
+        gen_schema_members(out, gnode.children);
+    }
+}
+
+static void
+gen_schema_init(ofstream &out, const vector<gen_node> &nodes, bool &first)
+{
+    for (const gen_node &gnode : nodes) {
+        out << (first ? "        " : ",\n        ") << gnode.member << "(sysrepo::gen::schema_node(ctx, paths::"
+                << gnode.member << "))";
+        first = false;
+        gen_schema_init(out, gnode.children, first);
+    }
+}
+
+static void
+gen_getters(ofstream &out, const vector<gen_node> &nodes, const char *lookup)
+{
+    for (const gen_node &gnode : nodes) {
+        string find = string("sysrepo::gen::") + lookup + "(_node, _schema->" + gnode.member + ")";
+
+        switch (gnode.schema->nodetype) {
+        case LYS_LEAF:
+        {
+            gen_type gtype = gen_leaf_type(gnode.schema);
+
+            if (gtype.empty) {
+                out << "    /** Whether leaf \"" << gnode.schema->name << "\" exists.*/\n";
+                out << "    bool " << gnode.name << "() const {return " << find << " != nullptr;};\n";
+                break;
+            }
+            out << "    /** Whether leaf \"" << gnode.schema->name << "\" exists.*/\n";
+            out << "    bool has_" << gnode.name << "() const {return " << find << " != nullptr;};\n";
+            out << "    /** Value of leaf \"" << gnode.schema->name << "\", throws if it does not exist.*/\n";
+            out << "    " << gtype.cpp << (gtype.cpp.back() == '*' ? "" : " ") << gnode.name
+                    << "() const {return sysrepo::gen::leaf(" << find << ")->" << gtype.read << ";};\n";
+            break;
+        }
+        case LYS_CONTAINER:
+            out << "    /** Container \"" << gnode.schema->name << "\", may not exist.*/\n";
+            out << "    " << gnode.qcls << " " << gnode.name << "() const {return " << gnode.qcls << "(*_schema, "
+                    << find << ");};\n";
+            break;
+        case LYS_LIST:
+        case LYS_LEAFLIST:
+            out << "    /** All the instances of " << (gnode.schema->nodetype == LYS_LIST ? "list" : "leaf-list")
+                    << " \"" << gnode.schema->name << "\".*/\n";
+            out << "    sysrepo::gen::Instances<" << gnode.qcls << ", Schema> " << gnode.name << "() const {return "
+                    << "sysrepo::gen::Instances<" << gnode.qcls << ", Schema>(*_schema, " << find << ");};\n";
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static void
+gen_setters(ofstream &out, const vector<gen_node> &nodes, const char *parent, const char *edit)
+{
+    static const char *none[] = {"", NULL};
+    const struct lys_node_list *slist;
+    const gen_node *gkey;
+    set<string> params;
+    vector<string> args;
+    uint8_t i;
+
+    for (const gen_node &gnode : nodes) {
+        if ((gnode.schema->flags & LYS_CONFIG_R)
+                || ((gnode.schema->nodetype == LYS_LEAF) && lys_is_key((const struct lys_node_leaf *)gnode.schema, NULL))) {
+            /* state data cannot be edited, keys are set when the list instance is created */
+            continue;
+        }
+
+        switch (gnode.schema->nodetype) {
+        case LYS_LEAF:
+        case LYS_LEAFLIST:
+        {
+            gen_type gtype = gen_leaf_type(gnode.schema);
+            const char *oper = (gnode.schema->nodetype == LYS_LEAF) ? "set_" : "add_";
+
+            if (gnode.schema->nodetype == LYS_LEAF) {
+                out << "    /** Sets leaf \"" << gnode.schema->name << "\".*/\n";
+            } else {
+                out << "    /** Adds an instance of leaf-list \"" << gnode.schema->name << "\".*/\n";
+            }
+            if (gtype.empty) {
+                out << "    void " << oper << gnode.name << "() {sysrepo::gen::new_leaf(" << parent << ", " << edit
+                        << ", _schema->" << gnode.member << ", \"\");};\n";
+                break;
+            }
+            out << "    void " << oper << gnode.name << "(" << gtype.cpp << (gtype.cpp.back() == '*' ? "" : " ")
+                    << "value) {sysrepo::gen::" << gtype.write << "(" << parent << ", " << edit << ", _schema->"
+                    << gnode.member << ", value" << gtype.extra << ");};\n";
+            break;
+        }
+        case LYS_CONTAINER:
+            out << "    /** Container \"" << gnode.schema->name << "\", created if it does not exist yet.*/\n";
+            out << "    " << gnode.qcls << "_Edit " << gnode.name << "() {return " << gnode.qcls << "_Edit(*_schema, "
+                    << "sysrepo::gen::get_inner(" << parent << ", " << edit << ", _schema->" << gnode.member
+                    << "));};\n";
+            break;
+        case LYS_LIST:
+            slist = (const struct lys_node_list *)gnode.schema;
+            if (!slist->keys_size) {
+                break;
+            }
+
+            /* key parameters must not hide anything used in the function */
+            params = {"inst", "sysrepo"};
+            args.clear();
+            for (i = 0; i < slist->keys_size; ++i) {
+                args.push_back(gen_unique(params, gen_ident(slist->keys[i]->name), none, none));
+            }
+
+            out << "    /** Creates a new instance of list \"" << gnode.schema->name << "\".*/\n";
+            out << "    " << gnode.qcls << "_Edit add_" << gnode.name << "(";
+            for (i = 0; i < slist->keys_size; ++i) {
+                gen_type gtype = gen_leaf_type((const struct lys_node *)slist->keys[i]);
+                out << (i ? ", " : "") << gtype.cpp << (gtype.cpp.back() == '*' ? "" : " ") << args[i];
+            }
+            out << ")\n    {\n";
+            out << "        struct lyd_node *inst = sysrepo::gen::new_inner(" << parent << ", " << edit << ", _schema->"
+                    << gnode.member << ");\n";
+            for (i = 0; i < slist->keys_size; ++i) {
+                gen_type gtype = gen_leaf_type((const struct lys_node *)slist->keys[i]);
+
+                gkey = NULL;
+                for (const gen_node &gchild : gnode.children) {
+                    if (gchild.schema == (const struct lys_node *)slist->keys[i]) {
+                        gkey = &gchild;
+                        break;
+                    }
+                }
+                out << "        sysrepo::gen::" << gtype.write << "(inst, nullptr, _schema->" << gkey->member << ", "
+                        << args[i] << gtype.extra << ");\n";
+            }
+            out << "        return " << gnode.qcls << "_Edit(*_schema, inst);\n";
+            out << "    };\n";
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static void
+gen_classes(ofstream &out, const gen_node &gnode)
+{
+    for (const gen_node &gchild : gnode.children) {
+        if (gchild.schema->nodetype != LYS_LEAF) {
+            gen_classes(out, gchild);
+        }
+    }
+
+    if (gnode.schema->nodetype == LYS_LEAFLIST) {
+        gen_type gtype = gen_leaf_type(gnode.schema);
+
+        out << "/** Instance of leaf-list " << gnode.path << ".*/\n";
+        out << "class " << gnode.cls << "\n{\npublic:\n";
+        out << "    " << gnode.cls << "(const Schema &, const struct lyd_node *node) : _node(node) {};\n";
+        out << "    const struct lyd_node *node() const {return _node;};\n";
+        if (gtype.empty) {
+            out << "    bool value() const {return true;};\n";
+        } else {
+            out << "    " << gtype.cpp << (gtype.cpp.back() == '*' ? "" : " ") << "value() const {return "
+                    << "sysrepo::gen::leaf(_node)->" << gtype.read << ";};\n";
+        }
+        out << "\nprivate:\n    const struct lyd_node *_node;\n};\n\n";
+        return;
+    }
+
+    out << "/** Accessors of " << (gnode.schema->nodetype == LYS_LIST ? "list" : "container") << " " << gnode.path
+            << ".*/\n";
+    out << "class " << gnode.cls << "\n{\npublic:\n";
+    out << "    " << gnode.cls << "(const Schema &schema, const struct lyd_node *node) : _schema(&schema), _node(node) "
+            << "{};\n";
+    out << "    /** Whether the " << (gnode.schema->nodetype == LYS_LIST ? "list instance" : "container") << " exists.*/\n";
+    out << "    bool exists() const {return _node != nullptr;};\n";
+    out << "    const struct lyd_node *node() const {return _node;};\n";
+    gen_getters(out, gnode.children, "find_child");
+    out << "\nprivate:\n    const Schema *_schema;\n    const struct lyd_node *_node;\n};\n\n";
+
+    if (gnode.schema->flags & LYS_CONFIG_R) {
+        return;
+    }
+
+    out << "/** Edit of " << (gnode.schema->nodetype == LYS_LIST ? "list" : "container") << " " << gnode.path << ".*/\n";
+    out << "class " << gnode.cls << "_Edit\n{\npublic:\n";
+    out << "    " << gnode.cls << "_Edit(const Schema &schema, struct lyd_node *node) : _schema(&schema), _node(node) "
+            << "{};\n";
+    out << "    struct lyd_node *node() const {return _node;};\n";
+    gen_setters(out, gnode.children, "_node", "nullptr");
+    out << "\nprivate:\n    const Schema *_schema;\n    struct lyd_node *_node;\n};\n\n";
+}
+
+static int
+gen_module(const struct lys_module *ly_mod, const char *dir)
+{
+    vector<gen_node> nodes;
+    gen_names names;
+    string ns, guard, file;
+    ofstream out;
+    bool first = true;
+
+    ns = gen_ident(ly_mod->name);
+    if ((ns == "sysrepo") || (ns == "libyang") || (ns == "std")) {
+        /* would be merged with a namespace used by the header */
+        ns += '_';
+    }
+    guard = ns;
+    for (char &c : guard) {
+        c = toupper(c);
+    }
+    guard += "_GEN_HPP";
+    file = string(dir) + "/" + ly_mod->name + ".hpp";
+
+    /* names used by the header itself */
+    names.ns = ns;
+    names.members = {"Schema", "ctx"};
+    names.classes = {"Schema", "Data", "Edit", "paths"};
+    gen_tree(ly_mod, NULL, NULL, names, nodes);
+
+    out.open(file);
+    if (!out) {
+        error_print(0, "Failed to open \"%s\" (%s).", file.c_str(), strerror(errno));
+        return EXIT_FAILURE;
+    }
+
+    out << "/**\n";
+    out << " * @file " << ly_mod->name << ".hpp\n";
+    out << " * @brief Typed accessors of module \"" << ly_mod->name << "\"";
+    if (ly_mod->rev_size) {
+        out << " revision " << ly_mod->rev[0].date;
+    }
+    out << ".\n *\n * Generated by sysrepo-cpp-gen, do not edit.\n */\n\n";
+    out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+    out << "#include <cstdint>\n\n#include <libyang/libyang.h>\n\n#include \"Generated.hpp\"\n\n";
+    out << "namespace " << ns << " {\n\n";
+
+    /* paths */
+    out << "/** Data paths of all the nodes.*/\nnamespace paths {\n";
+    gen_paths(out, nodes);
+    out << "}\n\n";
+
+    /* schema nodes */
+    out << "/** Schema nodes of all the nodes, resolve once for a context.*/\n";
+    out << "struct Schema\n{\n";
+    out << "    explicit Schema(const struct ly_ctx *ctx)";
+    if (!nodes.empty()) {
+        out << " :\n";
+        gen_schema_init(out, nodes, first);
+    }
+    out << "\n    {};\n\n";
+    gen_schema_members(out, nodes);
+    out << "};\n\n";
+
+    /* classes */
+    for (const gen_node &gnode : nodes) {
+        if (gnode.schema->nodetype != LYS_LEAF) {
+            gen_classes(out, gnode);
+        }
+    }
+
+    /* top-level data */
+    out << "/** Accessors of the top-level nodes in a data tree, the tree must exist as long as any accessors.*/\n";
+    out << "class Data\n{\npublic:\n";
+    out << "    Data(const Schema &schema, const struct lyd_node *tree) : _schema(&schema), "
+            << "_node(sysrepo::gen::first_sibling(tree)) {};\n";
+    out << "    Data(const Schema &schema, const libyang::S_Data_Node &tree) : _schema(&schema), "
+            << "_node(sysrepo::gen::first_sibling(tree ? tree->swig_node() : nullptr)) {};\n";
+    out << "    const struct lyd_node *node() const {return _node;};\n";
+    gen_getters(out, nodes, "find_sibling");
+    out << "\nprivate:\n    const Schema *_schema;\n    const struct lyd_node *_node;\n};\n\n";
+
+    /* top-level edit */
+    out << "/** Edit of the top-level nodes, to be used with Session::edit_batch().*/\n";
+    out << "class Edit : public sysrepo::gen::Edit_Tree\n{\npublic:\n";
+    out << "    explicit Edit(const Schema &schema) : _schema(&schema) {};\n";
+    gen_setters(out, nodes, "nullptr", "&_tree");
+    out << "\nprivate:\n    const Schema *_schema;\n};\n\n";
+
+    out << "}\n\n#endif\n";
+    out.close();
+    if (!out) {
+        error_print(0, "Failed to write \"%s\".", file.c_str());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/* parses a YANG file into a new context, imports are searched for next to it */
+static int
+gen_file(const char *path, const char *dir)
+{
+    struct ly_ctx *ly_ctx;
+    const struct lys_module *ly_mod;
+    char *path_dup;
+    int rc = EXIT_FAILURE;
+
+    path_dup = strdup(path);
+    if (!path_dup) {
+        error_print(0, "Memory allocation failed");
+        return EXIT_FAILURE;
+    }
+    ly_ctx = ly_ctx_new(dirname(path_dup), LY_CTX_DISABLE_SEARCHDIR_CWD);
+    free(path_dup);
+    if (!ly_ctx) {
+        error_print(0, "Failed to create context");
+        return EXIT_FAILURE;
+    }
+
+    ly_mod = lys_parse_path(ly_ctx, path, LYS_IN_YANG);
+    if (!ly_mod) {
+        error_print(0, "Failed to parse \"%s\"", path);
+        goto cleanup;
+    }
+
+    rc = gen_module(ly_mod, dir);
+
+cleanup:
+    ly_ctx_destroy(ly_ctx, NULL);
+    return rc;
+}
+
+int
+main(int argc, char **argv)
+{
+    sr_conn_ctx_t *conn = NULL;
+    const struct ly_ctx *ly_ctx = NULL;
+    const struct lys_module *ly_mod;
+    const char *dir = ".";
+    size_t len;
+    int r, i, opt, rc = EXIT_FAILURE;
+    struct option options[] = {
+        {"help",            no_argument,       NULL, 'h'},
+        {"output-dir",      required_argument, NULL, 'o'},
+        {NULL,              0,                 NULL, 0},
+    };
+
+    if (argc == 1) {
+        help_print();
+        return EXIT_FAILURE;
+    }
+
+    /* process options */
+    opterr = 0;
+    while ((opt = getopt_long(argc, argv, "ho:", options, NULL)) != -1) {
+        switch (opt) {
+        case 'h':
+            help_print();
+            return EXIT_SUCCESS;
+        case 'o':
+            dir = optarg;
+            break;
+        default:
+            error_print(0, "Invalid option or missing argument: -%c", optopt);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind == argc) {
+        error_print(0, "No modules specified");
+        return EXIT_FAILURE;
+    }
+
+    for (i = optind; i < argc; ++i) {
+        len = strlen(argv[i]);
+        if ((len > 5) && !strcmp(argv[i] + len - 5, ".yang")) {
+            /* YANG file */
+            if (gen_file(argv[i], dir)) {
+                goto cleanup;
+            }
+            continue;
+        }
+
+        if (!conn) {
+            /* create connection */
+            if ((r = sr_connect(0, &conn)) != SR_ERR_OK) {
+                error_print(r, "Failed to connect");
+                goto cleanup;
+            }
+            ly_ctx = sr_get_context(conn);
+        }
+
+        ly_mod = ly_ctx_get_module(ly_ctx, argv[i], NULL, 1);
+        if (!ly_mod) {
+            error_print(0, "Module \"%s\" is not installed", argv[i]);
+            goto cleanup;
+        }
+
+        if (gen_module(ly_mod, dir)) {
+            goto cleanup;
+        }
+    }
+
+    rc = EXIT_SUCCESS;
+
+cleanup:
+    sr_disconnect(conn);
+    return rc;
+}
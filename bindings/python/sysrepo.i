@@ -504,6 +504,183 @@ static const char *g_ly_module_imp_clb(const char *mod_name, const char *mod_rev
     }
 };
 
+%{
+/* native Python object of a value, the GIL must be held */
+static PyObject *
+bulk_val2py(const sr_val_t *val)
+{
+    switch (val->type) {
+    case SR_BOOL_T:
+        return PyBool_FromLong(val->data.bool_val);
+    case SR_DECIMAL64_T:
+        return PyFloat_FromDouble(val->data.decimal64_val);
+    case SR_INT8_T:
+        return PyLong_FromLong(val->data.int8_val);
+    case SR_INT16_T:
+        return PyLong_FromLong(val->data.int16_val);
+    case SR_INT32_T:
+        return PyLong_FromLong(val->data.int32_val);
+    case SR_INT64_T:
+        return PyLong_FromLongLong(val->data.int64_val);
+    case SR_UINT8_T:
+        return PyLong_FromUnsignedLong(val->data.uint8_val);
+    case SR_UINT16_T:
+        return PyLong_FromUnsignedLong(val->data.uint16_val);
+    case SR_UINT32_T:
+        return PyLong_FromUnsignedLong(val->data.uint32_val);
+    case SR_UINT64_T:
+        return PyLong_FromUnsignedLongLong(val->data.uint64_val);
+    case SR_BINARY_T:
+    case SR_BITS_T:
+    case SR_ENUM_T:
+    case SR_IDENTITYREF_T:
+    case SR_INSTANCEID_T:
+    case SR_STRING_T:
+    case SR_ANYXML_T:
+    case SR_ANYDATA_T:
+        /* all the string members share the same storage */
+        if (val->data.string_val) {
+            return PyUnicode_FromString(val->data.string_val);
+        }
+        break;
+    default:
+        break;
+    }
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+%}
+
+%extend sysrepo::Session {
+
+    /* all the values as a list of (xpath, value) tuples with native Python values, created in one call */
+    PyObject *get_items_list(const char *xpath, uint32_t timeout_ms = 0, sr_get_oper_options_t opts = OPER_DEFAULT) {
+        sr_val_t *vals = nullptr;
+        size_t cnt = 0, i;
+        PyObject *list, *item;
+
+        int ret = sr_get_items(self->swig_sess(), xpath, timeout_ms, opts, &vals, &cnt);
+        if (SR_ERR_OK != ret) {
+            throw std::runtime_error(sr_strerror(ret));
+        }
+
+#if defined(SWIG_PYTHON_THREADS)
+        SWIG_Python_Thread_Block safety;
+#endif
+        list = PyList_New(cnt);
+        for (i = 0; list && (i < cnt); ++i) {
+            item = Py_BuildValue("(sN)", vals[i].xpath, bulk_val2py(&vals[i]));
+            if (!item) {
+                Py_CLEAR(list);
+                break;
+            }
+            PyList_SET_ITEM(list, i, item);
+        }
+        sr_free_values(vals, cnt);
+
+        return list;
+    };
+
+    /* data tree printed in JSON, to be parsed by the json module in one call */
+    PyObject *get_data_json(const char *xpath, uint32_t max_depth = 0, uint32_t timeout_ms = 0, \
+                            sr_get_oper_options_t opts = OPER_DEFAULT) {
+        struct lyd_node *data = nullptr;
+        char *str = nullptr;
+        PyObject *json;
+
+        int ret = sr_get_data(self->swig_sess(), xpath, max_depth, timeout_ms, opts, &data);
+        if (SR_ERR_OK != ret) {
+            throw std::runtime_error(sr_strerror(ret));
+        }
+        if (data) {
+            ret = lyd_print_mem(&str, data, LYD_JSON, LYP_WITHSIBLINGS);
+            lyd_free_withsiblings(data);
+            if (ret) {
+                throw std::runtime_error(sr_strerror(SR_ERR_LY));
+            }
+        }
+
+#if defined(SWIG_PYTHON_THREADS)
+        SWIG_Python_Thread_Block safety;
+#endif
+        json = PyUnicode_FromString(str ? str : "{}");
+        free(str);
+
+        return json;
+    };
+
+    /* set all (xpath, value) pairs of a sequence in one bulk edit, value None creates the node without a value */
+    void set_items_list(PyObject *items, sr_edit_options_t opts = EDIT_DEFAULT) {
+        std::vector<sysrepo::Edit_Item> edits;
+        const char *err = nullptr;
+        PyObject *seq, *pair, *str;
+        const char *xpath, *value;
+        Py_ssize_t i, cnt;
+
+        {
+#if defined(SWIG_PYTHON_THREADS)
+            SWIG_Python_Thread_Block safety;
+#endif
+            seq = PySequence_Fast(items, "");
+            if (!seq) {
+                PyErr_Clear();
+                throw std::runtime_error("Items are not a sequence of (xpath, value) pairs.\n");
+            }
+            cnt = PySequence_Fast_GET_SIZE(seq);
+            edits.reserve(cnt);
+            for (i = 0; i < cnt; ++i) {
+                pair = PySequence_Fast_GET_ITEM(seq, i);
+                if (!PyTuple_Check(pair) || (PyTuple_GET_SIZE(pair) != 2) || !(xpath = PyUnicode_AsUTF8(PyTuple_GET_ITEM(pair, 0)))) {
+                    err = "Items are not a sequence of (xpath, value) pairs.\n";
+                    break;
+                }
+
+                /* canonical string of the value */
+                if (PyTuple_GET_ITEM(pair, 1) == Py_None) {
+                    edits.emplace_back(xpath);
+                } else if (PyBool_Check(PyTuple_GET_ITEM(pair, 1))) {
+                    edits.emplace_back(xpath, (PyTuple_GET_ITEM(pair, 1) == Py_True) ? "true" : "false");
+                } else {
+                    str = PyObject_Str(PyTuple_GET_ITEM(pair, 1));
+                    if (!str || !(value = PyUnicode_AsUTF8(str))) {
+                        Py_XDECREF(str);
+                        err = "Item value cannot be converted to a string.\n";
+                        break;
+                    }
+                    edits.emplace_back(xpath, value);
+                    Py_DECREF(str);
+                }
+            }
+            Py_DECREF(seq);
+            if (err) {
+                PyErr_Clear();
+                throw std::runtime_error(err);
+            }
+        }
+
+        /* one sr_set_items() call */
+        self->set_items(edits, nullptr, opts);
+    };
+
+    /* apply an edit in JSON, such as created by the json module, in one call */
+    void edit_batch_json(const char *json, const char *default_operation = "merge") {
+        const struct ly_ctx *ly_ctx = sr_get_context(sr_session_get_connection(self->swig_sess()));
+        struct lyd_node *edit;
+
+        edit = lyd_parse_mem((struct ly_ctx *)ly_ctx, json, LYD_JSON, LYD_OPT_EDIT | LYD_OPT_STRICT);
+        if (!edit) {
+            throw std::runtime_error(sr_strerror(SR_ERR_LY));
+        }
+
+        int ret = sr_edit_batch(self->swig_sess(), edit, default_operation);
+        lyd_free_withsiblings(edit);
+        if (SR_ERR_OK != ret) {
+            throw std::runtime_error(sr_strerror(ret));
+        }
+    };
+};
+
 %extend libyang::Context {
 
     void set_module_imp_clb(PyObject *clb, PyObject *user_data = nullptr) {
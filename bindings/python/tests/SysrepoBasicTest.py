@@ -16,6 +16,7 @@ __license__ = "Apache 2.0"
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
+import json
 import unittest
 import TestModule
 import sysrepo as sr
@@ -130,6 +131,33 @@ class SysrepoBasicTest(unittest.TestCase):
         v = sr.Val(42, sr.SR_UINT8_T)
         self.session.set_item("/test-module:main/numbers", v)
 
+    def test_get_items_list(self):
+        vals = self.session.get_items("/test-module:main/*")
+        items = self.session.get_items_list("/test-module:main/*")
+        self.assertEqual(len(items), vals.val_cnt())
+        for i in range(vals.val_cnt()):
+            self.assertEqual(items[i][0], vals.val(i).xpath())
+        values = dict(items)
+        self.assertEqual(values["/test-module:main/i32"], self.session.get_item("/test-module:main/i32").data().get_int32())
+        self.assertEqual(values["/test-module:main/boolean"], self.session.get_item("/test-module:main/boolean").data().get_bool())
+
+    def test_set_items_list(self):
+        xpath = "/example-module:container/list[key1='abc'][key2='def']/leaf"
+        self.session.set_items_list([(xpath, "Hey hou")])
+        self.session.apply_changes()
+        self.assertEqual(dict(self.session.get_items_list(xpath)), {xpath: "Hey hou"})
+        data = json.loads(self.session.get_data_json("/example-module:container"))
+        self.assertEqual(data["example-module:container"]["list"][0]["leaf"], "Hey hou")
+
+        # one bulk edit, a list instance without a value and an invalid item
+        inst = "/example-module:container/list[key1='ghi'][key2='jkl']"
+        with self.assertRaises(RuntimeError):
+            self.session.set_items_list([(inst, None), (inst + "/no-such-leaf", "x")])
+        self.session.discard_changes()
+        self.session.set_items_list([(inst, None), (inst + "/leaf", "Let's go")])
+        self.session.apply_changes()
+        self.assertEqual(dict(self.session.get_items_list(inst + "/leaf")), {inst + "/leaf": "Let's go"})
+
     def test_commit_empty(self):
         TestModule.create_test_module()
         v_old = self.session.get_item("/test-module:main/string")
@@ -1,4 +1,5 @@
 from __future__ import print_function
+import json
 from time import time
 
 import sysrepo as sr
@@ -360,6 +361,84 @@ def perf_commit_test(state, op_num, items):
 
     return 1
 
+def perf_get_items_vals_test(state, op_num, items):
+
+    conn = state["connection"]
+    assert conn is not None, "Unable to get connection."
+    sess = sr.Session(conn, state['datastore'])
+    assert sess is not None, "Unable to get session."
+
+    xpath = "/example-module:container/list/leaf"
+
+    count = 0
+    for i in range(op_num):
+        values = sess.get_items(xpath)
+        result = [(values.val(j).xpath(), values.val(j).val_to_string()) for j in range(values.val_cnt())]
+        count = len(result)
+
+    return count
+
+def perf_get_items_list_test(state, op_num, items):
+
+    conn = state["connection"]
+    assert conn is not None, "Unable to get connection."
+    sess = sr.Session(conn, state['datastore'])
+    assert sess is not None, "Unable to get session."
+
+    xpath = "/example-module:container/list/leaf"
+
+    count = 0
+    for i in range(op_num):
+        result = sess.get_items_list(xpath)
+        count = len(result)
+
+    return count
+
+def perf_get_data_json_test(state, op_num, items):
+
+    conn = state["connection"]
+    assert conn is not None, "Unable to get connection."
+    sess = sr.Session(conn, state['datastore'])
+    assert sess is not None, "Unable to get session."
+
+    xpath = "/example-module:container"
+
+    count = 0
+    for i in range(op_num):
+        data = json.loads(sess.get_data_json(xpath))
+        count = len(data["example-module:container"]["list"])
+
+    return count
+
+def perf_set_items_test(state, op_num, items):
+
+    conn = state["connection"]
+    assert conn is not None, "Unable to get connection."
+    sess = sr.Session(conn, state['datastore'])
+    assert sess is not None, "Unable to get session."
+
+    for i in range(op_num):
+        for j in range(100):
+            xpath = "/example-module:container/list[key1='bulk'][key2='set_" + str(j) + "']/leaf"
+            sess.set_item(xpath, sr.Val("Leaf", sr.SR_STRING_T))
+        sess.discard_changes()
+
+    return 100
+
+def perf_set_items_list_test(state, op_num, items):
+
+    conn = state["connection"]
+    assert conn is not None, "Unable to get connection."
+    sess = sr.Session(conn, state['datastore'])
+    assert sess is not None, "Unable to get session."
+
+    for i in range(op_num):
+        edits = [("/example-module:container/list[key1='bulk'][key2='set_" + str(j) + "']/leaf", "Leaf") for j in range(100)]
+        sess.set_items_list(edits)
+        sess.discard_changes()
+
+    return 100
+
 def print_measure_header(title):
     print ("\n\n\t\t%s" % (title)) ,
     print ("\n%-40s| %10s | %10s | %13s | %10s | %10s.\n" % ("Operation", "ops/sec", "items/op", "ops performed", "items/sec", "test time")),
@@ -389,6 +468,11 @@ if __name__ == "__main__":
             #  TestContext(perf_set_delete_test, "Set & delete one list", op_count),
             #  TestContext(perf_set_delete_100_test, "Set & delete 100 lists", op_count),
             #  TestContext(perf_commit_test, "Commit one leaf change", op_count),
+             TestContext(perf_get_items_vals_test, "Get all items of a list (Vals)", op_count),
+             TestContext(perf_get_items_list_test, "Get all items of a list (bulk)", op_count),
+             TestContext(perf_get_data_json_test, "Get data of a list (bulk JSON)", op_count),
+             TestContext(perf_set_items_test, "Set 100 leaves (set_item)", op_count),
+             TestContext(perf_set_items_list_test, "Set 100 leaves (bulk)", op_count),
     ]
     
     state = {}
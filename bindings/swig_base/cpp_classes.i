@@ -53,6 +53,12 @@
 %ignore Subscribe::swig_sess;
 %ignore Subscribe::wrap_cb_l;
 %ignore Subscribe::additional_cleanup(void *);
+%ignore Subscribe::module_change_subscribe_view;
+%ignore Subscribe::rpc_subscribe_view;
+%ignore Subscribe::rpc_subscribe_tree_view;
+%ignore Subscribe::event_notif_subscribe_view;
+%ignore Subscribe::event_notif_subscribe_tree_view;
+%ignore Subscribe::oper_get_items_subscribe_view;
 
 %shared_ptr(sysrepo::Data);
 %ignore Data::Data(sr_data_t, sr_type_t);
@@ -82,10 +88,25 @@
 %ignore Vals_Holder::Vals_Holder(sr_val_t **);
 %newobject Vals_Holder::allocate;
 
+%ignore Vals_View;
+%ignore Vals_Output;
+%ignore Val_Ref;
+%ignore Vals_Array;
+%ignore Val::as;
+%ignore Session::get_items_array;
+%ignore Session::async_rpc_send;
+%ignore Session::async_apply_changes;
+%ignore Session::async_get_data;
+%ignore Session::async_event_pipe;
+
 %shared_ptr(sysrepo::Val_Iter);
 %ignore Val_Iter::Val_Iter(sr_val_iter_t *iter);
 %ignore Val_Iter::iter();
 
+%shared_ptr(sysrepo::Borrowed_Data);
+%ignore Borrowed_Data::Borrowed_Data(sr_borrowed_data_t *, const struct ly_set *);
+%newobject Borrowed_Data::node;
+
 %shared_ptr(sysrepo::Change_Iter);
 %ignore Change_Iter::Change_Iter(sr_change_iter_t *iter);
 %ignore Change_Iter::iter();
@@ -120,7 +141,11 @@
 %newobject Fd_Changes::fd_change;
 
 %shared_ptr(sysrepo::Iter_Value);
+%ignore Iter_Value::Iter_Value(sr_val_iter_t *, sr_session_ctx_t *);
 %ignore Iter_Value::Iter_Value(sr_val_iter_t *);
+%ignore Iter_Value::begin;
+%ignore Iter_Value::end;
+%ignore Iter_Value::iterator;
 
 %shared_ptr(sysrepo::Iter_Change);
 %ignore Iter_Change::Iter_Change(sr_change_iter_t *);
@@ -576,6 +601,7 @@
 %template(vectorData_Node) std::vector<std::shared_ptr<libyang::Data_Node>>;
 %template(vectorSchema_Node) std::vector<std::shared_ptr<libyang::Schema_Node>>;
 %template(vector_String) std::vector<std::string>;
+%template(vectorVector_String) std::vector<std::vector<std::string>>;
 %template(vectorModules) std::vector<std::shared_ptr<libyang::Module>>;
 %template(vectorType) std::vector<std::shared_ptr<libyang::Type>>;
 %template(vectorExt_Instance) std::vector<std::shared_ptr<libyang::Ext_Instance>>;
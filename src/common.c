@@ -1157,8 +1157,6 @@ sr_notif_call_callback(sr_session_ctx_t *ev_sess, sr_event_notif_cb cb, sr_event
         const sr_ev_notif_type_t notif_type, const struct lyd_node *notif_op, time_t notif_ts)
 {
     sr_error_info_t *err_info = NULL;
-    const struct lyd_node *next, *elem;
-    void *mem;
     char *notif_xpath = NULL;
     sr_val_t *vals = NULL;
     size_t val_count = 0;
@@ -1175,25 +1173,9 @@ sr_notif_call_callback(sr_session_ctx_t *ev_sess, sr_event_notif_cb cb, sr_event
             notif_xpath = lyd_path(notif_op);
             SR_CHECK_INT_GOTO(!notif_xpath, err_info, cleanup);
 
-            /* prepare input for sr_val CB */
-            LY_TREE_DFS_BEGIN(notif_op, next, elem) {
-                /* skip op node */
-                if (elem != notif_op) {
-                    mem = realloc(vals, (val_count + 1) * sizeof *vals);
-                    if (!mem) {
-                        SR_ERRINFO_MEM(&err_info);
-                        goto cleanup;
-                    }
-                    vals = mem;
-
-                    if ((err_info = sr_val_ly2sr(elem, &vals[val_count]))) {
-                        goto cleanup;
-                    }
-
-                    ++val_count;
-                }
-
-                LY_TREE_DFS_END(notif_op, next, elem);
+            /* prepare input for sr_val CB, skip op node */
+            if ((err_info = sr_vals_ly2sr_arena(notif_op, &vals, &val_count))) {
+                goto cleanup;
             }
         }
 
@@ -1205,7 +1187,7 @@ sr_notif_call_callback(sr_session_ctx_t *ev_sess, sr_event_notif_cb cb, sr_event
 
 cleanup:
     free(notif_xpath);
-    sr_free_values(vals, val_count);
+    free(vals);
     return err_info;
 }
 
@@ -1449,6 +1431,10 @@ sr_remove_data_files(const char *mod_name)
     if ((unlink(path) == -1) && (errno != ENOENT)) {
         SR_LOG_WRN("Failed to unlink \"%s\" (%s).", path, strerror(errno));
     }
+    if ((err_info = sr_module_file_idx_del(path))) {
+        free(path);
+        return err_info;
+    }
     free(path);
 
     if ((err_info = sr_path_ds_shm(mod_name, SR_DS_OPERATIONAL, &path))) {
@@ -3269,13 +3255,24 @@ sr_realloc(void *ptr, size_t size)
     return new_mem;
 }
 
-sr_error_info_t *
-sr_cp_path(const char *to, const char *from, mode_t file_mode)
+/**
+ * @brief Copy contents of a file into an opened file.
+ *
+ * @param[in] fd_to Opened file to copy to.
+ * @param[in] from Path of the file to copy.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_cp_fd(int fd_to, const char *from)
 {
     sr_error_info_t *err_info = NULL;
-    int fd_to = -1, fd_from = -1;
+    int fd_from = -1;
     char *out_ptr, buf[4096];
     ssize_t nread, nwritten;
+#ifdef SR_HAVE_COPY_FILE_RANGE
+    struct stat st;
+    off_t left;
+#endif
 
     /* open "from" file */
     fd_from = sr_open(from, O_RDONLY, 0);
@@ -3284,12 +3281,33 @@ sr_cp_path(const char *to, const char *from, mode_t file_mode)
         goto cleanup;
     }
 
-    /* open "to" */
-    fd_to = sr_open(to, O_WRONLY | O_TRUNC | O_CREAT, file_mode);
-    if (fd_to < 0) {
-        SR_ERRINFO_OPEN(&err_info, to);
+#ifdef SR_HAVE_COPY_FILE_RANGE
+    /* try to let the kernel copy the data */
+    if (fstat(fd_from, &st) == -1) {
+        SR_ERRINFO_SYSERRNO(&err_info, "fstat");
+        goto cleanup;
+    }
+    left = st.st_size;
+    while (left > 0) {
+        nwritten = copy_file_range(fd_from, NULL, fd_to, NULL, left, 0);
+        if (nwritten > 0) {
+            left -= nwritten;
+        } else if ((nwritten == -1) && (errno == EINTR)) {
+            continue;
+        } else if ((left == st.st_size) && ((errno == EXDEV) || (errno == ENOSYS) || (errno == EINVAL)
+                || (errno == EOPNOTSUPP))) {
+            /* not supported for these files, nothing copied so far */
+            break;
+        } else {
+            SR_ERRINFO_SYSERRNO(&err_info, "copy_file_range");
+            goto cleanup;
+        }
+    }
+    if (left < st.st_size) {
+        /* copied */
         goto cleanup;
     }
+#endif
 
     while ((nread = read(fd_from, buf, sizeof buf)) > 0) {
         out_ptr = buf;
@@ -3315,9 +3333,26 @@ cleanup:
     if (fd_from > -1) {
         close(fd_from);
     }
-    if (fd_to > -1) {
-        close(fd_to);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_cp_path(const char *to, const char *from, mode_t file_mode)
+{
+    sr_error_info_t *err_info = NULL;
+    int fd_to = -1;
+
+    /* open "to" */
+    fd_to = sr_open(to, O_WRONLY | O_TRUNC | O_CREAT, file_mode);
+    if (fd_to < 0) {
+        SR_ERRINFO_OPEN(&err_info, to);
+        return err_info;
     }
+
+    /* copy the contents */
+    err_info = sr_cp_fd(fd_to, from);
+
+    close(fd_to);
     return err_info;
 }
 
@@ -3732,18 +3767,98 @@ sr_ev2api(sr_sub_event_t ev)
     return 0;
 }
 
+/**
+ * @brief Store a string of a sysrepo value.
+ *
+ * @param[in] str String to store.
+ * @param[in,out] arena Optional arena to store @p str in, moved past it. If not set, @p str is duplicated.
+ * @return Stored string, NULL on memory allocation error.
+ */
+static char *
+sr_val_str_store(const char *str, char **arena)
+{
+    char *ret;
+    size_t len;
+
+    if (!arena) {
+        return strdup(str);
+    }
+
+    len = strlen(str) + 1;
+    ret = memcpy(*arena, str, len);
+    *arena += len;
+    return ret;
+}
+
 sr_error_info_t *
-sr_val_ly2sr(const struct lyd_node *node, sr_val_t *sr_val)
+sr_val_ly2sr_any(const struct lyd_node *node, char **str)
 {
     sr_error_info_t *err_info = NULL;
-    char *ptr;
-    const struct lyd_node_leaf_list *leaf;
     struct lyd_node_anydata *any;
     struct lyd_node *tree;
+
+    any = (struct lyd_node_anydata *)node;
+    *str = NULL;
+
+    switch (any->value_type) {
+    case LYD_ANYDATA_CONSTSTRING:
+    case LYD_ANYDATA_JSON:
+    case LYD_ANYDATA_SXML:
+        if (any->value.str) {
+            *str = strdup(any->value.str);
+            SR_CHECK_MEM_RET(!*str, err_info);
+        }
+        break;
+    case LYD_ANYDATA_XML:
+        lyxml_print_mem(str, any->value.xml, LYXML_PRINT_FORMAT);
+        break;
+    case LYD_ANYDATA_LYB:
+        /* try to convert into a data tree */
+        tree = lyd_parse_mem(node->schema->module->ctx, any->value.mem, LYD_LYB, LYD_OPT_DATA | LYD_OPT_STRICT, NULL);
+        if (!tree) {
+            sr_errinfo_new_ly(&err_info, node->schema->module->ctx);
+            sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, NULL, "Failed to convert LYB anyxml/anydata into XML.");
+            return err_info;
+        }
+        free(any->value.mem);
+        any->value_type = LYD_ANYDATA_DATATREE;
+        any->value.tree = tree;
+    /* fallthrough */
+    case LYD_ANYDATA_DATATREE:
+        lyd_print_mem(str, any->value.tree, LYD_XML, LYP_FORMAT | LYP_WITHSIBLINGS);
+        break;
+    default:
+        SR_ERRINFO_INT(&err_info);
+        return err_info;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Transform a libyang node into sysrepo value.
+ *
+ * @param[in] node libyang node to transform.
+ * @param[in] path Path of @p node, used only with @p arena.
+ * @param[in,out] arena Optional arena to store all the strings in, large enough and moved past them.
+ * If not set, all the strings are dynamically allocated.
+ * @param[out] sr_val sysrepo value.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_val_ly2sr(const struct lyd_node *node, const char *path, char **arena, sr_val_t *sr_val)
+{
+    sr_error_info_t *err_info = NULL;
+    char *ptr, *str;
+    const struct lyd_node_leaf_list *leaf;
     const char *origin;
 
-    sr_val->xpath = lyd_path(node);
-    SR_CHECK_MEM_GOTO(!sr_val->xpath, err_info, error);
+    if (arena) {
+        sr_val->xpath = sr_val_str_store(path, arena);
+    } else {
+        sr_val->xpath = lyd_path(node);
+        SR_CHECK_MEM_GOTO(!sr_val->xpath, err_info, error);
+    }
 
     sr_val->dflt = node->dflt;
 
@@ -3758,12 +3873,12 @@ sr_val_ly2sr(const struct lyd_node *node, sr_val_t *sr_val)
         switch (leaf->value_type) {
         case LY_TYPE_BINARY:
             sr_val->type = SR_BINARY_T;
-            sr_val->data.binary_val = strdup(leaf->value_str);
+            sr_val->data.binary_val = sr_val_str_store(leaf->value_str, arena);
             SR_CHECK_MEM_GOTO(!sr_val->data.binary_val, err_info, error);
             break;
         case LY_TYPE_BITS:
             sr_val->type = SR_BITS_T;
-            sr_val->data.bits_val = strdup(leaf->value_str);
+            sr_val->data.bits_val = sr_val_str_store(leaf->value_str, arena);
             SR_CHECK_MEM_GOTO(!sr_val->data.bits_val, err_info, error);
             break;
         case LY_TYPE_BOOL:
@@ -3785,17 +3900,17 @@ sr_val_ly2sr(const struct lyd_node *node, sr_val_t *sr_val)
             break;
         case LY_TYPE_ENUM:
             sr_val->type = SR_ENUM_T;
-            sr_val->data.enum_val = strdup(leaf->value_str);
+            sr_val->data.enum_val = sr_val_str_store(leaf->value_str, arena);
             SR_CHECK_MEM_GOTO(!sr_val->data.enum_val, err_info, error);
             break;
         case LY_TYPE_IDENT:
             sr_val->type = SR_IDENTITYREF_T;
-            sr_val->data.identityref_val = strdup(leaf->value_str);
+            sr_val->data.identityref_val = sr_val_str_store(leaf->value_str, arena);
             SR_CHECK_MEM_GOTO(!sr_val->data.identityref_val, err_info, error);
             break;
         case LY_TYPE_INST:
             sr_val->type = SR_INSTANCEID_T;
-            sr_val->data.instanceid_val = strdup(leaf->value_str);
+            sr_val->data.instanceid_val = sr_val_str_store(leaf->value_str, arena);
             SR_CHECK_MEM_GOTO(!sr_val->data.instanceid_val, err_info, error);
             break;
         case LY_TYPE_INT8:
@@ -3816,7 +3931,7 @@ sr_val_ly2sr(const struct lyd_node *node, sr_val_t *sr_val)
             break;
         case LY_TYPE_STRING:
             sr_val->type = SR_STRING_T;
-            sr_val->data.string_val = strdup(leaf->value_str);
+            sr_val->data.string_val = sr_val_str_store(leaf->value_str, arena);
             SR_CHECK_MEM_GOTO(!sr_val->data.string_val, err_info, error);
             break;
         case LY_TYPE_UINT8:
@@ -3855,40 +3970,15 @@ sr_val_ly2sr(const struct lyd_node *node, sr_val_t *sr_val)
         break;
     case LYS_ANYXML:
     case LYS_ANYDATA:
-        any = (struct lyd_node_anydata *)node;
-        ptr = NULL;
-
-        switch (any->value_type) {
-        case LYD_ANYDATA_CONSTSTRING:
-        case LYD_ANYDATA_JSON:
-        case LYD_ANYDATA_SXML:
-            if (any->value.str) {
-                ptr = strdup(any->value.str);
-                SR_CHECK_MEM_RET(!ptr, err_info);
-            }
-            break;
-        case LYD_ANYDATA_XML:
-            lyxml_print_mem(&ptr, any->value.xml, LYXML_PRINT_FORMAT);
-            break;
-        case LYD_ANYDATA_LYB:
-            /* try to convert into a data tree */
-            tree = lyd_parse_mem(node->schema->module->ctx, any->value.mem, LYD_LYB, LYD_OPT_DATA | LYD_OPT_STRICT, NULL);
-            if (!tree) {
-                sr_errinfo_new_ly(&err_info, node->schema->module->ctx);
-                sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, NULL, "Failed to convert LYB anyxml/anydata into XML.");
-                return err_info;
-            }
-            free(any->value.mem);
-            any->value_type = LYD_ANYDATA_DATATREE;
-            any->value.tree = tree;
-        /* fallthrough */
-        case LYD_ANYDATA_DATATREE:
-            lyd_print_mem(&ptr, any->value.tree, LYD_XML, LYP_FORMAT | LYP_WITHSIBLINGS);
-            break;
-        default:
-            SR_ERRINFO_INT(&err_info);
+        if ((err_info = sr_val_ly2sr_any(node, &ptr))) {
             return err_info;
         }
+        if (arena && ptr) {
+            /* move it into the arena */
+            str = sr_val_str_store(ptr, arena);
+            free(ptr);
+            ptr = str;
+        }
 
         if (node->schema->nodetype == LYS_ANYXML) {
             sr_val->type = SR_ANYXML_T;
@@ -3906,13 +3996,152 @@ sr_val_ly2sr(const struct lyd_node *node, sr_val_t *sr_val)
     /* origin */
     sr_edit_diff_get_origin(node, &origin, NULL);
     if (origin) {
-        sr_val->origin = strdup(origin);
+        sr_val->origin = sr_val_str_store(origin, arena);
     }
 
     return NULL;
 
 error:
-    free(sr_val->xpath);
+    if (!arena) {
+        free(sr_val->xpath);
+    }
+    return err_info;
+}
+
+sr_error_info_t *
+sr_val_ly2sr(const struct lyd_node *node, sr_val_t *sr_val)
+{
+    return _sr_val_ly2sr(node, NULL, NULL, sr_val);
+}
+
+/**
+ * @brief Learn the size of all the strings of a sysrepo value created from a libyang node, except its path.
+ *
+ * @param[in] node libyang node.
+ * @param[out] size Size of the strings including terminating zeroes.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_val_ly2sr_size(const struct lyd_node *node, size_t *size)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node_leaf_list *leaf;
+    const char *origin;
+    char *ptr;
+
+    *size = 0;
+
+    switch (node->schema->nodetype) {
+    case LYS_LEAF:
+    case LYS_LEAFLIST:
+        leaf = (const struct lyd_node_leaf_list *)node;
+        while (leaf->value_type == LY_TYPE_LEAFREF) {
+            leaf = (const struct lyd_node_leaf_list *)leaf->value.leafref;
+        }
+        switch (leaf->value_type) {
+        case LY_TYPE_BINARY:
+        case LY_TYPE_BITS:
+        case LY_TYPE_ENUM:
+        case LY_TYPE_IDENT:
+        case LY_TYPE_INST:
+        case LY_TYPE_STRING:
+            *size += strlen(leaf->value_str) + 1;
+            break;
+        default:
+            /* no string */
+            break;
+        }
+        break;
+    case LYS_ANYXML:
+    case LYS_ANYDATA:
+        if ((err_info = sr_val_ly2sr_any(node, &ptr))) {
+            return err_info;
+        }
+        if (ptr) {
+            *size += strlen(ptr) + 1;
+            free(ptr);
+        }
+        break;
+    default:
+        /* no string */
+        break;
+    }
+
+    sr_edit_diff_get_origin(node, &origin, NULL);
+    if (origin) {
+        *size += strlen(origin) + 1;
+    }
+
+    return NULL;
+}
+
+sr_error_info_t *
+sr_vals_ly2sr_arena(const struct lyd_node *parent, sr_val_t **vals, size_t *val_count)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *next, *elem;
+    char **paths = NULL, *arena;
+    size_t i, count = 0, size, arena_size = 0;
+
+    *vals = NULL;
+    *val_count = 0;
+
+    /* count the values */
+    LY_TREE_DFS_BEGIN(parent, next, elem) {
+        if (elem != parent) {
+            ++count;
+        }
+        LY_TREE_DFS_END(parent, next, elem);
+    }
+    if (!count) {
+        return NULL;
+    }
+
+    paths = calloc(count, sizeof *paths);
+    SR_CHECK_MEM_RET(!paths, err_info);
+
+    /* learn the size of all the strings */
+    i = 0;
+    LY_TREE_DFS_BEGIN(parent, next, elem) {
+        if (elem != parent) {
+            paths[i] = lyd_path(elem);
+            SR_CHECK_MEM_GOTO(!paths[i], err_info, cleanup);
+            if ((err_info = sr_val_ly2sr_size(elem, &size))) {
+                goto cleanup;
+            }
+            arena_size += strlen(paths[i]) + 1 + size;
+            ++i;
+        }
+        LY_TREE_DFS_END(parent, next, elem);
+    }
+
+    /* allocate the values and all their strings at once */
+    *vals = calloc(1, count * sizeof **vals + arena_size);
+    SR_CHECK_MEM_GOTO(!*vals, err_info, cleanup);
+    arena = (char *)(*vals + count);
+
+    /* fill the values */
+    i = 0;
+    LY_TREE_DFS_BEGIN(parent, next, elem) {
+        if (elem != parent) {
+            if ((err_info = _sr_val_ly2sr(elem, paths[i], &arena, &(*vals)[i]))) {
+                goto cleanup;
+            }
+            ++i;
+        }
+        LY_TREE_DFS_END(parent, next, elem);
+    }
+    *val_count = count;
+
+cleanup:
+    for (i = 0; i < count; ++i) {
+        free(paths[i]);
+    }
+    free(paths);
+    if (err_info) {
+        free(*vals);
+        *vals = NULL;
+    }
     return err_info;
 }
 
@@ -4095,68 +4324,270 @@ sr_lyd_dup(const struct lyd_node *src_parent, uint32_t depth, struct lyd_node *t
     return NULL;
 }
 
-struct lyd_node *
-sr_lyd_child(const struct lyd_node *node, int skip_keys)
+/**
+ * @brief Duplicate a selected subtree to the specified depth.
+ *
+ * @param[in] src Selected subtree root.
+ * @param[in] max_depth Maximum depth of the subtree, 0 for unlimited.
+ * @param[in] dup_opts Additional libyang duplicate options.
+ * @param[out] trg Duplicated subtree.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_lyd_dup_subtree(const struct lyd_node *src, uint32_t max_depth, int dup_opts, struct lyd_node **trg)
 {
-    struct lyd_node *child;
-    struct lys_node_list *slist;
-    int i;
-
-    if (!node) {
-        return NULL;
-    }
-
-    if (node->schema->nodetype & (LYS_LEAF | LYS_LEAFLIST | LYS_ANYDATA)) {
-        return NULL;
-    }
+    sr_error_info_t *err_info = NULL;
 
-    child = node->child;
+    dup_opts |= (max_depth ? 0 : LYD_DUP_OPT_RECURSIVE) | LYD_DUP_OPT_WITH_KEYS | LYD_DUP_OPT_WITH_WHEN;
+    *trg = lyd_dup(src, dup_opts);
+    SR_CHECK_LY_RET(!*trg, lyd_node_module(src)->ctx, err_info);
 
-    if (skip_keys && (node->schema->nodetype == LYS_LIST)) {
-        slist = (struct lys_node_list *)node->schema;
-        for (i = 0; child && (i < slist->keys_size); ++i) {
-            assert(child->schema == (struct lys_node *)slist->keys[i]);
-            child = child->next;
-        }
+    /* duplicate only to the specified depth */
+    if ((err_info = sr_lyd_dup(src, max_depth ? max_depth - 1 : 0, *trg))) {
+        lyd_free_withsiblings(*trg);
+        *trg = NULL;
+        return err_info;
     }
 
-    return child;
+    return NULL;
 }
 
 /**
- * @brief Copy any existing config NP containers, recursively.
+ * @brief Check whether a data node is a list key.
  *
- * @param[in,out] first First sibling, not needed if @p parent is set.
- * @param[in] parent Parent of any copied containers.
- * @param[in] src_sibling Any source sibling to look for existing NP containers.
- * @param[in] ly_mod Module, whose top-level containers to create, if @p first is set.
- * @return err_info, NULL on success.
+ * @param[in] node Data node to check.
+ * @return 0 if not, non-zero if it is.
  */
-static sr_error_info_t *
-sr_lyd_copy_config_np_cont_r(struct lyd_node **first, struct lyd_node *parent, const struct lyd_node *src_sibling,
-        const struct lys_module *ly_mod)
+static int
+sr_lyd_is_key(const struct lyd_node *node)
 {
-    sr_error_info_t *err_info = NULL;
-    const struct lyd_node *src, *src_top;
-    struct lyd_node *node;
-
-    assert(ly_mod);
+    return node->parent && (node->schema->nodetype == LYS_LEAF) && lys_is_key((struct lys_node_leaf *)node->schema, NULL);
+}
 
-    if (!src_sibling) {
-        /* nothing to do */
-        return NULL;
-    }
+/**
+ * @brief Check whether a sibling precedes another one. Both are traversed at once so that it takes
+ * only as long as the distance between them.
+ *
+ * @param[in] first Sibling expected first.
+ * @param[in] second Sibling expected second.
+ * @return 0 if @p first does not precede @p second, non-zero if it does.
+ */
+static int
+sr_lyd_sibling_precedes(const struct lyd_node *first, const struct lyd_node *second)
+{
+    const struct lyd_node *iter1 = first, *iter2 = second;
 
-    for (src = src_sibling; src; src = src->next) {
-        for (src_top = src; src_top->parent; src_top = src_top->parent) {}
-        if (lyd_node_module(src_top) != ly_mod) {
-            /* these data do not belong to this module */
-            continue;
+    while (iter1 || iter2) {
+        if (iter1 && ((iter1 = iter1->next) == second)) {
+            return 1;
         }
-
-        if ((src->schema->nodetype != LYS_CONTAINER) || ((struct lys_node_container *)src->schema)->presence) {
-            /* not an NP container */
-            continue;
+        if (iter2 && ((iter2 = iter2->next) == first)) {
+            return 0;
+        }
+    }
+
+    /* not siblings */
+    return 0;
+}
+
+sr_error_info_t *
+sr_lyd_dup_subtrees(const struct ly_set *subtrees, uint32_t max_depth, struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *src, **anc = NULL;
+    struct lyd_node *node, *parent;
+    struct sr_lyd_dup_parent_s {
+        const struct lyd_node *src;
+        struct lyd_node *trg;
+        int selected;
+    } *stack = NULL;
+    uint32_t i, j, anc_count, anc_size = 0, stack_count = 0, stack_size = 0;
+    int is_key;
+    void *mem;
+
+    *data = NULL;
+
+    for (i = 0; i < subtrees->number; ++i) {
+        src = subtrees->set.d[i];
+        is_key = sr_lyd_is_key(src);
+
+        /* learn all the ancestors, from the top-level one to the subtree root */
+        anc_count = 0;
+        for (node = (struct lyd_node *)src; node; node = node->parent) {
+            ++anc_count;
+        }
+        if (anc_count > anc_size) {
+            mem = realloc(anc, anc_count * sizeof *anc);
+            SR_CHECK_MEM_GOTO(!mem, err_info, error);
+            anc = mem;
+            anc_size = anc_count;
+        }
+        j = anc_count;
+        for (node = (struct lyd_node *)src; node; node = node->parent) {
+            anc[--j] = node;
+        }
+
+        /* find the ancestors duplicated for the previous subtree, in the document order once a parent is left,
+         * it is never needed again */
+        for (j = 0; (j < stack_count) && (j < anc_count) && (stack[j].src == anc[j]); ++j) {
+            if (stack[j].selected) {
+                break;
+            }
+        }
+
+        if ((j < stack_count) && (j < anc_count) && (stack[j].src == anc[j])) {
+            /* an ancestor was selected and duplicated, including this subtree */
+            if (!max_depth) {
+                continue;
+            }
+            goto merge;
+        } else if (j == anc_count) {
+            /* this node was already duplicated as a parent (unexpected order) */
+            goto merge;
+        } else if ((j < stack_count) && !sr_lyd_sibling_precedes(stack[j].src, anc[j])) {
+            /* the set is not in the document order, the parents may have already been duplicated */
+            goto merge;
+        } else if ((j == anc_count - 1) && is_key) {
+            /* list key, already duplicated with its list */
+            continue;
+        }
+
+        /* forget the parents not shared with this subtree */
+        stack_count = j;
+        if (anc_count > stack_size) {
+            mem = realloc(stack, anc_count * sizeof *stack);
+            SR_CHECK_MEM_GOTO(!mem, err_info, error);
+            stack = mem;
+            stack_size = anc_count;
+        }
+
+        /* duplicate all the missing parents and then the subtree itself, a key is duplicated with its list */
+        for ( ; j < anc_count - (is_key ? 1 : 0); ++j) {
+            if (j < anc_count - 1) {
+                node = lyd_dup(anc[j], LYD_DUP_OPT_WITH_KEYS | LYD_DUP_OPT_WITH_WHEN);
+                SR_CHECK_LY_GOTO(!node, lyd_node_module(src)->ctx, err_info, error);
+            } else if ((err_info = sr_lyd_dup_subtree(src, max_depth, 0, &node))) {
+                goto error;
+            }
+
+            /* connect it */
+            if (!j) {
+                if (!*data) {
+                    *data = node;
+                } else if (lyd_insert_after((*data)->prev, node)) {
+                    lyd_free_withsiblings(node);
+                    sr_errinfo_new_ly(&err_info, lyd_node_module(src)->ctx);
+                    goto error;
+                }
+            } else if (lyd_insert(stack[j - 1].trg, node)) {
+                lyd_free_withsiblings(node);
+                sr_errinfo_new_ly(&err_info, lyd_node_module(src)->ctx);
+                goto error;
+            }
+
+            stack[j].src = anc[j];
+            stack[j].trg = node;
+            stack[j].selected = (j == anc_count - 1) ? 1 : 0;
+            ++stack_count;
+        }
+        continue;
+
+merge:
+        /* overlapping subtrees, duplicate with parents and merge into the result */
+        if (is_key) {
+            /* the list with all its keys */
+            node = lyd_dup(src->parent, LYD_DUP_OPT_WITH_PARENTS | LYD_DUP_OPT_WITH_KEYS | LYD_DUP_OPT_WITH_WHEN);
+            SR_CHECK_LY_GOTO(!node, lyd_node_module(src)->ctx, err_info, error);
+        } else if ((err_info = sr_lyd_dup_subtree(src, max_depth, LYD_DUP_OPT_WITH_PARENTS, &node))) {
+            goto error;
+        }
+        parent = node;
+        while (parent->parent) {
+            parent = parent->parent;
+        }
+        if (!*data) {
+            *data = parent;
+        } else if (lyd_merge(*data, parent, LYD_OPT_DESTRUCT | LYD_OPT_EXPLICIT)) {
+            lyd_free_withsiblings(parent);
+            sr_errinfo_new_ly(&err_info, lyd_node_module(src)->ctx);
+            goto error;
+        }
+    }
+
+    free(anc);
+    free(stack);
+    return NULL;
+
+error:
+    free(anc);
+    free(stack);
+    lyd_free_withsiblings(*data);
+    *data = NULL;
+    return err_info;
+}
+
+struct lyd_node *
+sr_lyd_child(const struct lyd_node *node, int skip_keys)
+{
+    struct lyd_node *child;
+    struct lys_node_list *slist;
+    int i;
+
+    if (!node) {
+        return NULL;
+    }
+
+    if (node->schema->nodetype & (LYS_LEAF | LYS_LEAFLIST | LYS_ANYDATA)) {
+        return NULL;
+    }
+
+    child = node->child;
+
+    if (skip_keys && (node->schema->nodetype == LYS_LIST)) {
+        slist = (struct lys_node_list *)node->schema;
+        for (i = 0; child && (i < slist->keys_size); ++i) {
+            assert(child->schema == (struct lys_node *)slist->keys[i]);
+            child = child->next;
+        }
+    }
+
+    return child;
+}
+
+/**
+ * @brief Copy any existing config NP containers, recursively.
+ *
+ * @param[in,out] first First sibling, not needed if @p parent is set.
+ * @param[in] parent Parent of any copied containers.
+ * @param[in] src_sibling Any source sibling to look for existing NP containers.
+ * @param[in] ly_mod Module, whose top-level containers to create, if @p first is set.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_lyd_copy_config_np_cont_r(struct lyd_node **first, struct lyd_node *parent, const struct lyd_node *src_sibling,
+        const struct lys_module *ly_mod)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *src, *src_top;
+    struct lyd_node *node;
+
+    assert(ly_mod);
+
+    if (!src_sibling) {
+        /* nothing to do */
+        return NULL;
+    }
+
+    for (src = src_sibling; src; src = src->next) {
+        for (src_top = src; src_top->parent; src_top = src_top->parent) {}
+        if (lyd_node_module(src_top) != ly_mod) {
+            /* these data do not belong to this module */
+            continue;
+        }
+
+        if ((src->schema->nodetype != LYS_CONTAINER) || ((struct lys_node_container *)src->schema)->presence) {
+            /* not an NP container */
+            continue;
         }
 
         lyd_find_sibling_val(parent ? parent->child : *first, src->schema, NULL, &node);
@@ -5078,6 +5509,63 @@ sr_xpath_len_no_predicates(const char *xpath)
     return len;
 }
 
+uint32_t
+sr_xpath_common_parent(const char *xpath1, const char *xpath2, size_t *len, uint32_t *depth1)
+{
+    uint32_t depth = 0;
+    int predicate = 0, same = 1;
+    const char *ptr;
+    char quoted = 0;
+
+    *len = 0;
+    *depth1 = 0;
+
+    for (ptr = xpath1; ptr[0]; ++ptr) {
+        if (quoted) {
+            if (ptr[0] == quoted) {
+                quoted = 0;
+            }
+        } else {
+            switch (ptr[0]) {
+            case '[':
+                ++predicate;
+                break;
+            case ']':
+                --predicate;
+                break;
+            case '\'':
+            case '\"':
+                quoted = ptr[0];
+                break;
+            case '/':
+                if (!predicate) {
+                    if (same && (ptr != xpath1) && (xpath2[ptr - xpath1] == '/')) {
+                        /* both XPaths continue with a child of the same node */
+                        *len = ptr - xpath1;
+                        depth = *depth1;
+                    }
+                    ++(*depth1);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (same && (ptr[0] != xpath2[ptr - xpath1])) {
+            same = 0;
+        }
+    }
+
+    if (same && !predicate && !quoted && (xpath2[ptr - xpath1] == '/')) {
+        /* the second XPath continues with a child of the first node */
+        *len = ptr - xpath1;
+        depth = *depth1;
+    }
+
+    return depth;
+}
+
 sr_error_info_t *
 sr_ly_find_last_parent(struct lyd_node **parent, int nodetype)
 {
@@ -5161,7 +5649,7 @@ sr_error_info_t *
 sr_module_file_data_append(const struct lys_module *ly_mod, sr_datastore_t ds, struct lyd_node **data)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *mod_data = NULL;
+    struct lyd_node *mod_data = NULL, *cand_diff = NULL;
     char *path = NULL;
     int fd = -1, flags;
 
@@ -5198,7 +5686,8 @@ retry_open:
         flags = LYD_OPT_EDIT | LYD_OPT_STRICT | LYD_OPT_NOEXTDEPS;
         break;
     case SR_DS_CANDIDATE:
-        flags = LYD_OPT_CONFIG | LYD_OPT_STRICT | LYD_OPT_NOEXTDEPS;
+        /* candidate is stored as a diff on running */
+        flags = LYD_OPT_EDIT | LYD_OPT_STRICT | LYD_OPT_NOEXTDEPS;
         break;
     case SR_DS_STARTUP:
     case SR_DS_RUNNING:
@@ -5211,6 +5700,29 @@ retry_open:
         goto error;
     }
 
+    if (ds == SR_DS_CANDIDATE) {
+        /* load running data */
+        cand_diff = mod_data;
+        mod_data = NULL;
+        if ((err_info = sr_module_file_data_append(ly_mod, SR_DS_RUNNING, &mod_data))) {
+            goto error;
+        }
+
+        if (cand_diff) {
+            /* add any missing NP containers so that the diff can be properly applied */
+            if ((err_info = sr_lyd_create_sibling_np_cont_r(&mod_data, NULL, ly_mod, NULL))) {
+                goto error;
+            }
+
+            /* running data may have changed since the diff was created, keep both changes */
+            if ((err_info = sr_diff_mod_rebase(cand_diff, ly_mod, &mod_data))) {
+                goto error;
+            }
+            lyd_free_withsiblings(cand_diff);
+            cand_diff = NULL;
+        }
+    }
+
     if (*data && mod_data) {
         sr_ly_link(*data, mod_data);
     } else if (mod_data) {
@@ -5226,107 +5738,1323 @@ error:
     }
     free(path);
     lyd_free_withsiblings(mod_data);
+    lyd_free_withsiblings(cand_diff);
     return err_info;
 }
 
-sr_error_info_t *
-sr_module_file_oper_data_load(struct sr_mod_info_mod_s *mod, struct lyd_node **diff)
+/** magic of top-level list instance index files */
+#define SR_FILE_IDX_MAGIC "SRI1"
+
+/**
+ * @brief Header of a top-level list instance index file. It is followed by an entry for each indexed instance
+ * consisting of the key length (uint32_t), LYB data length (uint32_t), the key, and the LYB data of the instance.
+ */
+struct sr_file_idx_hdr_s {
+    char magic[4];              /**< Index file magic, SR_FILE_IDX_MAGIC. */
+    uint32_t count;             /**< Number of indexed instances. */
+    uint64_t data_ino;          /**< Inode of the data file the index was stored for. */
+    uint64_t data_size;         /**< Size of the data file the index was stored for. */
+    int64_t data_mtime_sec;     /**< Modification time (seconds) of the data file the index was stored for. */
+    int64_t data_mtime_nsec;    /**< Modification time (nanoseconds) of the data file the index was stored for. */
+};
+
+/**
+ * @brief Get path of the top-level list instance index of a data file.
+ *
+ * @param[in] path Path of the data file.
+ * @param[out] idx_path Path of the index file.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_file_idx_path(const char *path, char **idx_path)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *root, *next, *elem;
-    struct lyd_attr *attr;
-    sr_cid_t dead_cid = 0;
 
-    assert(!*diff);
-
-    /* load the operational data (diff) */
-    if ((err_info = sr_module_file_data_append(mod->ly_mod, SR_DS_OPERATIONAL, diff))) {
-        return err_info;
+    if (asprintf(idx_path, "%s%s", path, SR_FILE_INDEX_SUFFIX) == -1) {
+        *idx_path = NULL;
+        SR_ERRINFO_MEM(&err_info);
     }
+    return err_info;
+}
+
+/**
+ * @brief Check that a top-level list instance index belongs to the current data file.
+ *
+ * @param[in] hdr Index header.
+ * @param[in] st Data file stat.
+ * @return 0 if not, non-zero if it does.
+ */
+static int
+sr_module_file_idx_hdr_match(const struct sr_file_idx_hdr_s *hdr, const struct stat *st)
+{
+    return !memcmp(hdr->magic, SR_FILE_IDX_MAGIC, sizeof hdr->magic) && (hdr->data_ino == (uint64_t)st->st_ino) &&
+            (hdr->data_size == (uint64_t)st->st_size) && (hdr->data_mtime_sec == st->st_mtim.tv_sec) &&
+            (hdr->data_mtime_nsec == st->st_mtim.tv_nsec);
+}
+
+/**
+ * @brief Check whether a top-level data node is indexed.
+ *
+ * @param[in] node Top-level data node.
+ * @return 0 if not, non-zero if it is.
+ */
+static int
+sr_module_file_idx_is_indexed(const struct lyd_node *node)
+{
+    return (node->schema->nodetype == LYS_LIST) && ((struct lys_node_list *)node->schema)->keys_size;
+}
 
-trim_retry:
-    if (dead_cid) {
-        /* this connection is dead, remove its stored diff */
-        SR_LOG_INF("Recovering stored operational data of CID %" PRIu32 ".", dead_cid);
-        if ((err_info = sr_diff_del_conn(diff, dead_cid))) {
+/**
+ * @brief Get index key of a top-level list instance. It is the list name followed by all the key values,
+ * each of them terminated by zero.
+ *
+ * @param[in] node Top-level list instance.
+ * @param[out] key Index key.
+ * @param[out] key_len Length of @p key.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_file_idx_key(const struct lyd_node *node, char **key, uint32_t *key_len)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lys_node_list *slist = (struct lys_node_list *)node->schema;
+    const struct lyd_node *child;
+    const char *str;
+    uint32_t i, len;
+
+    /* learn the length, keys are always the first children */
+    len = strlen(slist->name) + 1;
+    for (i = 0, child = node->child; i < slist->keys_size; ++i, child = child->next) {
+        if (!child || (child->schema != (struct lys_node *)slist->keys[i])) {
+            SR_ERRINFO_INT(&err_info);
             return err_info;
         }
+        len += strlen(((struct lyd_node_leaf_list *)child)->value_str) + 1;
     }
 
-    /* find diff belonging to a dead connection, if any */
-    LY_TREE_FOR(*diff, root) {
-        LY_TREE_DFS_BEGIN(root, next, elem) {
-            LY_TREE_FOR(elem->attr, attr) {
-                if (!strcmp(attr->annotation->module->name, SR_YANG_MOD) && !strcmp(attr->name, "cid")) {
-                    if (!sr_conn_is_alive(attr->value.uint32)) {
-                        dead_cid = attr->value.uint32;
+    *key = malloc(len);
+    SR_CHECK_MEM_RET(!*key, err_info);
+    *key_len = len;
 
-                        /* retry the whole check until there are no dead connections */
-                        goto trim_retry;
-                    }
-                    break;
-                }
-            }
-            LY_TREE_DFS_END(root, next, elem);
-        }
+    /* fill the key */
+    len = strlen(slist->name) + 1;
+    memcpy(*key, slist->name, len);
+    for (i = 0, child = node->child; i < slist->keys_size; ++i, child = child->next) {
+        str = ((struct lyd_node_leaf_list *)child)->value_str;
+        memcpy(*key + len, str, strlen(str) + 1);
+        len += strlen(str) + 1;
     }
 
-    return err_info;
+    return NULL;
 }
 
-sr_error_info_t *
-sr_module_file_data_set(const char *mod_name, sr_datastore_t ds, struct lyd_node *mod_data, int create_flags,
-        mode_t file_mode)
+/**
+ * @brief Get index key of the top-level list instance an XPath selects all its data from.
+ *
+ * @param[in] ly_mod Module of the data.
+ * @param[in] xpath XPath to examine.
+ * @param[out] key Index key, NULL if the XPath may select any other data of the module.
+ * @param[out] key_len Length of @p key.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_file_idx_xpath_key(const struct lys_module *ly_mod, const char *xpath, char **key, uint32_t *key_len)
 {
     sr_error_info_t *err_info = NULL;
-    char *path = NULL, *bck_path = NULL;
-    int fd = -1, backup = 0;
+    const char *ptr, *first_end = NULL;
+    char quot = 0, *first_path;
+    uint32_t depth = 0;
+    struct lyd_node *node;
+    int ly_log_opts;
 
-    assert(file_mode);
+    *key = NULL;
 
-    /* learn path */
-    switch (ds) {
-    case SR_DS_STARTUP:
-        err_info = sr_path_startup_file(mod_name, &path);
-        break;
-    case SR_DS_RUNNING:
-    case SR_DS_CANDIDATE:
-    case SR_DS_OPERATIONAL:
-        err_info = sr_path_ds_shm(mod_name, ds, &path);
-        break;
-    }
-    if (err_info) {
-        goto cleanup;
+    /* it must be an absolute path starting with a child of the root */
+    if ((xpath[0] != '/') || (xpath[1] == '/')) {
+        return NULL;
     }
 
-    if ((ds == SR_DS_STARTUP) && (!(create_flags & O_CREAT) && !(create_flags & O_EXCL))) {
-        /* generate the backup path */
-        if (asprintf(&bck_path, "%s%s", path, SR_FILE_BACKUP_SUFFIX) == -1) {
-            SR_ERRINFO_MEM(&err_info);
-            goto cleanup;
-        }
-
-        /* back up any existing file */
-        if ((err_info = sr_cp_path(bck_path, path, file_mode))) {
-            goto cleanup;
+    /* only simple descendant paths of the first node are allowed */
+    for (ptr = xpath + 1; *ptr; ++ptr) {
+        if (quot) {
+            if (*ptr == quot) {
+                quot = 0;
+            }
+            continue;
         }
 
-        backup = 1;
-    }
-
-    /* open the file */
-    if ((fd = sr_open(path, O_WRONLY | create_flags, file_mode)) == -1) {
-        SR_ERRINFO_OPEN(&err_info, path);
-        goto cleanup;
-    }
-
-    /* print data */
-    if (lyd_print_fd(fd, mod_data, LYD_LYB, LYP_WITHSIBLINGS)) {
-        sr_errinfo_new_ly(&err_info, lyd_node_module(mod_data)->ctx);
-        sr_errinfo_new(&err_info, SR_ERR_INTERNAL, NULL, "Failed to store data into \"%s\".", path);
-        goto cleanup;
-    }
-
+        switch (*ptr) {
+        case '\'':
+        case '"':
+            if (!depth) {
+                return NULL;
+            }
+            quot = *ptr;
+            break;
+        case '[':
+            ++depth;
+            break;
+        case ']':
+            if (!depth) {
+                return NULL;
+            }
+            --depth;
+            break;
+        case '/':
+            if (depth) {
+                /* path in a predicate can reference any data */
+                return NULL;
+            }
+            if (!first_end) {
+                first_end = ptr;
+            }
+            break;
+        case '.':
+            if (ptr[1] == '.') {
+                /* parent can be outside of the list instance */
+                return NULL;
+            }
+            break;
+        case ':':
+            if (ptr[1] == ':') {
+                /* an axis can select data outside of the list instance */
+                return NULL;
+            }
+            break;
+        case '|':
+        case '(':
+        case '$':
+            /* union, function, or variable */
+            return NULL;
+        default:
+            if (!depth && !isalnum((unsigned char)*ptr) && !strchr("_-:*", *ptr)) {
+                /* an operator outside of predicates */
+                return NULL;
+            }
+            break;
+        }
+    }
+    if (quot || depth) {
+        return NULL;
+    }
+    if (!first_end) {
+        first_end = ptr;
+    }
+    if (first_end[-1] != ']') {
+        /* no predicates */
+        return NULL;
+    }
+
+    first_path = strndup(xpath, first_end - xpath);
+    SR_CHECK_MEM_RET(!first_path, err_info);
+
+    /* create the list instance to learn canonical values of its keys, fails if the predicates are not exactly
+     * all the list keys */
+    ly_log_opts = ly_log_options(0);
+    node = lyd_new_path(NULL, ly_mod->ctx, first_path, NULL, 0, 0);
+    ly_log_options(ly_log_opts);
+    free(first_path);
+    if (!node) {
+        ly_err_clean(ly_mod->ctx, NULL);
+        return NULL;
+    }
+
+    if ((lyd_node_module(node) == ly_mod) && sr_module_file_idx_is_indexed(node)) {
+        err_info = sr_module_file_idx_key(node, key, key_len);
+    }
+    lyd_free(node);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_module_file_idx_del(const char *path)
+{
+    sr_error_info_t *err_info = NULL;
+    char *idx_path;
+
+    if ((err_info = sr_module_file_idx_path(path, &idx_path))) {
+        return err_info;
+    }
+
+    if ((unlink(idx_path) == -1) && (errno != ENOENT)) {
+        SR_ERRINFO_SYSERRNO(&err_info, "unlink");
+    }
+    free(idx_path);
+    return err_info;
+}
+
+/**
+ * @brief Append bytes to a growing buffer.
+ *
+ * @param[in,out] buf Buffer to append to.
+ * @param[in,out] size Allocated size of @p buf.
+ * @param[in,out] used Used size of @p buf.
+ * @param[in] data Data to append.
+ * @param[in] len Length of @p data.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_file_idx_buf_add(char **buf, size_t *size, size_t *used, const void *data, size_t len)
+{
+    sr_error_info_t *err_info = NULL;
+
+    if (*used + len > *size) {
+        if (!*size) {
+            *size = 4096;
+        }
+        while (*used + len > *size) {
+            *size *= 2;
+        }
+        *buf = sr_realloc(*buf, *size);
+        SR_CHECK_MEM_RET(!*buf, err_info);
+    }
+
+    memcpy(*buf + *used, data, len);
+    *used += len;
+    return NULL;
+}
+
+/**
+ * @brief Read the top-level list instance index of a data file, if it belongs to the current data file.
+ *
+ * @param[in] path Path of the data file.
+ * @param[out] idx Index file content, NULL if there is no valid index.
+ * @param[out] idx_len Length of @p idx.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_file_idx_read(const char *path, char **idx, size_t *idx_len)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_file_idx_hdr_s hdr;
+    struct stat st, idx_st;
+    char *idx_path = NULL;
+    size_t done = 0;
+    ssize_t ret;
+    int fd = -1;
+
+    *idx = NULL;
+    *idx_len = 0;
+
+    if ((err_info = sr_module_file_idx_path(path, &idx_path))) {
+        goto cleanup;
+    }
+    if ((fd = sr_open(idx_path, O_RDONLY, 0)) == -1) {
+        if (errno != ENOENT) {
+            SR_ERRINFO_OPEN(&err_info, idx_path);
+        }
+        goto cleanup;
+    }
+    if (fstat(fd, &idx_st) == -1) {
+        SR_ERRINFO_SYSERRNO(&err_info, "fstat");
+        goto cleanup;
+    }
+    if ((size_t)idx_st.st_size < sizeof hdr) {
+        goto cleanup;
+    }
+
+    /* read it whole */
+    *idx = malloc(idx_st.st_size);
+    SR_CHECK_MEM_GOTO(!*idx, err_info, cleanup);
+    while (done < (size_t)idx_st.st_size) {
+        ret = read(fd, *idx + done, idx_st.st_size - done);
+        if (!ret) {
+            /* truncated */
+            goto cleanup;
+        } else if (ret > 0) {
+            done += ret;
+        } else if (errno != EINTR) {
+            SR_ERRINFO_SYSERRNO(&err_info, "read");
+            goto cleanup;
+        }
+    }
+
+    /* the index must belong to the current data file */
+    if (stat(path, &st) == -1) {
+        if (errno != ENOENT) {
+            SR_ERRINFO_SYSERRNO(&err_info, "stat");
+        }
+        goto cleanup;
+    }
+    memcpy(&hdr, *idx, sizeof hdr);
+    if (sr_module_file_idx_hdr_match(&hdr, &st)) {
+        *idx_len = done;
+    }
+
+cleanup:
+    if (!*idx_len) {
+        free(*idx);
+        *idx = NULL;
+    }
+    if (fd > -1) {
+        close(fd);
+    }
+    free(idx_path);
+    return err_info;
+}
+
+/**
+ * @brief Index key of a changed top-level list instance.
+ */
+struct sr_file_idx_key_s {
+    char *key;                  /**< Index key. */
+    uint32_t len;               /**< Length of the key. */
+};
+
+/**
+ * @brief Comparator for qsort and bsearch of index keys.
+ *
+ * @param[in] ptr1 First index key.
+ * @param[in] ptr2 Second index key.
+ * @return Keys comparison result.
+ */
+static int
+sr_module_file_idx_key_cmp(const void *ptr1, const void *ptr2)
+{
+    const struct sr_file_idx_key_s *key1 = ptr1, *key2 = ptr2;
+
+    if (key1->len != key2->len) {
+        return (key1->len < key2->len) ? -1 : 1;
+    }
+    return memcmp(key1->key, key2->key, key1->len);
+}
+
+/**
+ * @brief Collect sorted index keys of all the top-level list instances changed in a diff.
+ *
+ * @param[in] ly_mod Module of the data.
+ * @param[in] diff Diff of the changes.
+ * @param[out] keys Sorted index keys.
+ * @param[out] key_count Count of @p keys.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_file_idx_diff_keys(const struct lys_module *ly_mod, const struct lyd_node *diff,
+        struct sr_file_idx_key_s **keys, uint32_t *key_count)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *node;
+    void *mem;
+
+    *keys = NULL;
+    *key_count = 0;
+
+    LY_TREE_FOR(diff, node) {
+        if ((lyd_node_module(node) != ly_mod) || !sr_module_file_idx_is_indexed(node)) {
+            continue;
+        }
+
+        mem = realloc(*keys, (*key_count + 1) * sizeof **keys);
+        SR_CHECK_MEM_RET(!mem, err_info);
+        *keys = mem;
+        if ((err_info = sr_module_file_idx_key(node, &(*keys)[*key_count].key, &(*keys)[*key_count].len))) {
+            return err_info;
+        }
+        ++(*key_count);
+    }
+
+    if (*key_count > 1) {
+        qsort(*keys, *key_count, sizeof **keys, sr_module_file_idx_key_cmp);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Parse an index entry.
+ *
+ * @param[in] ptr Start of the entry.
+ * @param[in] end End of the index.
+ * @param[out] key Index key of the entry.
+ * @param[out] entry_len Length of the whole entry.
+ * @return 0 if the entry is invalid, non-zero if it was parsed.
+ */
+static int
+sr_module_file_idx_entry(const char *ptr, const char *end, struct sr_file_idx_key_s *key, size_t *entry_len)
+{
+    uint32_t lyb_len;
+
+    if ((size_t)(end - ptr) < sizeof key->len + sizeof lyb_len) {
+        return 0;
+    }
+    memcpy(&key->len, ptr, sizeof key->len);
+    memcpy(&lyb_len, ptr + sizeof key->len, sizeof lyb_len);
+    *entry_len = sizeof key->len + sizeof lyb_len + (size_t)key->len + lyb_len;
+    if ((size_t)(end - ptr) < *entry_len) {
+        return 0;
+    }
+    key->key = (char *)ptr + sizeof key->len + sizeof lyb_len;
+    return 1;
+}
+
+/**
+ * @brief Store top-level list instance index of a data file, if there are enough instances.
+ *
+ * If the previous index and the diff of the stored changes are known, entries of the instances not changed
+ * are copied from the previous index and only the changed instances are printed.
+ *
+ * @param[in] path Path of the data file with @p mod_data already stored.
+ * @param[in] mod_data Stored module data.
+ * @param[in] diff Optional diff of the changes between the previous and the stored data.
+ * @param[in] old_idx Optional previous index, used only with @p diff.
+ * @param[in] old_idx_len Length of @p old_idx.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_file_idx_write(const char *path, const struct lyd_node *mod_data, const struct lyd_node *diff,
+        const char *old_idx, size_t old_idx_len)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_file_idx_hdr_s hdr;
+    struct sr_file_idx_key_s *chg_keys = NULL, node_key = {0}, old_key;
+    const struct lyd_node *node;
+    const char *old_ptr = NULL, *old_end = NULL;
+    char *idx_path = NULL, *tmp_path = NULL, *buf = NULL, *lyb = NULL;
+    size_t size = 0, used = 0, written, old_entry_len;
+    uint32_t count = 0, chg_count = 0, i, lyb_len;
+    ssize_t ret;
+    struct stat st;
+    int fd = -1, changed;
+
+    /* count the indexed instances */
+    LY_TREE_FOR(mod_data, node) {
+        if (sr_module_file_idx_is_indexed(node)) {
+            ++count;
+        }
+    }
+    if (count < SR_FILE_INDEX_MIN_INST) {
+        /* not worth it */
+        return NULL;
+    }
+
+    if (diff && old_idx) {
+        /* only the changed instances need to be printed */
+        if ((err_info = sr_module_file_idx_diff_keys(lyd_node_module(mod_data), diff, &chg_keys, &chg_count))) {
+            goto cleanup;
+        }
+        old_ptr = old_idx + sizeof hdr;
+        old_end = old_idx + old_idx_len;
+    }
+
+    /* learn the data file the index is for */
+    if (stat(path, &st) == -1) {
+        SR_ERRINFO_SYSERRNO(&err_info, "stat");
+        goto cleanup;
+    }
+
+    /* header */
+    memset(&hdr, 0, sizeof hdr);
+    memcpy(hdr.magic, SR_FILE_IDX_MAGIC, sizeof hdr.magic);
+    hdr.count = count;
+    hdr.data_ino = st.st_ino;
+    hdr.data_size = st.st_size;
+    hdr.data_mtime_sec = st.st_mtim.tv_sec;
+    hdr.data_mtime_nsec = st.st_mtim.tv_nsec;
+    if ((err_info = sr_module_file_idx_buf_add(&buf, &size, &used, &hdr, sizeof hdr))) {
+        goto cleanup;
+    }
+
+    /* entries */
+    LY_TREE_FOR(mod_data, node) {
+        if (!sr_module_file_idx_is_indexed(node)) {
+            continue;
+        }
+
+        if ((err_info = sr_module_file_idx_key(node, &node_key.key, &node_key.len))) {
+            goto cleanup;
+        }
+
+        if (old_ptr) {
+            /* skip previous entries of changed instances, unchanged instances keep their relative order */
+            while (sr_module_file_idx_entry(old_ptr, old_end, &old_key, &old_entry_len) && chg_count &&
+                    bsearch(&old_key, chg_keys, chg_count, sizeof *chg_keys, sr_module_file_idx_key_cmp)) {
+                old_ptr += old_entry_len;
+            }
+
+            changed = chg_count &&
+                    bsearch(&node_key, chg_keys, chg_count, sizeof *chg_keys, sr_module_file_idx_key_cmp);
+            if (!changed && sr_module_file_idx_entry(old_ptr, old_end, &old_key, &old_entry_len) &&
+                    !sr_module_file_idx_key_cmp(&old_key, &node_key)) {
+                /* copy the previous entry */
+                if ((err_info = sr_module_file_idx_buf_add(&buf, &size, &used, old_ptr, old_entry_len))) {
+                    goto cleanup;
+                }
+                old_ptr += old_entry_len;
+
+                free(node_key.key);
+                node_key.key = NULL;
+                continue;
+            }
+        }
+
+        if (lyd_print_mem(&lyb, node, LYD_LYB, 0)) {
+            sr_errinfo_new_ly(&err_info, lyd_node_module(node)->ctx);
+            goto cleanup;
+        }
+        lyb_len = lyd_lyb_data_length(lyb);
+
+        if ((err_info = sr_module_file_idx_buf_add(&buf, &size, &used, &node_key.len, sizeof node_key.len))) {
+            goto cleanup;
+        }
+        if ((err_info = sr_module_file_idx_buf_add(&buf, &size, &used, &lyb_len, sizeof lyb_len))) {
+            goto cleanup;
+        }
+        if ((err_info = sr_module_file_idx_buf_add(&buf, &size, &used, node_key.key, node_key.len))) {
+            goto cleanup;
+        }
+        if ((err_info = sr_module_file_idx_buf_add(&buf, &size, &used, lyb, lyb_len))) {
+            goto cleanup;
+        }
+
+        free(node_key.key);
+        node_key.key = NULL;
+        free(lyb);
+        lyb = NULL;
+    }
+
+    /* write it into a temporary file */
+    if ((err_info = sr_module_file_idx_path(path, &idx_path))) {
+        goto cleanup;
+    }
+    if (asprintf(&tmp_path, "%s%s", idx_path, SR_FILE_TEMP_SUFFIX) == -1) {
+        tmp_path = NULL;
+        SR_ERRINFO_MEM(&err_info);
+        goto cleanup;
+    }
+    if ((fd = sr_open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, st.st_mode & 00777)) == -1) {
+        SR_ERRINFO_OPEN(&err_info, tmp_path);
+        goto cleanup;
+    }
+    written = 0;
+    while (written < used) {
+        ret = write(fd, buf + written, used - written);
+        if (ret >= 0) {
+            written += ret;
+        } else if (errno != EINTR) {
+            SR_ERRINFO_SYSERRNO(&err_info, "write");
+            goto cleanup;
+        }
+    }
+
+    /* replace the previous index, if any */
+    if (rename(tmp_path, idx_path) == -1) {
+        SR_ERRINFO_SYSERRNO(&err_info, "rename");
+        goto cleanup;
+    }
+
+cleanup:
+    if (fd > -1) {
+        close(fd);
+        if (err_info) {
+            unlink(tmp_path);
+        }
+    }
+    for (i = 0; i < chg_count; ++i) {
+        free(chg_keys[i].key);
+    }
+    free(chg_keys);
+    free(idx_path);
+    free(tmp_path);
+    free(buf);
+    free(node_key.key);
+    free(lyb);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_module_file_data_append_pruned(const struct lys_module *ly_mod, sr_datastore_t ds, const char *xpath,
+        struct lyd_node **data, int *pruned)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_file_idx_hdr_s hdr;
+    struct lyd_node *mod_data = NULL;
+    struct stat st, idx_st;
+    char *key = NULL, *path = NULL, *idx_path = NULL, *addr = MAP_FAILED;
+    const char *ptr, *end;
+    uint32_t key_len, ent_key_len, ent_lyb_len, i;
+    int fd = -1;
+
+    *pruned = 0;
+
+    if ((ds != SR_DS_RUNNING) || !xpath) {
+        /* not indexed */
+        goto cleanup;
+    }
+
+    /* learn which list instance is requested */
+    if ((err_info = sr_module_file_idx_xpath_key(ly_mod, xpath, &key, &key_len)) || !key) {
+        goto cleanup;
+    }
+
+    /* open the index, if any */
+    if ((err_info = sr_path_ds_shm(ly_mod->name, ds, &path))) {
+        goto cleanup;
+    }
+    if ((err_info = sr_module_file_idx_path(path, &idx_path))) {
+        goto cleanup;
+    }
+    if ((fd = sr_open(idx_path, O_RDONLY, 0)) == -1) {
+        if (errno != ENOENT) {
+            SR_ERRINFO_OPEN(&err_info, idx_path);
+        }
+        goto cleanup;
+    }
+    if (fstat(fd, &idx_st) == -1) {
+        SR_ERRINFO_SYSERRNO(&err_info, "fstat");
+        goto cleanup;
+    }
+    if ((size_t)idx_st.st_size < sizeof hdr) {
+        goto cleanup;
+    }
+
+    /* map it */
+    addr = mmap(NULL, idx_st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        SR_ERRINFO_SYSERRNO(&err_info, "mmap");
+        goto cleanup;
+    }
+    memcpy(&hdr, addr, sizeof hdr);
+
+    /* the index must belong to the current data file */
+    if (stat(path, &st) == -1) {
+        SR_ERRINFO_SYSERRNO(&err_info, "stat");
+        goto cleanup;
+    }
+    if (!sr_module_file_idx_hdr_match(&hdr, &st)) {
+        goto cleanup;
+    }
+
+    /* find the instance */
+    ptr = addr + sizeof hdr;
+    end = addr + idx_st.st_size;
+    for (i = 0; i < hdr.count; ++i) {
+        if ((size_t)(end - ptr) < sizeof ent_key_len + sizeof ent_lyb_len) {
+            /* invalid index */
+            goto cleanup;
+        }
+        memcpy(&ent_key_len, ptr, sizeof ent_key_len);
+        ptr += sizeof ent_key_len;
+        memcpy(&ent_lyb_len, ptr, sizeof ent_lyb_len);
+        ptr += sizeof ent_lyb_len;
+        if ((size_t)(end - ptr) < (size_t)ent_key_len + ent_lyb_len) {
+            goto cleanup;
+        }
+
+        if ((ent_key_len == key_len) && !memcmp(ptr, key, key_len)) {
+            /* load only this instance */
+            ly_errno = 0;
+            mod_data = lyd_parse_mem(ly_mod->ctx, ptr + ent_key_len, LYD_LYB,
+                    LYD_OPT_CONFIG | LYD_OPT_STRICT | LYD_OPT_TRUSTED);
+            if (ly_errno) {
+                sr_errinfo_new_ly(&err_info, ly_mod->ctx);
+                goto cleanup;
+            }
+            break;
+        }
+        ptr += ent_key_len + ent_lyb_len;
+    }
+
+    /* success, the instance may not exist at all */
+    if (*data && mod_data) {
+        sr_ly_link(*data, mod_data);
+    } else if (mod_data) {
+        *data = mod_data;
+    }
+    mod_data = NULL;
+    *pruned = 1;
+
+cleanup:
+    if (addr != MAP_FAILED) {
+        munmap(addr, idx_st.st_size);
+    }
+    if (fd > -1) {
+        close(fd);
+    }
+    free(key);
+    free(path);
+    free(idx_path);
+    lyd_free_withsiblings(mod_data);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_module_file_candidate_diff_load(const struct lys_module *ly_mod, struct lyd_node **diff, int *exists)
+{
+    sr_error_info_t *err_info = NULL;
+    char *path = NULL;
+    int fd = -1;
+
+    assert(!*diff);
+
+    *exists = 0;
+
+    if ((err_info = sr_path_ds_shm(ly_mod->name, SR_DS_CANDIDATE, &path))) {
+        goto cleanup;
+    }
+
+    /* open fd */
+    fd = sr_open(path, O_RDONLY, 0);
+    if (fd == -1) {
+        if (errno != ENOENT) {
+            SR_ERRINFO_OPEN(&err_info, path);
+        }
+        /* otherwise candidate is the same as running */
+        goto cleanup;
+    }
+    *exists = 1;
+
+    /* load the diff */
+    ly_errno = 0;
+    *diff = lyd_parse_fd(ly_mod->ctx, fd, LYD_LYB, LYD_OPT_EDIT | LYD_OPT_STRICT | LYD_OPT_NOEXTDEPS);
+    if (ly_errno) {
+        sr_errinfo_new_ly(&err_info, ly_mod->ctx);
+        lyd_free_withsiblings(*diff);
+        *diff = NULL;
+        goto cleanup;
+    }
+
+cleanup:
+    if (fd > -1) {
+        close(fd);
+    }
+    free(path);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_module_file_candidate_store(struct sr_mod_info_mod_s *mod, const struct lyd_node *diff, struct lyd_node *mod_data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *cand_diff = NULL, *run_data = NULL;
+    struct lyd_difflist *ly_diff = NULL;
+    uint32_t run_ver;
+    int exists;
+
+    /* load the current candidate diff */
+    if ((err_info = sr_module_file_candidate_diff_load(mod->ly_mod, &cand_diff, &exists))) {
+        goto cleanup;
+    }
+
+    run_ver = mod->shm_mod->ver;
+    if (!exists || (mod->shm_mod->cand_run_ver == run_ver)) {
+        /* the stored diff is relative to the current running data, just merge the new changes into it */
+        if ((err_info = sr_diff_mod_merge(diff, NULL, mod->ly_mod, &cand_diff, NULL))) {
+            goto cleanup;
+        }
+    } else {
+        /* running data have changed since, generate the whole diff again */
+        lyd_free_withsiblings(cand_diff);
+        cand_diff = NULL;
+
+        if ((err_info = sr_module_file_data_append(mod->ly_mod, SR_DS_RUNNING, &run_data))) {
+            goto cleanup;
+        }
+        if (!(ly_diff = lyd_diff(run_data, mod_data, LYD_DIFFOPT_WITHDEFAULTS))) {
+            sr_errinfo_new_ly(&err_info, mod->ly_mod->ctx);
+            goto cleanup;
+        }
+        if ((ly_diff->type[0] != LYD_DIFF_END) && (err_info = sr_diff_ly2sr(ly_diff, &cand_diff))) {
+            goto cleanup;
+        }
+    }
+
+    /* store the diff, even an empty one means candidate was modified */
+    if ((err_info = sr_module_file_data_set(mod->ly_mod->name, SR_DS_CANDIDATE, cand_diff, O_CREAT, SR_FILE_PERM))) {
+        goto cleanup;
+    }
+
+    /* remember the running data version the diff is relative to */
+    mod->shm_mod->cand_run_ver = run_ver;
+
+cleanup:
+    lyd_free_diff(ly_diff);
+    lyd_free_withsiblings(cand_diff);
+    lyd_free_withsiblings(run_data);
+    return err_info;
+}
+
+/**
+ * @brief Get the connection ID of a stored operational diff node, if it has its own.
+ *
+ * @param[in] node Diff node.
+ * @return Connection ID, 0 if none.
+ */
+static sr_cid_t
+sr_opercache_node_cid(const struct lyd_node *node)
+{
+    struct lyd_attr *attr;
+
+    LY_TREE_FOR(node->attr, attr) {
+        if (sr_edit_attr_type(attr) == EDIT_ATTR_CID) {
+            return attr->value.uint32;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Free cached stored operational diff of a module.
+ *
+ * @param[in] cache_mod Cached module.
+ */
+static void
+sr_opercache_mod_clear(struct sr_oper_cache_mod_s *cache_mod)
+{
+    uint32_t i;
+
+    for (i = 0; i < cache_mod->cid_count; ++i) {
+        ly_set_free(cache_mod->cids[i].nodes);
+    }
+    free(cache_mod->cids);
+    cache_mod->cids = NULL;
+    cache_mod->cid_count = 0;
+
+    if (cache_mod->borrow) {
+        /* the borrowed diff is now owned by the borrowers */
+        assert(cache_mod->borrow->diff == cache_mod->diff);
+        cache_mod->borrow = NULL;
+    } else {
+        lyd_free_withsiblings(cache_mod->diff);
+    }
+    cache_mod->diff = NULL;
+    cache_mod->ver = 0;
+}
+
+/**
+ * @brief Set stored operational diff of a module in the cache and index its subtrees by their connection IDs.
+ *
+ * @param[in] cache_mod Cached module, is cleared first.
+ * @param[in] diff Diff to set, is spent.
+ * @param[in] ver Version of @p diff.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_opercache_mod_set(struct sr_oper_cache_mod_s *cache_mod, struct lyd_node *diff, uint32_t ver)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *root, *next, *elem;
+    sr_cid_t cid;
+    uint32_t i;
+    void *mem;
+
+    sr_opercache_mod_clear(cache_mod);
+    cache_mod->diff = diff;
+
+    LY_TREE_FOR(diff, root) {
+        LY_TREE_DFS_BEGIN(root, next, elem) {
+            if ((cid = sr_opercache_node_cid(elem))) {
+                /* find the connection */
+                for (i = 0; i < cache_mod->cid_count; ++i) {
+                    if (cache_mod->cids[i].cid == cid) {
+                        break;
+                    }
+                }
+                if (i == cache_mod->cid_count) {
+                    mem = realloc(cache_mod->cids, (i + 1) * sizeof *cache_mod->cids);
+                    SR_CHECK_MEM_GOTO(!mem, err_info, error);
+                    cache_mod->cids = mem;
+                    cache_mod->cids[i].cid = cid;
+                    cache_mod->cids[i].nodes = ly_set_new();
+                    SR_CHECK_MEM_GOTO(!cache_mod->cids[i].nodes, err_info, error);
+                    ++cache_mod->cid_count;
+                }
+
+                /* add the subtree */
+                if (ly_set_add(cache_mod->cids[i].nodes, elem, LY_SET_OPT_USEASLIST) == -1) {
+                    sr_errinfo_new_ly(&err_info, lyd_node_module(elem)->ctx);
+                    goto error;
+                }
+            }
+            LY_TREE_DFS_END(root, next, elem);
+        }
+    }
+
+    cache_mod->ver = ver;
+    return NULL;
+
+error:
+    sr_opercache_mod_clear(cache_mod);
+    return err_info;
+}
+
+/**
+ * @brief Make sure cached stored operational diff of a module is not borrowed so that it can be modified.
+ *
+ * @param[in] cache_mod Cached module.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_opercache_mod_unborrow(struct sr_oper_cache_mod_s *cache_mod)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *diff;
+
+    if (!cache_mod->borrow) {
+        return NULL;
+    }
+
+    /* use a copy, the borrowed diff is left to the borrowers */
+    diff = lyd_dup_withsiblings(cache_mod->diff, LYD_DUP_OPT_RECURSIVE);
+    if (!diff) {
+        sr_errinfo_new_ly(&err_info, cache_mod->ly_mod->ctx);
+        return err_info;
+    }
+    return sr_opercache_mod_set(cache_mod, diff, cache_mod->ver);
+}
+
+/**
+ * @brief Remove all stored operational diff subtrees of a connection from a cached module.
+ *
+ * @param[in] cache_mod Cached module.
+ * @param[in] idx Index of the connection in @p cache_mod to remove.
+ */
+static void
+sr_opercache_mod_del_conn(struct sr_oper_cache_mod_s *cache_mod, uint32_t idx)
+{
+    struct lyd_node *node, *next, *elem;
+    sr_cid_t cid;
+    uint32_t i, j;
+
+    for (i = 0; i < cache_mod->cids[idx].nodes->number; ++i) {
+        node = cache_mod->cids[idx].nodes->set.d[i];
+
+        /* forget nested subtrees of other connections */
+        LY_TREE_DFS_BEGIN(node, next, elem) {
+            if ((elem != node) && (cid = sr_opercache_node_cid(elem))) {
+                for (j = 0; j < cache_mod->cid_count; ++j) {
+                    if (cache_mod->cids[j].cid == cid) {
+                        ly_set_rm(cache_mod->cids[j].nodes, elem);
+                        break;
+                    }
+                }
+            }
+            LY_TREE_DFS_END(node, next, elem);
+        }
+
+        /* free the subtree, they cannot overlap */
+        if (cache_mod->diff == node) {
+            cache_mod->diff = node->next;
+        }
+        lyd_free(node);
+    }
+
+    /* remove the connection */
+    ly_set_free(cache_mod->cids[idx].nodes);
+    --cache_mod->cid_count;
+    if (idx < cache_mod->cid_count) {
+        cache_mod->cids[idx] = cache_mod->cids[cache_mod->cid_count];
+    }
+}
+
+/**
+ * @brief Find a module in the stored operational diff cache, add it if not found. If the cache is full,
+ * the least recently used module is evicted.
+ *
+ * @param[in] oper_cache Operational diff cache.
+ * @param[in] ly_mod Module to find.
+ * @param[out] cache_mod Cached module.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_opercache_mod_get(struct sr_oper_cache_s *oper_cache, const struct lys_module *ly_mod,
+        struct sr_oper_cache_mod_s **cache_mod)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t i, lru;
+    void *mem;
+
+    lru = 0;
+    for (i = 0; i < oper_cache->mod_count; ++i) {
+        if (oper_cache->mods[i].ly_mod == ly_mod) {
+            *cache_mod = &oper_cache->mods[i];
+            (*cache_mod)->last_use = ++oper_cache->use_tick;
+            return NULL;
+        }
+        if (oper_cache->mods[i].last_use < oper_cache->mods[lru].last_use) {
+            lru = i;
+        }
+    }
+
+    if (oper_cache->mod_count < SR_OPER_CACHE_MOD_COUNT) {
+        /* module is not in cache yet, add an item */
+        mem = realloc(oper_cache->mods, (i + 1) * sizeof *oper_cache->mods);
+        SR_CHECK_MEM_RET(!mem, err_info);
+        oper_cache->mods = mem;
+        ++oper_cache->mod_count;
+    } else {
+        /* cache is full, evict the least recently used module */
+        i = lru;
+        sr_opercache_mod_clear(&oper_cache->mods[i]);
+    }
+
+    *cache_mod = &oper_cache->mods[i];
+    memset(*cache_mod, 0, sizeof **cache_mod);
+    (*cache_mod)->ly_mod = ly_mod;
+    (*cache_mod)->last_use = ++oper_cache->use_tick;
+    return NULL;
+}
+
+/**
+ * @brief Get a module from the stored operational diff cache with its current stored diff.
+ * Cache must be locked.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] mod Mod info mod.
+ * @param[out] cache_mod Cached module.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_opercache_mod_update(sr_conn_ctx_t *conn, struct sr_mod_info_mod_s *mod, struct sr_oper_cache_mod_s **cache_mod)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *mod_diff = NULL;
+    uint32_t i;
+
+    if ((err_info = sr_opercache_mod_get(&conn->oper_cache, mod->ly_mod, cache_mod))) {
+        return err_info;
+    }
+
+    if ((*cache_mod)->ver != mod->shm_mod->oper_ver) {
+        /* load the operational data (diff) */
+        if ((err_info = sr_module_file_data_append(mod->ly_mod, SR_DS_OPERATIONAL, &mod_diff))) {
+            return err_info;
+        }
+        if ((err_info = sr_opercache_mod_set(*cache_mod, mod_diff, mod->shm_mod->oper_ver))) {
+            return err_info;
+        }
+    }
+
+    /* remove diff belonging to dead connections, if any */
+    i = 0;
+    while (i < (*cache_mod)->cid_count) {
+        if (!sr_conn_is_alive((*cache_mod)->cids[i].cid)) {
+            /* the diff will be modified */
+            if ((err_info = sr_opercache_mod_unborrow(*cache_mod))) {
+                return err_info;
+            }
+
+            /* this connection is dead, remove its stored diff */
+            SR_LOG_INF("Recovering stored operational data of CID %" PRIu32 ".", (*cache_mod)->cids[i].cid);
+            sr_opercache_mod_del_conn(*cache_mod, i);
+        } else {
+            ++i;
+        }
+    }
+
+    return NULL;
+}
+
+sr_error_info_t *
+sr_module_file_oper_data_load(sr_conn_ctx_t *conn, struct sr_mod_info_mod_s *mod, struct lyd_node **diff)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_oper_cache_mod_s *cache_mod;
+
+    assert(!*diff);
+
+    /* CACHE LOCK */
+    if ((err_info = sr_mlock(&conn->oper_cache.lock, SR_OPER_CACHE_LOCK_TIMEOUT, __func__, NULL, NULL))) {
+        return err_info;
+    }
+
+    if ((err_info = sr_opercache_mod_update(conn, mod, &cache_mod))) {
+        goto cleanup;
+    }
+
+    /* return a copy of the diff */
+    if (cache_mod->diff) {
+        *diff = lyd_dup_withsiblings(cache_mod->diff, LYD_DUP_OPT_RECURSIVE);
+        if (!*diff) {
+            sr_errinfo_new_ly(&err_info, mod->ly_mod->ctx);
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    /* CACHE UNLOCK */
+    sr_munlock(&conn->oper_cache.lock);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_module_file_oper_data_borrow(sr_conn_ctx_t *conn, struct sr_mod_info_mod_s *mod, const struct lyd_node **diff,
+        struct sr_oper_cache_borrow_s **borrow)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_oper_cache_mod_s *cache_mod;
+
+    *diff = NULL;
+    *borrow = NULL;
+
+    /* CACHE LOCK */
+    if ((err_info = sr_mlock(&conn->oper_cache.lock, SR_OPER_CACHE_LOCK_TIMEOUT, __func__, NULL, NULL))) {
+        return err_info;
+    }
+
+    if ((err_info = sr_opercache_mod_update(conn, mod, &cache_mod))) {
+        goto cleanup;
+    }
+
+    /* share the cached diff */
+    if (cache_mod->diff) {
+        if (!cache_mod->borrow) {
+            cache_mod->borrow = calloc(1, sizeof *cache_mod->borrow);
+            SR_CHECK_MEM_GOTO(!cache_mod->borrow, err_info, cleanup);
+            cache_mod->borrow->diff = cache_mod->diff;
+        }
+        ++cache_mod->borrow->refcount;
+        *borrow = cache_mod->borrow;
+        *diff = cache_mod->borrow->diff;
+    }
+
+cleanup:
+    /* CACHE UNLOCK */
+    sr_munlock(&conn->oper_cache.lock);
+    return err_info;
+}
+
+void
+sr_module_file_oper_data_release(sr_conn_ctx_t *conn, struct sr_oper_cache_borrow_s *borrow)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t i;
+
+    if (!borrow) {
+        return;
+    }
+
+    /* CACHE LOCK */
+    if ((err_info = sr_mlock(&conn->oper_cache.lock, SR_OPER_CACHE_LOCK_TIMEOUT, __func__, NULL, NULL))) {
+        sr_errinfo_free(&err_info);
+        return;
+    }
+
+    if (!--borrow->refcount) {
+        for (i = 0; i < conn->oper_cache.mod_count; ++i) {
+            if (conn->oper_cache.mods[i].borrow == borrow) {
+                break;
+            }
+        }
+        if (i < conn->oper_cache.mod_count) {
+            /* still the cached diff */
+            conn->oper_cache.mods[i].borrow = NULL;
+        } else {
+            /* last borrower of a diff no longer cached */
+            lyd_free_withsiblings(borrow->diff);
+        }
+        free(borrow);
+    }
+
+    /* CACHE UNLOCK */
+    sr_munlock(&conn->oper_cache.lock);
+}
+
+sr_error_info_t *
+sr_module_file_oper_data_store(sr_conn_ctx_t *conn, struct sr_mod_info_mod_s *mod, const struct lyd_node *diff)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_oper_cache_mod_s *cache_mod;
+    struct lyd_node *cache_diff = NULL;
+
+    /* store the diff */
+    if ((err_info = sr_module_file_data_set(mod->ly_mod->name, SR_DS_OPERATIONAL, (struct lyd_node *)diff, 0,
+            SR_FILE_PERM))) {
+        return err_info;
+    }
+
+    /* update stored diff version, never 0 */
+    if (!++mod->shm_mod->oper_ver) {
+        ++mod->shm_mod->oper_ver;
+    }
+
+    /* CACHE LOCK */
+    if ((err_info = sr_mlock(&conn->oper_cache.lock, SR_OPER_CACHE_LOCK_TIMEOUT, __func__, NULL, NULL))) {
+        return err_info;
+    }
+
+    /* cache the stored diff */
+    if ((err_info = sr_opercache_mod_get(&conn->oper_cache, mod->ly_mod, &cache_mod))) {
+        goto cleanup;
+    }
+    if (diff) {
+        cache_diff = lyd_dup_withsiblings(diff, LYD_DUP_OPT_RECURSIVE);
+        if (!cache_diff) {
+            sr_errinfo_new_ly(&err_info, mod->ly_mod->ctx);
+            sr_opercache_mod_clear(cache_mod);
+            goto cleanup;
+        }
+    }
+    err_info = sr_opercache_mod_set(cache_mod, cache_diff, mod->shm_mod->oper_ver);
+
+cleanup:
+    /* CACHE UNLOCK */
+    sr_munlock(&conn->oper_cache.lock);
+    return err_info;
+}
+
+void
+sr_opercache_free(struct sr_oper_cache_s *oper_cache)
+{
+    uint32_t i;
+
+    for (i = 0; i < oper_cache->mod_count; ++i) {
+        sr_opercache_mod_clear(&oper_cache->mods[i]);
+    }
+    free(oper_cache->mods);
+    oper_cache->mods = NULL;
+    oper_cache->mod_count = 0;
+}
+
+/**
+ * @brief Write data into a file.
+ *
+ * @param[in] path Path of the file.
+ * @param[in] mod_data Data to write.
+ * @param[in] src_path Optional path of a data file to copy instead of writing @p mod_data.
+ * @param[in] create_flags Additional flags that will be used for opening the file.
+ * @param[in] file_mode Permissions (mode) of the file.
+ * @param[in] backup Whether to back up the current file content while it is being rewritten.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_file_data_write(const char *path, struct lyd_node *mod_data, const char *src_path, int create_flags,
+        mode_t file_mode, int backup)
+{
+    sr_error_info_t *err_info = NULL;
+    char *bck_path = NULL;
+    int fd = -1;
+
+    if (backup) {
+        /* generate the backup path */
+        if (asprintf(&bck_path, "%s%s", path, SR_FILE_BACKUP_SUFFIX) == -1) {
+            SR_ERRINFO_MEM(&err_info);
+            goto cleanup;
+        }
+
+        /* back up any existing file */
+        if ((err_info = sr_cp_path(bck_path, path, file_mode))) {
+            goto cleanup;
+        }
+    }
+
+    /* open the file */
+    if ((fd = sr_open(path, O_WRONLY | create_flags, file_mode)) == -1) {
+        SR_ERRINFO_OPEN(&err_info, path);
+        goto cleanup;
+    }
+
+    if (src_path) {
+        /* copy data */
+        if ((err_info = sr_cp_fd(fd, src_path))) {
+            goto cleanup;
+        }
+    } else if (lyd_print_fd(fd, mod_data, LYD_LYB, LYP_WITHSIBLINGS)) {
+        /* print data */
+        sr_errinfo_new_ly(&err_info, lyd_node_module(mod_data)->ctx);
+        sr_errinfo_new(&err_info, SR_ERR_INTERNAL, NULL, "Failed to store data into \"%s\".", path);
+        goto cleanup;
+    }
+
     /* delete the backup file */
     if (backup && (unlink(bck_path) == -1)) {
         sr_errinfo_new(&err_info, SR_ERR_SYS, NULL, "Failed to remove backup \"%s\" (%s).", bck_path, strerror(errno));
@@ -5337,11 +7065,305 @@ cleanup:
     if (fd > -1) {
         close(fd);
     }
-    free(path);
     free(bck_path);
     return err_info;
 }
 
+/**
+ * @brief Set (replace) data in file/SHM for a specific module.
+ *
+ * @param[in] mod_name Module name.
+ * @param[in] ds Target datastore
+ * @param[in] mod_data Module data.
+ * @param[in] diff Optional diff of the changes between the current and new running data to update the index with.
+ * @param[in] create_flags Additional flags that will be used for opening the file.
+ * @param[in] file_mode Permissions (mode) of the file.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_module_file_data_set(const char *mod_name, sr_datastore_t ds, struct lyd_node *mod_data,
+        const struct lyd_node *diff, int create_flags, mode_t file_mode)
+{
+    sr_error_info_t *err_info = NULL;
+    char *path = NULL, *old_idx = NULL;
+    size_t old_idx_len = 0;
+
+    assert(file_mode);
+
+    if ((ds == SR_DS_STARTUP) && (!(create_flags & O_CREAT) && !(create_flags & O_EXCL))) {
+        /* replace the existing file atomically */
+        if ((err_info = sr_module_file_startup_prepare(mod_name, mod_data, &path))) {
+            return err_info;
+        }
+        return sr_module_file_startup_commit(&path, 1);
+    }
+
+    /* learn path */
+    switch (ds) {
+    case SR_DS_STARTUP:
+        err_info = sr_path_startup_file(mod_name, &path);
+        break;
+    case SR_DS_RUNNING:
+    case SR_DS_CANDIDATE:
+    case SR_DS_OPERATIONAL:
+        err_info = sr_path_ds_shm(mod_name, ds, &path);
+        break;
+    }
+    if (err_info) {
+        goto cleanup;
+    }
+
+    if (ds == SR_DS_RUNNING) {
+        if (diff && (err_info = sr_module_file_idx_read(path, &old_idx, &old_idx_len))) {
+            /* the index will be fully generated */
+            sr_errinfo_free(&err_info);
+        }
+
+        /* the index would not match the data while they are being written */
+        if ((err_info = sr_module_file_idx_del(path))) {
+            goto cleanup;
+        }
+    }
+
+    /* write the data */
+    if ((err_info = sr_module_file_data_write(path, mod_data, NULL, create_flags, file_mode, 0))) {
+        goto cleanup;
+    }
+
+    if (ds == SR_DS_RUNNING) {
+        /* index top-level list instances, data can always be loaded without it */
+        if ((err_info = sr_module_file_idx_write(path, mod_data, diff, old_idx, old_idx_len))) {
+            SR_LOG_WRN("Failed to store \"%s\" running data index.", mod_name);
+            sr_errinfo_free(&err_info);
+        }
+    }
+
+cleanup:
+    free(old_idx);
+    free(path);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_module_file_data_set(const char *mod_name, sr_datastore_t ds, struct lyd_node *mod_data, int create_flags,
+        mode_t file_mode)
+{
+    return _sr_module_file_data_set(mod_name, ds, mod_data, NULL, create_flags, file_mode);
+}
+
+sr_error_info_t *
+sr_module_file_running_update(const char *mod_name, struct lyd_node *mod_data, const struct lyd_node *diff)
+{
+    return _sr_module_file_data_set(mod_name, SR_DS_RUNNING, mod_data, diff, 0, SR_FILE_PERM);
+}
+
+/**
+ * @brief Store new startup data of a module into a temporary file.
+ *
+ * @param[in] mod_name Module name.
+ * @param[in] mod_data Module data.
+ * @param[in] src_path Optional path of a data file to copy instead of writing @p mod_data.
+ * @param[out] tmp_path Path of the temporary file, NULL if the data were written in place.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_module_file_startup_tmp(const char *mod_name, struct lyd_node *mod_data, const char *src_path, char **tmp_path)
+{
+    sr_error_info_t *err_info = NULL;
+    struct stat st, tmp_st;
+    char *path = NULL;
+    int fd = -1;
+
+    *tmp_path = NULL;
+
+    if ((err_info = sr_path_startup_file(mod_name, &path))) {
+        goto cleanup;
+    }
+
+    /* learn owner and permissions of the current file */
+    if (stat(path, &st) == -1) {
+        SR_ERRINFO_SYSERRNO(&err_info, "stat");
+        goto cleanup;
+    }
+
+    if (asprintf(tmp_path, "%s%s", path, SR_FILE_TEMP_SUFFIX) == -1) {
+        *tmp_path = NULL;
+        SR_ERRINFO_MEM(&err_info);
+        goto cleanup;
+    }
+
+    /* create the temporary file */
+    fd = sr_open(*tmp_path, O_WRONLY | O_CREAT | O_TRUNC, st.st_mode & 00777);
+    if (fd == -1) {
+        if ((errno == EACCES) || (errno == EPERM)) {
+            /* we cannot create files in the directory */
+            goto fallback;
+        }
+        SR_ERRINFO_OPEN(&err_info, *tmp_path);
+        goto cleanup;
+    }
+
+    /* it must have the same owner and permissions as the current file */
+    if (fstat(fd, &tmp_st) == -1) {
+        SR_ERRINFO_SYSERRNO(&err_info, "fstat");
+        goto cleanup;
+    }
+    if (((tmp_st.st_uid != st.st_uid) || (tmp_st.st_gid != st.st_gid)) && (fchown(fd, st.st_uid, st.st_gid) == -1)) {
+        if (errno == EPERM) {
+            goto fallback;
+        }
+        SR_ERRINFO_SYSERRNO(&err_info, "fchown");
+        goto cleanup;
+    }
+    if (((tmp_st.st_mode & 00777) != (st.st_mode & 00777)) && (fchmod(fd, st.st_mode & 00777) == -1)) {
+        SR_ERRINFO_SYSERRNO(&err_info, "fchmod");
+        goto cleanup;
+    }
+
+    if (src_path) {
+        /* copy data */
+        if ((err_info = sr_cp_fd(fd, src_path))) {
+            goto cleanup;
+        }
+    } else if (lyd_print_fd(fd, mod_data, LYD_LYB, LYP_WITHSIBLINGS)) {
+        /* print data */
+        sr_errinfo_new_ly(&err_info, lyd_node_module(mod_data)->ctx);
+        sr_errinfo_new(&err_info, SR_ERR_INTERNAL, NULL, "Failed to store data into \"%s\".", *tmp_path);
+        goto cleanup;
+    }
+
+#if SR_STARTUP_FSYNC
+    /* make sure the data are stored before the file is renamed */
+    if (fsync(fd) == -1) {
+        SR_ERRINFO_SYSERRNO(&err_info, "fsync");
+        goto cleanup;
+    }
+#endif
+
+    /* success */
+    goto cleanup;
+
+fallback:
+    /* temporary file with the correct owner cannot be created, rewrite the file in place with a backup */
+    if (fd > -1) {
+        close(fd);
+        fd = -1;
+        unlink(*tmp_path);
+    }
+    free(*tmp_path);
+    *tmp_path = NULL;
+
+    err_info = sr_module_file_data_write(path, mod_data, src_path, 0, st.st_mode & 00777, 1);
+
+cleanup:
+    if (fd > -1) {
+        close(fd);
+    }
+    if (err_info && *tmp_path) {
+        unlink(*tmp_path);
+        free(*tmp_path);
+        *tmp_path = NULL;
+    }
+    free(path);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_module_file_startup_prepare(const char *mod_name, struct lyd_node *mod_data, char **tmp_path)
+{
+    return sr_module_file_startup_tmp(mod_name, mod_data, NULL, tmp_path);
+}
+
+sr_error_info_t *
+sr_module_file_startup_prepare_copy(const char *mod_name, sr_datastore_t src_ds, char **tmp_path)
+{
+    sr_error_info_t *err_info = NULL;
+    char *src_path;
+
+    assert((src_ds == SR_DS_RUNNING) || (src_ds == SR_DS_CANDIDATE));
+
+    if ((err_info = sr_path_ds_shm(mod_name, src_ds, &src_path))) {
+        return err_info;
+    }
+
+    err_info = sr_module_file_startup_tmp(mod_name, NULL, src_path, tmp_path);
+    free(src_path);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_module_file_startup_commit(char **tmp_paths, uint32_t count)
+{
+    sr_error_info_t *err_info = NULL;
+#if SR_STARTUP_FSYNC > 1
+    sr_error_info_t *tmp_err = NULL;
+#endif
+    char *path;
+    uint32_t i;
+#if SR_STARTUP_FSYNC > 1
+    int fd, renamed = 0;
+#endif
+
+    for (i = 0; i < count; ++i) {
+        if (!tmp_paths[i]) {
+            continue;
+        }
+
+        /* replace the data file */
+        path = strndup(tmp_paths[i], strlen(tmp_paths[i]) - strlen(SR_FILE_TEMP_SUFFIX));
+        if (!path) {
+            SR_ERRINFO_MEM(&err_info);
+            unlink(tmp_paths[i]);
+        } else if (rename(tmp_paths[i], path) == -1) {
+            sr_errinfo_new(&err_info, SR_ERR_SYS, NULL, "Failed to rename \"%s\" (%s).", tmp_paths[i], strerror(errno));
+            unlink(tmp_paths[i]);
+        } else {
+#if SR_STARTUP_FSYNC > 1
+            renamed = 1;
+#endif
+        }
+        free(path);
+        free(tmp_paths[i]);
+        tmp_paths[i] = NULL;
+    }
+
+#if SR_STARTUP_FSYNC > 1
+    if (renamed) {
+        /* make the renames persistent, all the files are in the same directory, keep any previous errors */
+        if ((tmp_err = sr_path_startup_dir(&path))) {
+            sr_errinfo_merge(&err_info, tmp_err);
+            return err_info;
+        }
+        fd = sr_open(path, O_RDONLY | O_DIRECTORY, 0);
+        if (fd == -1) {
+            SR_ERRINFO_OPEN(&tmp_err, path);
+        } else {
+            if (fsync(fd) == -1) {
+                SR_ERRINFO_SYSERRNO(&tmp_err, "fsync");
+            }
+            close(fd);
+        }
+        free(path);
+        sr_errinfo_merge(&err_info, tmp_err);
+    }
+#endif
+
+    return err_info;
+}
+
+void
+sr_module_file_startup_discard(char **tmp_paths, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; ++i) {
+        if (tmp_paths[i]) {
+            unlink(tmp_paths[i]);
+            free(tmp_paths[i]);
+        }
+    }
+}
+
 sr_error_info_t *
 sr_module_update_oper_diff(sr_conn_ctx_t *conn, const char *mod_name)
 {
@@ -5367,7 +7389,7 @@ sr_module_update_oper_diff(sr_conn_ctx_t *conn, const char *mod_name)
     }
 
     /* load the stored diff */
-    if ((err_info = sr_module_file_oper_data_load(&mod_info.mods[0], &diff))) {
+    if ((err_info = sr_module_file_oper_data_load(conn, &mod_info.mods[0], &diff))) {
         goto cleanup;
     }
     if (!diff) {
@@ -5376,7 +7398,7 @@ sr_module_update_oper_diff(sr_conn_ctx_t *conn, const char *mod_name)
     }
 
     /* now just load all the data */
-    if ((err_info = sr_modinfo_data_load(&mod_info, 1, sid, NULL, 0, SR_OPER_NO_STORED | SR_OPER_NO_SUBS, &cb_err_info))) {
+    if ((err_info = sr_modinfo_data_load(&mod_info, SR_MI_DATA_CACHE, sid, NULL, 0, SR_OPER_NO_STORED | SR_OPER_NO_SUBS, &cb_err_info))) {
         goto cleanup;
     }
     if (cb_err_info) {
@@ -5390,7 +7412,7 @@ sr_module_update_oper_diff(sr_conn_ctx_t *conn, const char *mod_name)
     if ((err_info = sr_diff_mod_update(&diff, ly_mod, mod_info.data))) {
         goto cleanup;
     }
-    if ((err_info = sr_module_file_data_set(ly_mod->name, SR_DS_OPERATIONAL, diff, 0, SR_FILE_PERM))) {
+    if ((err_info = sr_module_file_oper_data_store(conn, &mod_info.mods[0], diff))) {
         goto cleanup;
     }
 
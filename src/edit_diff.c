@@ -40,8 +40,136 @@ enum insert_val {
     INSERT_AFTER
 };
 
+enum edit_attr
+sr_edit_attr_type(const struct lyd_attr *attr)
+{
+    const char *mod_name = attr->annotation->module->name;
+    enum {MOD_OTHER, MOD_YANG, MOD_SR, MOD_NC, MOD_ORIGIN} mod = MOD_OTHER;
+
+    switch (mod_name[0]) {
+    case 'y':
+        if (!strcmp(mod_name, "yang")) {
+            mod = MOD_YANG;
+        }
+        break;
+    case 's':
+        if (!strcmp(mod_name, SR_YANG_MOD)) {
+            mod = MOD_SR;
+        }
+        break;
+    case 'i':
+        if (!strcmp(mod_name, "ietf-netconf")) {
+            mod = MOD_NC;
+        } else if (!strcmp(mod_name, "ietf-origin")) {
+            mod = MOD_ORIGIN;
+        }
+        break;
+    default:
+        break;
+    }
+
+    if (mod == MOD_YANG) {
+        switch (attr->name[0]) {
+        case 'i':
+            assert(!strcmp(attr->name, "insert"));
+            return EDIT_ATTR_INSERT;
+        case 'k':
+            assert(!strcmp(attr->name, "key"));
+            return EDIT_ATTR_KEY;
+        case 'v':
+            assert(!strcmp(attr->name, "value"));
+            return EDIT_ATTR_VALUE;
+        default:
+            break;
+        }
+    } else if (mod == MOD_SR) {
+        if (attr->name[0] == 'c') {
+            assert(!strcmp(attr->name, "cid"));
+            return EDIT_ATTR_CID;
+        } else if (attr->name[1] == 'p') {
+            assert(!strcmp(attr->name, "operation"));
+            return EDIT_ATTR_OPER;
+        }
+        switch (attr->name[5]) {
+        case 'k':
+            assert(!strcmp(attr->name, "orig-key"));
+            return EDIT_ATTR_ORIG_KEY;
+        case 'v':
+            assert(!strcmp(attr->name, "orig-value"));
+            return EDIT_ATTR_ORIG_VALUE;
+        case 'd':
+            assert(!strcmp(attr->name, "orig-dflt"));
+            return EDIT_ATTR_ORIG_DFLT;
+        default:
+            break;
+        }
+    } else if (mod == MOD_NC) {
+        if (!strcmp(attr->name, "operation")) {
+            return EDIT_ATTR_OPER;
+        }
+    } else if (mod == MOD_ORIGIN) {
+        assert(!strcmp(attr->name, "origin"));
+        return EDIT_ATTR_ORIGIN;
+    }
+
+    return EDIT_ATTR_UNKNOWN;
+}
+
+/**
+ * @brief Find an internal attribute of a node.
+ *
+ * @param[in] node Node to examine.
+ * @param[in] type Attribute type to find.
+ * @return Found attribute, NULL if none.
+ */
+static struct lyd_attr *
+sr_edit_attr_find(const struct lyd_node *node, enum edit_attr type)
+{
+    struct lyd_attr *attr;
+
+    for (attr = node->attr; attr; attr = attr->next) {
+        if (sr_edit_attr_type(attr) == type) {
+            return attr;
+        }
+    }
+
+    return NULL;
+}
+
+static enum edit_op sr_edit_str2op(const char *str);
+
+/**
+ * @brief Diff state (leaf-)list instance index node.
+ */
+struct sr_diff_idx_inst {
+    struct lyd_node *node;              /**< Indexed diff node. */
+    struct sr_diff_idx_inst *next;      /**< Next equal instance. */
+};
+
+/**
+ * @brief Diff state (leaf-)list instance index entry, holds all the equal instances in their sibling order.
+ */
+struct sr_diff_idx_entry {
+    uint32_t hash;                      /**< Hash of the instances. */
+    struct sr_diff_idx_inst *first;     /**< First equal instance. */
+    struct sr_diff_idx_inst *last;      /**< Last equal instance. */
+    struct sr_diff_idx_entry *next;     /**< Next entry in the bucket. */
+};
+
+/**
+ * @brief Index of state (leaf-)list instances in a diff. These can be duplicated and keyless
+ * so libyang can find them only by iterating over all the siblings.
+ */
+struct sr_diff_idx {
+    struct lyd_node **diff_root;        /**< Indexed diff, index is built on the first search. */
+    int built;                          /**< Whether the index was built. */
+    struct sr_diff_idx_entry **buckets; /**< Hash table buckets. */
+    uint32_t size;                      /**< Bucket count, power of 2. */
+    uint32_t count;                     /**< Entry count. */
+};
+
 static sr_error_info_t *sr_diff_merge_r(const struct lyd_node *src_node, enum edit_op parent_op, sr_conn_ctx_t *oper_conn,
-        struct lyd_node *diff_parent, struct lyd_node **diff_root, int *change);
+        struct sr_diff_idx *idx, struct lyd_node *diff_parent, struct lyd_node **diff_root, int *change);
 
 /**
  * @brief Find a previous (leaf-)list instance.
@@ -303,73 +431,48 @@ sr_edit_op(const struct lyd_node *edit_node, enum edit_op parent_op, enum edit_o
         user_order_list = 1;
     }
     LY_TREE_FOR(edit_node->attr, attr) {
-        if (!strcmp(attr->name, "operation")) {
-            if (!strcmp(attr->annotation->module->name, "ietf-netconf")) {
-                switch (attr->value_str[0]) {
-                case 'c':
-                    assert(!strcmp(attr->value_str, "create"));
-                    *op = EDIT_CREATE;
-                    break;
-                case 'd':
-                    assert(!strcmp(attr->value_str, "delete"));
-                    *op = EDIT_DELETE;
-                    break;
-                case 'r':
-                    if (!strcmp(attr->value_str, "remove")) {
-                        *op = EDIT_REMOVE;
-                    } else if (!strcmp(attr->value_str, "replace")) {
-                        *op = EDIT_REPLACE;
-                    } else {
-                        SR_ERRINFO_INT(&err_info);
-                        return err_info;
-                    }
-                    break;
-                case 'm':
-                    assert(!strcmp(attr->value_str, "merge"));
-                    *op = EDIT_MERGE;
-                    break;
-                default:
-                    SR_ERRINFO_INT(&err_info);
-                    return err_info;
-                }
-            } else if (!strcmp(attr->annotation->module->name, SR_YANG_MOD)) {
-                switch (attr->value_str[0]) {
-                case 'n':
-                    assert(!strcmp(attr->value_str, "none"));
-                    *op = EDIT_NONE;
-                    break;
-                case 'e':
-                    assert(!strcmp(attr->value_str, "ether"));
-                    *op = EDIT_ETHER;
-                    break;
-                case 'p':
-                    assert(!strcmp(attr->value_str, "purge"));
-                    *op = EDIT_PURGE;
-                    break;
-                default:
-                    SR_ERRINFO_INT(&err_info);
-                    return err_info;
-                }
+        switch (sr_edit_attr_type(attr)) {
+        case EDIT_ATTR_OPER:
+            *op = sr_edit_str2op(attr->value_str);
+            break;
+        case EDIT_ATTR_INSERT:
+            if (!user_order_list) {
+                break;
             }
-        } else if (user_order_list && !strcmp(attr->name, "insert") && !strcmp(attr->annotation->module->name, "yang")) {
-            if (!strcmp(attr->value_str, "first")) {
+            switch (attr->value_str[0]) {
+            case 'f':
+                assert(!strcmp(attr->value_str, "first"));
                 ins = INSERT_FIRST;
-            } else if (!strcmp(attr->value_str, "last")) {
+                break;
+            case 'l':
+                assert(!strcmp(attr->value_str, "last"));
                 ins = INSERT_LAST;
-            } else if (!strcmp(attr->value_str, "before")) {
+                break;
+            case 'b':
+                assert(!strcmp(attr->value_str, "before"));
                 ins = INSERT_BEFORE;
-            } else if (!strcmp(attr->value_str, "after")) {
+                break;
+            case 'a':
+                assert(!strcmp(attr->value_str, "after"));
                 ins = INSERT_AFTER;
-            } else {
+                break;
+            default:
                 SR_ERRINFO_INT(&err_info);
                 return err_info;
             }
-        } else if (user_order_list && (edit_node->schema->nodetype == LYS_LIST) && !strcmp(attr->name, "key") &&
-                !strcmp(attr->annotation->module->name, "yang")) {
-            k_or_val = attr->value_str;
-        } else if (user_order_list && (edit_node->schema->nodetype == LYS_LEAFLIST) && !strcmp(attr->name, "value") &&
-                !strcmp(attr->annotation->module->name, "yang")) {
-            k_or_val = attr->value_str;
+            break;
+        case EDIT_ATTR_KEY:
+            if (user_order_list && (edit_node->schema->nodetype == LYS_LIST)) {
+                k_or_val = attr->value_str;
+            }
+            break;
+        case EDIT_ATTR_VALUE:
+            if (user_order_list && (edit_node->schema->nodetype == LYS_LEAFLIST)) {
+                k_or_val = attr->value_str;
+            }
+            break;
+        default:
+            break;
         }
     }
 
@@ -657,12 +760,8 @@ sr_edit_find_oper(const struct lyd_node *edit, int recursive, int *own_oper)
         *own_oper = 1;
     }
     do {
-        for (attr = edit->attr; attr; attr = attr->next) {
-            if (!strcmp(attr->name, "operation")) {
-                if (!strcmp(attr->annotation->module->name, SR_YANG_MOD) || !strcmp(attr->annotation->module->name, "ietf-netconf")) {
-                    return sr_edit_str2op(attr->value_str);
-                }
-            }
+        if ((attr = sr_edit_attr_find(edit, EDIT_ATTR_OPER))) {
+            return sr_edit_str2op(attr->value_str);
         }
 
         if (!recursive) {
@@ -794,12 +893,7 @@ sr_edit_diff_get_origin(const struct lyd_node *node, const char **origin, int *o
     }
 
     for (parent = node; parent; parent = parent->parent) {
-        LY_TREE_FOR(parent->attr, attr) {
-            if (!strcmp(attr->name, "origin") && !strcmp(attr->annotation->module->name, "ietf-origin")) {
-                break;
-            }
-        }
-        if (attr) {
+        if ((attr = sr_edit_attr_find(parent, EDIT_ATTR_ORIGIN))) {
             break;
         }
     }
@@ -951,7 +1045,7 @@ sr_edit_diff_add(struct lyd_node *node, const char *attr_val, const char *prev_a
 
     if ((node_dup->schema->nodetype == LYS_LEAFLIST) && ((struct lys_node_leaflist *)node_dup->schema)->dflt && (op == EDIT_CREATE)) {
         /* default leaf-list with the same value may have been removed, so we need to merge these 2 diffs */
-        if ((err_info = sr_diff_merge_r(node_dup, op, NULL, diff_parent, diff_root, NULL))) {
+        if ((err_info = sr_diff_merge_r(node_dup, op, NULL, NULL, diff_parent, diff_root, NULL))) {
             goto error;
         }
         /* it was duplicated, so free it and do not return any diff node (since it has no children, it is okay) */
@@ -1024,18 +1118,17 @@ sr_diff_is_redundant(struct lyd_node *diff)
     if ((op == EDIT_REPLACE) && sr_ly_is_userord(diff)) {
         /* check for redundant move */
         for (attr = diff->attr; attr; attr = attr->next) {
-            if (diff->schema->nodetype == LYS_LIST) {
-                if (!strcmp(attr->name, "orig-key") && !strcmp(attr->annotation->module->name, SR_YANG_MOD)) {
-                    orig_val_attr = attr;
-                } else if (!strcmp(attr->name, "key") && !strcmp(attr->annotation->module->name, "yang")) {
-                    val_attr = attr;
-                }
-            } else {
-                if (!strcmp(attr->name, "orig-value") && !strcmp(attr->annotation->module->name, SR_YANG_MOD)) {
-                    orig_val_attr = attr;
-                } else if (!strcmp(attr->name, "value") && !strcmp(attr->annotation->module->name, "yang")) {
-                    val_attr = attr;
-                }
+            switch (sr_edit_attr_type(attr)) {
+            case EDIT_ATTR_ORIG_KEY:
+            case EDIT_ATTR_ORIG_VALUE:
+                orig_val_attr = attr;
+                break;
+            case EDIT_ATTR_KEY:
+            case EDIT_ATTR_VALUE:
+                val_attr = attr;
+                break;
+            default:
+                break;
             }
         }
         assert(orig_val_attr && val_attr);
@@ -1064,11 +1157,7 @@ sr_diff_is_redundant(struct lyd_node *diff)
             return 1;
         }
     } else if ((op == EDIT_NONE) && (diff->schema->nodetype & (LYS_LEAF | LYS_LEAFLIST))) {
-        for (attr = diff->attr; attr; attr = attr->next) {
-            if (!strcmp(attr->name, "orig-dflt") && !strcmp(attr->annotation->module->name, SR_YANG_MOD)) {
-                break;
-            }
-        }
+        attr = sr_edit_attr_find(diff, EDIT_ATTR_ORIG_DFLT);
 
         /* if previous and current dflt flags are the same, this node is redundant */
         if ((attr && diff->dflt) || (!attr && !diff->dflt)) {
@@ -1845,7 +1934,7 @@ sr_edit_mod_apply(const struct lyd_node *edit, const struct lys_module *ly_mod,
             if (!*diff) {
                 *diff = mod_diff;
             } else {
-                if ((err_info = sr_diff_merge_r(mod_diff, EDIT_CONTINUE, NULL, NULL, diff, NULL))) {
+                if ((err_info = sr_diff_merge_r(mod_diff, EDIT_CONTINUE, NULL, NULL, NULL, diff, NULL))) {
                     return err_info;
                 }
                 lyd_free_withsiblings(mod_diff);
@@ -1856,6 +1945,469 @@ sr_edit_mod_apply(const struct lyd_node *edit, const struct lys_module *ly_mod,
     return NULL;
 }
 
+/** initial size of diff index hash table */
+#define SR_DIFF_IDX_SIZE 256
+
+/**
+ * @brief Check whether a node is a state (leaf-)list instance kept in a diff index.
+ *
+ * @param[in] node Node to check.
+ * @return 0 if not, non-zero if it is.
+ */
+static int
+sr_diff_idx_is_indexed(const struct lyd_node *node)
+{
+    return (node->schema->flags & LYS_CONFIG_R) && (node->schema->nodetype & (LYS_LIST | LYS_LEAFLIST));
+}
+
+/**
+ * @brief Check whether an indexed diff node may change its index position while being merged. Keyless list
+ * instances are matched based on all their descendants and user-ordered instances can be moved.
+ *
+ * @param[in] node Indexed node to check.
+ * @return 0 if not, non-zero if it may.
+ */
+static int
+sr_diff_idx_is_volatile(const struct lyd_node *node)
+{
+    return ((node->schema->nodetype == LYS_LIST) && !((struct lys_node_list *)node->schema)->keys_size) ||
+            sr_ly_is_userord(node);
+}
+
+/**
+ * @brief Add data into Jenkin's one-at-a-time hash.
+ *
+ * @param[in] hash Current hash.
+ * @param[in] data Data to add.
+ * @param[in] len Length of @p data.
+ * @return Updated hash.
+ */
+static uint32_t
+sr_diff_idx_hash_add(uint32_t hash, const void *data, size_t len)
+{
+    const uint8_t *ptr = data;
+    size_t i;
+
+    for (i = 0; i < len; ++i) {
+        hash += ptr[i];
+        hash += (hash << 10);
+        hash ^= (hash >> 6);
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Add a subtree into Jenkin's one-at-a-time hash, all the descendant nodes and their values are hashed.
+ *
+ * @param[in] hash Current hash.
+ * @param[in] node Subtree to add.
+ * @return Updated hash.
+ */
+static uint32_t
+sr_diff_idx_hash_subtree(uint32_t hash, const struct lyd_node *node)
+{
+    const struct lyd_node *child;
+    const char *val_str;
+
+    hash = sr_diff_idx_hash_add(hash, &node->schema, sizeof node->schema);
+
+    switch (node->schema->nodetype) {
+    case LYS_LEAF:
+    case LYS_LEAFLIST:
+        val_str = sr_ly_leaf_value_str(node);
+        hash = sr_diff_idx_hash_add(hash, val_str, strlen(val_str));
+        break;
+    case LYS_CONTAINER:
+    case LYS_LIST:
+        LY_TREE_FOR(node->child, child) {
+            hash = sr_diff_idx_hash_subtree(hash, child);
+        }
+        break;
+    default:
+        /* anydata values are not hashed */
+        break;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Check whether 2 subtrees are equal, all the descendant nodes and their values are compared.
+ *
+ * @param[in] node1 First subtree.
+ * @param[in] node2 Second subtree.
+ * @return 0 if not, non-zero if they are.
+ */
+static int
+sr_diff_idx_subtree_equal(const struct lyd_node *node1, const struct lyd_node *node2)
+{
+    const struct lyd_node *child1, *child2;
+
+    if (node1->schema != node2->schema) {
+        return 0;
+    }
+
+    switch (node1->schema->nodetype) {
+    case LYS_LEAF:
+    case LYS_LEAFLIST:
+        return !strcmp(sr_ly_leaf_value_str(node1), sr_ly_leaf_value_str(node2));
+    case LYS_CONTAINER:
+    case LYS_LIST:
+        for (child1 = node1->child, child2 = node2->child; child1 && child2; child1 = child1->next, child2 = child2->next) {
+            if (!sr_diff_idx_subtree_equal(child1, child2)) {
+                return 0;
+            }
+        }
+        return !child1 && !child2;
+    default:
+        return 1;
+    }
+}
+
+/**
+ * @brief Hash a state (leaf-)list instance, its leaf-list value, list keys, or all the descendants
+ * of a keyless list are hashed.
+ *
+ * @param[in] parent Diff parent of the instance.
+ * @param[in] node Instance to hash.
+ * @return Instance hash.
+ */
+static uint32_t
+sr_diff_idx_hash(const struct lyd_node *parent, const struct lyd_node *node)
+{
+    const struct lys_node_list *slist;
+    const struct lyd_node *key;
+    const char *val_str;
+    uint32_t hash = 0, i;
+
+    hash = sr_diff_idx_hash_add(hash, &parent, sizeof parent);
+    hash = sr_diff_idx_hash_add(hash, &node->schema, sizeof node->schema);
+
+    if (node->schema->nodetype == LYS_LEAFLIST) {
+        val_str = sr_ly_leaf_value_str(node);
+        hash = sr_diff_idx_hash_add(hash, val_str, strlen(val_str));
+    } else if (((struct lys_node_list *)node->schema)->keys_size) {
+        slist = (struct lys_node_list *)node->schema;
+        for (i = 0, key = node->child; (i < slist->keys_size) && key; ++i, key = key->next) {
+            val_str = sr_ly_leaf_value_str(key);
+            hash = sr_diff_idx_hash_add(hash, val_str, strlen(val_str));
+        }
+    } else {
+        LY_TREE_FOR(node->child, key) {
+            hash = sr_diff_idx_hash_subtree(hash, key);
+        }
+    }
+
+    hash += (hash << 3);
+    hash ^= (hash >> 11);
+    hash += (hash << 15);
+    return hash;
+}
+
+/**
+ * @brief Check whether 2 state (leaf-)list instances with the same parent are equal.
+ *
+ * @param[in] node1 First instance.
+ * @param[in] node2 Second instance.
+ * @return 0 if not, non-zero if they are.
+ */
+static int
+sr_diff_idx_equal(const struct lyd_node *node1, const struct lyd_node *node2)
+{
+    const struct lys_node_list *slist;
+    const struct lyd_node *key1, *key2;
+    uint32_t i;
+
+    if (node1->schema != node2->schema) {
+        return 0;
+    }
+
+    if (node1->schema->nodetype == LYS_LEAFLIST) {
+        return !strcmp(sr_ly_leaf_value_str(node1), sr_ly_leaf_value_str(node2));
+    }
+
+    slist = (struct lys_node_list *)node1->schema;
+    if (!slist->keys_size) {
+        return sr_diff_idx_subtree_equal(node1, node2);
+    }
+    for (i = 0, key1 = node1->child, key2 = node2->child; i < slist->keys_size; ++i, key1 = key1->next, key2 = key2->next) {
+        if (!key1 || !key2) {
+            return !key1 && !key2;
+        }
+        if (strcmp(sr_ly_leaf_value_str(key1), sr_ly_leaf_value_str(key2))) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/**
+ * @brief Find an entry in a diff index.
+ *
+ * @param[in] idx Diff index.
+ * @param[in] parent Diff parent of the instance.
+ * @param[in] node Instance to find.
+ * @param[in] hash Hash of @p node.
+ * @param[out] prev_p Optional previous entry in the bucket, NULL if the entry is first.
+ * @return Found entry, NULL if not found.
+ */
+static struct sr_diff_idx_entry *
+sr_diff_idx_entry_find(struct sr_diff_idx *idx, const struct lyd_node *parent, const struct lyd_node *node, uint32_t hash,
+        struct sr_diff_idx_entry **prev_p)
+{
+    struct sr_diff_idx_entry *entry, *prev = NULL;
+
+    for (entry = idx->buckets[hash & (idx->size - 1)]; entry; prev = entry, entry = entry->next) {
+        if ((entry->hash == hash) && (entry->first->node->parent == parent) && sr_diff_idx_equal(entry->first->node, node)) {
+            break;
+        }
+    }
+
+    if (prev_p) {
+        *prev_p = prev;
+    }
+    return entry;
+}
+
+/**
+ * @brief Add a diff node into a diff index, keeping the equal instances in their sibling order.
+ *
+ * @param[in] idx Diff index.
+ * @param[in] node Diff node to add.
+ * @param[in] is_last Whether @p node is known to follow all its equal siblings.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_diff_idx_add(struct sr_diff_idx *idx, struct lyd_node *node, int is_last)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_diff_idx_entry *entry, *next, **buckets;
+    struct sr_diff_idx_inst *inst, *prev_inst;
+    const struct lyd_node *sibling;
+    uint32_t hash, i;
+
+    if (idx->count == idx->size) {
+        /* rehash into a larger table */
+        buckets = calloc(idx->size * 2, sizeof *buckets);
+        SR_CHECK_MEM_RET(!buckets, err_info);
+
+        for (i = 0; i < idx->size; ++i) {
+            for (entry = idx->buckets[i]; entry; entry = next) {
+                next = entry->next;
+                entry->next = buckets[entry->hash & (idx->size * 2 - 1)];
+                buckets[entry->hash & (idx->size * 2 - 1)] = entry;
+            }
+        }
+        free(idx->buckets);
+        idx->buckets = buckets;
+        idx->size *= 2;
+    }
+
+    inst = malloc(sizeof *inst);
+    SR_CHECK_MEM_RET(!inst, err_info);
+    inst->node = node;
+    inst->next = NULL;
+
+    hash = sr_diff_idx_hash(node->parent, node);
+    entry = sr_diff_idx_entry_find(idx, node->parent, node, hash, NULL);
+    if (entry) {
+        /* find the closest preceding equal instance */
+        prev_inst = is_last ? entry->last : NULL;
+        for (sibling = node->prev; !prev_inst && sibling->next; sibling = sibling->prev) {
+            for (prev_inst = entry->first; prev_inst && (prev_inst->node != sibling); prev_inst = prev_inst->next) {}
+        }
+
+        /* insert after it */
+        if (prev_inst) {
+            inst->next = prev_inst->next;
+            prev_inst->next = inst;
+        } else {
+            inst->next = entry->first;
+            entry->first = inst;
+        }
+        if (entry->last == prev_inst) {
+            entry->last = inst;
+        }
+        return NULL;
+    }
+
+    /* new entry */
+    entry = malloc(sizeof *entry);
+    if (!entry) {
+        free(inst);
+        SR_ERRINFO_MEM(&err_info);
+        return err_info;
+    }
+    entry->hash = hash;
+    entry->first = inst;
+    entry->last = inst;
+    entry->next = idx->buckets[hash & (idx->size - 1)];
+    idx->buckets[hash & (idx->size - 1)] = entry;
+    ++idx->count;
+
+    return NULL;
+}
+
+/**
+ * @brief Add all the state (leaf-)list instances in a diff subtree into a diff index.
+ *
+ * @param[in] idx Diff index.
+ * @param[in] subtree Diff subtree to add, must follow all the instances equal to those in it.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_diff_idx_add_r(struct sr_diff_idx *idx, struct lyd_node *subtree)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *next, *elem;
+
+    if (!idx->built) {
+        /* will be added when the index is built */
+        return NULL;
+    }
+
+    LY_TREE_DFS_BEGIN(subtree, next, elem) {
+        if (sr_diff_idx_is_indexed(elem) && (err_info = sr_diff_idx_add(idx, elem, 1))) {
+            return err_info;
+        }
+        LY_TREE_DFS_END(subtree, next, elem);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Remove a diff node from a diff index.
+ *
+ * @param[in] idx Diff index.
+ * @param[in] node Indexed diff node to remove.
+ */
+static void
+sr_diff_idx_del(struct sr_diff_idx *idx, struct lyd_node *node)
+{
+    struct sr_diff_idx_entry *entry, *prev;
+    struct sr_diff_idx_inst *inst, *prev_inst;
+    uint32_t hash;
+
+    hash = sr_diff_idx_hash(node->parent, node);
+    entry = sr_diff_idx_entry_find(idx, node->parent, node, hash, &prev);
+    assert(entry);
+
+    /* remove the instance */
+    for (prev_inst = NULL, inst = entry->first; inst->node != node; prev_inst = inst, inst = inst->next) {}
+    if (prev_inst) {
+        prev_inst->next = inst->next;
+    } else {
+        entry->first = inst->next;
+    }
+    if (entry->last == inst) {
+        entry->last = prev_inst;
+    }
+    free(inst);
+
+    if (!entry->first) {
+        /* remove the whole entry */
+        if (prev) {
+            prev->next = entry->next;
+        } else {
+            idx->buckets[hash & (idx->size - 1)] = entry->next;
+        }
+        free(entry);
+        --idx->count;
+    }
+}
+
+/**
+ * @brief Remove all the state (leaf-)list instances in a diff subtree from a diff index.
+ * Must be called before the subtree is freed.
+ *
+ * @param[in] idx Diff index, may be NULL.
+ * @param[in] subtree Diff subtree to remove.
+ */
+static void
+sr_diff_idx_del_r(struct sr_diff_idx *idx, struct lyd_node *subtree)
+{
+    struct lyd_node *next, *elem;
+
+    if (!idx || !idx->built) {
+        return;
+    }
+
+    LY_TREE_DFS_BEGIN(subtree, next, elem) {
+        if (sr_diff_idx_is_indexed(elem)) {
+            sr_diff_idx_del(idx, elem);
+        }
+        LY_TREE_DFS_END(subtree, next, elem);
+    }
+}
+
+/**
+ * @brief Find the first equal state (leaf-)list instance in a diff using its index.
+ *
+ * @param[in] idx Diff index, is built if not yet.
+ * @param[in] diff_parent Diff parent of the instance.
+ * @param[in] node Instance to find.
+ * @param[out] match_p Matching diff node, NULL if none found.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_diff_idx_find(struct sr_diff_idx *idx, const struct lyd_node *diff_parent, const struct lyd_node *node,
+        struct lyd_node **match_p)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_diff_idx_entry *entry;
+    struct lyd_node *root;
+
+    *match_p = NULL;
+
+    if (!idx->built) {
+        idx->buckets = calloc(SR_DIFF_IDX_SIZE, sizeof *idx->buckets);
+        SR_CHECK_MEM_RET(!idx->buckets, err_info);
+        idx->size = SR_DIFF_IDX_SIZE;
+        idx->built = 1;
+
+        /* index the whole diff */
+        LY_TREE_FOR(*idx->diff_root, root) {
+            if ((err_info = sr_diff_idx_add_r(idx, root))) {
+                return err_info;
+            }
+        }
+    }
+
+    entry = sr_diff_idx_entry_find(idx, diff_parent, node, sr_diff_idx_hash(diff_parent, node), NULL);
+    if (entry) {
+        *match_p = entry->first->node;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Free a diff index.
+ *
+ * @param[in] idx Diff index to free.
+ */
+static void
+sr_diff_idx_free(struct sr_diff_idx *idx)
+{
+    struct sr_diff_idx_entry *entry, *next;
+    struct sr_diff_idx_inst *inst, *next_inst;
+    uint32_t i;
+
+    for (i = 0; i < idx->size; ++i) {
+        for (entry = idx->buckets[i]; entry; entry = next) {
+            next = entry->next;
+            for (inst = entry->first; inst; inst = next_inst) {
+                next_inst = inst->next;
+                free(inst);
+            }
+            free(entry);
+        }
+    }
+    free(idx->buckets);
+}
+
 /**
  * @brief Update operations on a diff node when the new operation is NONE.
  *
@@ -1975,11 +2527,7 @@ sr_diff_merge_replace(struct lyd_node *diff_match, enum edit_op cur_op, int val_
         }
 
         /* copy the attributes */
-        for (attr = src_node->attr; attr; attr = attr->next) {
-            if (!strcmp(attr->name, "orig-key") && !strcmp(attr->annotation->module->name, SR_YANG_MOD)) {
-                break;
-            }
-        }
+        attr = sr_edit_attr_find(src_node, EDIT_ATTR_ORIG_KEY);
         assert(attr);
         if (attr->value_str[0]) {
             /* the problem here is that the anchor node cannot be a node from this stored oper diff */
@@ -1989,11 +2537,7 @@ sr_diff_merge_replace(struct lyd_node *diff_match, enum edit_op cur_op, int val_
             }
             if (diff_sibling) {
                 /* use anchor node of the node that was already in this stored oper diff instead */
-                for (attr = diff_sibling->attr; attr; attr = attr->next) {
-                    if (!strcmp(attr->name, "key") && !strcmp(attr->annotation->module->name, "yang")) {
-                        break;
-                    }
-                }
+                attr = sr_edit_attr_find(diff_sibling, EDIT_ATTR_KEY);
             }
         }
         if (!lyd_insert_attr(diff_match, NULL, "yang:key", key_or_value) ||
@@ -2147,19 +2691,25 @@ sr_diff_find_oper(struct lyd_node *diff, int *op_own, sr_cid_t *cid, int *attr_o
 
     for (parent = diff; parent; parent = parent->parent) {
         for (attr = parent->attr; attr; attr = attr->next) {
-            if (!op && !strcmp(attr->name, "operation")) {
-                if (!strcmp(attr->annotation->module->name, SR_YANG_MOD) || !strcmp(attr->annotation->module->name, "ietf-netconf")) {
+            switch (sr_edit_attr_type(attr)) {
+            case EDIT_ATTR_OPER:
+                if (!op) {
                     op = sr_edit_str2op(attr->value_str);
                     if (op_own && (parent == diff)) {
                         *op_own = 1;
                     }
                 }
-            }
-            if (!cid_attr && !strcmp(attr->name, "cid") && !strcmp(attr->annotation->module->name, SR_YANG_MOD)) {
-                cid_attr = attr;
-                if (attr_own && (parent == diff)) {
-                    *attr_own = 1;
+                break;
+            case EDIT_ATTR_CID:
+                if (!cid_attr) {
+                    cid_attr = attr;
+                    if (attr_own && (parent == diff)) {
+                        *attr_own = 1;
+                    }
                 }
+                break;
+            default:
+                break;
             }
         }
 
@@ -2186,12 +2736,13 @@ sr_diff_find_oper(struct lyd_node *diff, int *op_own, sr_cid_t *cid, int *attr_o
  * @param[in] cur_own_op Whether \p cur_op is owned or inherited.
  * @param[in] val_equal Whether even values of the nodes match.
  * @param[in] src_node Current source diff node.
+ * @param[in] idx Optional diff state instance index to update.
  * @param[out] change Set if there are some data changes.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
 sr_diff_merge_delete(struct lyd_node *diff_match, enum edit_op cur_op, int cur_own_op, int val_equal,
-        const struct lyd_node *src_node, int *change)
+        const struct lyd_node *src_node, struct sr_diff_idx *idx, int *change)
 {
     sr_error_info_t *err_info = NULL;
     struct lyd_node *next, *child, *src;
@@ -2236,6 +2787,7 @@ sr_diff_merge_delete(struct lyd_node *diff_match, enum edit_op cur_op, int cur_o
         LY_TREE_FOR_SAFE(sr_lyd_child(diff_match, 1), next, child) {
             lyd_find_sibling(sr_lyd_child(src_node, 1), child, &src);
             if (!src) {
+                sr_diff_idx_del_r(idx, child);
                 lyd_free(child);
             }
         }
@@ -2345,17 +2897,18 @@ sr_diff_check_cid_conn(struct lyd_node *diff_node, sr_cid_t cur_cid, int cur_att
  * @param[in] src_node Source diff node.
  * @param[in] parent_op Parent operation.
  * @param[in] oper_conn Connection pointer in case it is operational diff. Otherwise should be NULL.
+ * @param[in] idx Optional diff state instance index to use for finding state (leaf-)list instances.
  * @param[in] diff_parent Current sysrepo diff parent.
  * @param[in,out] diff_root Sysrepo diff root node.
  * @param[out] change Set if there are some data changes.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_diff_merge_r(const struct lyd_node *src_node, enum edit_op parent_op, sr_conn_ctx_t *oper_conn, struct lyd_node *diff_parent,
-        struct lyd_node **diff_root, int *change)
+sr_diff_merge_r(const struct lyd_node *src_node, enum edit_op parent_op, sr_conn_ctx_t *oper_conn, struct sr_diff_idx *idx,
+        struct lyd_node *diff_parent, struct lyd_node **diff_root, int *change)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *child, *diff_node = NULL;
+    struct lyd_node *child, *diff_node = NULL, *reindex = NULL;
     enum edit_op src_op, cur_op;
     sr_cid_t cid;
     const char *key_or_value, *origin, *cur_origin;
@@ -2367,8 +2920,13 @@ sr_diff_merge_r(const struct lyd_node *src_node, enum edit_op parent_op, sr_conn
     }
 
     /* find an equal node in the current diff */
-    if ((err_info = sr_edit_find(diff_parent ? sr_lyd_child(diff_parent, 1) : *diff_root, src_node, src_op, INSERT_DEFAULT,
-            NULL, 0, &diff_node, &val_equal))) {
+    if (idx && sr_diff_idx_is_indexed(src_node)) {
+        if ((err_info = sr_diff_idx_find(idx, diff_parent, src_node, &diff_node))) {
+            return err_info;
+        }
+        val_equal = 1;
+    } else if ((err_info = sr_edit_find(diff_parent ? sr_lyd_child(diff_parent, 1) : *diff_root, src_node, src_op,
+            INSERT_DEFAULT, NULL, 0, &diff_node, &val_equal))) {
         return err_info;
     }
 
@@ -2380,6 +2938,12 @@ sr_diff_merge_r(const struct lyd_node *src_node, enum edit_op parent_op, sr_conn
             cur_op = sr_diff_find_oper(diff_node, &op_own, NULL, NULL);
         }
 
+        if (idx && idx->built && sr_diff_idx_is_indexed(diff_node) && sr_diff_idx_is_volatile(diff_node)) {
+            /* its descendants or position can change, index it again once merged */
+            sr_diff_idx_del(idx, diff_node);
+            reindex = diff_node;
+        }
+
         /* merge operations */
         switch (src_op) {
         case EDIT_REPLACE:
@@ -2391,6 +2955,9 @@ sr_diff_merge_r(const struct lyd_node *src_node, enum edit_op parent_op, sr_conn
             if ((cur_op == EDIT_CREATE) && (diff_node->schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) &&
                     (diff_node->schema->flags & LYS_CONFIG_R)) {
                 /* special case of creating duplicate state (leaf-)list instances */
+                if (reindex && (err_info = sr_diff_idx_add(idx, reindex, 0))) {
+                    return err_info;
+                }
                 goto add_diff;
             }
 
@@ -2399,7 +2966,7 @@ sr_diff_merge_r(const struct lyd_node *src_node, enum edit_op parent_op, sr_conn
             }
             break;
         case EDIT_DELETE:
-            if ((err_info = sr_diff_merge_delete(diff_node, cur_op, op_own, val_equal, src_node, change))) {
+            if ((err_info = sr_diff_merge_delete(diff_node, cur_op, op_own, val_equal, src_node, idx, change))) {
                 goto op_error;
             }
             break;
@@ -2437,16 +3004,23 @@ sr_diff_merge_r(const struct lyd_node *src_node, enum edit_op parent_op, sr_conn
 
         /* merge src_diff recursively */
         LY_TREE_FOR(sr_lyd_child(src_node, 1), child) {
-            if ((err_info = sr_diff_merge_r(child, src_op, oper_conn, diff_parent, diff_root, change))) {
+            if ((err_info = sr_diff_merge_r(child, src_op, oper_conn, idx, diff_parent, diff_root, change))) {
                 return err_info;
             }
         }
+
+        if (reindex && (err_info = sr_diff_idx_add(idx, reindex, 0))) {
+            return err_info;
+        }
     } else {
 add_diff:
         /* add new diff node with all descendants */
         if ((err_info = sr_diff_add(src_node, diff_parent, diff_root, &diff_node))) {
             return err_info;
         }
+        if (idx && (err_info = sr_diff_idx_add_r(idx, diff_node))) {
+            return err_info;
+        }
         if (change) {
             *change = 1;
         }
@@ -2485,6 +3059,7 @@ add_diff:
         if (diff_parent == *diff_root) {
             *diff_root = (*diff_root)->next;
         }
+        sr_diff_idx_del_r(idx, diff_parent);
         lyd_free(diff_parent);
     }
 
@@ -2502,11 +3077,15 @@ sr_diff_mod_merge(const struct lyd_node *src_diff, sr_conn_ctx_t *oper_conn, con
 {
     sr_error_info_t *err_info = NULL;
     const struct lyd_node *src_node;
+    struct sr_diff_idx idx = {0};
 
     if (change) {
         *change = 0;
     }
 
+    /* state (leaf-)list instances are found using an index built on demand */
+    idx.diff_root = diff;
+
     LY_TREE_FOR(src_diff, src_node) {
         if (lyd_node_module(src_node) != ly_mod) {
             /* skip data nodes from different modules */
@@ -2514,12 +3093,13 @@ sr_diff_mod_merge(const struct lyd_node *src_diff, sr_conn_ctx_t *oper_conn, con
         }
 
         /* apply relevant nodes from the diff datatree */
-        if ((err_info = sr_diff_merge_r(src_node, EDIT_CONTINUE, oper_conn, NULL, diff, change))) {
-            return err_info;
+        if ((err_info = sr_diff_merge_r(src_node, EDIT_CONTINUE, oper_conn, &idx, NULL, diff, change))) {
+            break;
         }
     }
 
-    return NULL;
+    sr_diff_idx_free(&idx);
+    return err_info;
 }
 
 /**
@@ -2537,47 +3117,35 @@ sr_diff_op(const struct lyd_node *diff_node, enum edit_op *op, int *op_own, cons
     sr_error_info_t *err_info = NULL;
     struct lyd_attr *attr = NULL;
     const struct lyd_node *diff_parent;
-    const char *attr_name;
+    enum edit_op cur_op = 0;
 
     if (op_own) {
         *op_own = 0;
     }
 
     for (diff_parent = diff_node; diff_parent; diff_parent = diff_parent->parent) {
-        LY_TREE_FOR(diff_parent->attr, attr) {
-            if (!strcmp(attr->name, "operation")) {
-                if (!strcmp(attr->annotation->module->name, SR_YANG_MOD)) {
-                    /* okay, nothing more to check */
-                } else if (!strcmp(attr->annotation->module->name, "ietf-netconf")) {
-                    if (!strcmp(attr->value_str, "replace") && (diff_parent != diff_node)) {
-                        /* we do not care about this operation if it's in our parent */
-                        continue;
-                    }
-                }
-                break;
+        if ((attr = sr_edit_attr_find(diff_parent, EDIT_ATTR_OPER))) {
+            cur_op = sr_edit_str2op(attr->value_str);
+            if ((cur_op == EDIT_REPLACE) && (diff_parent != diff_node)) {
+                /* we do not care about this operation if it's in our parent */
+                continue;
             }
-        }
-        if (attr) {
             break;
         }
     }
-    SR_CHECK_INT_RET(!attr, err_info);
+    SR_CHECK_INT_RET(!diff_parent, err_info);
 
     if (op) {
-        if (!strcmp(attr->annotation->module->name, SR_YANG_MOD)) {
-            assert(!strcmp(attr->value_str, "none"));
-            *op = EDIT_NONE;
-        } else if (!strcmp(attr->annotation->module->name, "ietf-netconf")) {
-            if (!strcmp(attr->value_str, "create")) {
-                *op = EDIT_CREATE;
-            } else if (!strcmp(attr->value_str, "delete")) {
-                *op = EDIT_DELETE;
-            } else if (!strcmp(attr->value_str, "replace")) {
-                *op = EDIT_REPLACE;
-            } else {
-                SR_ERRINFO_INT(&err_info);
-                return err_info;
-            }
+        switch (cur_op) {
+        case EDIT_NONE:
+        case EDIT_CREATE:
+        case EDIT_DELETE:
+        case EDIT_REPLACE:
+            *op = cur_op;
+            break;
+        default:
+            SR_ERRINFO_INT(&err_info);
+            return err_info;
         }
     }
     if (op_own && (diff_parent == diff_node)) {
@@ -2587,20 +3155,10 @@ sr_diff_op(const struct lyd_node *diff_node, enum edit_op *op, int *op_own, cons
     if (key_or_value) {
         *key_or_value = NULL;
         if (sr_ly_is_userord(diff_node)) {
-            if ((*op == EDIT_CREATE) || (*op == EDIT_REPLACE)) {
-                if (diff_node->schema->nodetype == LYS_LIST) {
-                    attr_name = "key";
-                } else {
-                    attr_name = "value";
-                }
-
-                LY_TREE_FOR(diff_node->attr, attr) {
-                    if (!strcmp(attr->name, attr_name) && !strcmp(attr->annotation->module->name, "yang")) {
-                        *key_or_value = attr->value_str;
-                        break;
-                    }
-                }
+            if ((cur_op == EDIT_CREATE) || (cur_op == EDIT_REPLACE)) {
+                attr = sr_edit_attr_find(diff_node, (diff_node->schema->nodetype == LYS_LIST) ? EDIT_ATTR_KEY : EDIT_ATTR_VALUE);
                 SR_CHECK_INT_RET(!attr, err_info);
+                *key_or_value = attr->value_str;
             }
         }
     }
@@ -3000,6 +3558,146 @@ sr_diff_mod_update(struct lyd_node **diff, const struct lys_module *ly_mod, cons
     return NULL;
 }
 
+/**
+ * @brief Change a sysrepo diff subtree into an edit applicable on any data tree, recursively.
+ * Created and replaced nodes are merged, deleted nodes removed, and unchanged parents may be missing.
+ *
+ * @param[in] diff_node Sysrepo diff node to change.
+ * @param[in] with_order Whether to keep the position of created and moved user-ordered (leaf-)list instances.
+ * @param[out] change Set if the subtree creates or changes some nodes.
+ * @param[out] anchored Set if some user-ordered instance is positioned relative to another instance.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_diff_rebase_edit_r(struct lyd_node *diff_node, int with_order, int *change, int *anchored)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *next, *diff_child;
+    struct lyd_attr *attr, *next_attr, *anchor_attr = NULL;
+    enum edit_op op;
+    const char *key_or_value, *edit_op = NULL, *insert = NULL;
+    int op_own, child_change = 0;
+
+    /* children first, they inherit the original operations of their parents */
+    LY_TREE_FOR_SAFE(sr_lyd_child(diff_node, 1), next, diff_child) {
+        if ((err_info = sr_diff_rebase_edit_r(diff_child, with_order, &child_change, anchored))) {
+            return err_info;
+        }
+    }
+    if (child_change) {
+        *change = 1;
+    }
+
+    if ((err_info = sr_diff_op(diff_node, &op, &op_own, &key_or_value))) {
+        return err_info;
+    }
+
+    switch (op) {
+    case EDIT_CREATE:
+    case EDIT_REPLACE:
+        /* the diff values win over the current ones */
+        if (op_own) {
+            edit_op = "merge";
+        }
+        *change = 1;
+
+        if (key_or_value && with_order) {
+            if (key_or_value[0]) {
+                anchor_attr = sr_edit_attr_find(diff_node,
+                        (diff_node->schema->nodetype == LYS_LIST) ? EDIT_ATTR_KEY : EDIT_ATTR_VALUE);
+                insert = "after";
+                *anchored = 1;
+            } else {
+                insert = "first";
+            }
+        }
+        break;
+    case EDIT_DELETE:
+        /* the node may have been deleted meanwhile */
+        if (op_own) {
+            edit_op = "remove";
+        }
+        break;
+    case EDIT_NONE:
+        /* a parent of some changes, it needs to exist only if some of them are creating nodes */
+        edit_op = child_change ? "merge" : "ether";
+        break;
+    default:
+        SR_ERRINFO_INT(&err_info);
+        return err_info;
+    }
+
+    /* remove all the diff attributes except the anchor */
+    LY_TREE_FOR_SAFE(diff_node->attr, next_attr, attr) {
+        if (attr != anchor_attr) {
+            lyd_free_attr(diff_node->schema->module->ctx, diff_node, attr, 0);
+        }
+    }
+
+    /* add the edit attributes */
+    if (edit_op && (err_info = sr_edit_set_oper(diff_node, edit_op))) {
+        return err_info;
+    }
+    if (insert && !lyd_insert_attr(diff_node, NULL, "yang:insert", insert)) {
+        sr_errinfo_new_ly(&err_info, lyd_node_module(diff_node)->ctx);
+        return err_info;
+    }
+
+    return NULL;
+}
+
+sr_error_info_t *
+sr_diff_mod_rebase(const struct lyd_node *diff, const struct lys_module *ly_mod, struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *edit = NULL, *root, *mod_data = NULL;
+    int with_order, change, anchored;
+
+    for (with_order = 1; with_order >= 0; --with_order) {
+        /* create an edit from the diff */
+        edit = lyd_dup_withsiblings(diff, LYD_DUP_OPT_RECURSIVE);
+        SR_CHECK_MEM_GOTO(!edit, err_info, cleanup);
+        anchored = 0;
+        LY_TREE_FOR(edit, root) {
+            change = 0;
+            if ((err_info = sr_diff_rebase_edit_r(root, with_order, &change, &anchored))) {
+                goto cleanup;
+            }
+        }
+
+        if (!anchored) {
+            /* the edit cannot fail because of missing instances, apply it directly */
+            err_info = sr_edit_mod_apply(edit, ly_mod, data, NULL, NULL);
+            goto cleanup;
+        }
+
+        /* apply it on a copy, the anchor instances may no longer exist */
+        if (*data) {
+            mod_data = lyd_dup_withsiblings(*data, LYD_DUP_OPT_RECURSIVE);
+            SR_CHECK_MEM_GOTO(!mod_data, err_info, cleanup);
+        }
+        if (!(err_info = sr_edit_mod_apply(edit, ly_mod, &mod_data, NULL, NULL))) {
+            break;
+        }
+
+        /* try again without keeping the order, the instances are simply appended */
+        sr_errinfo_free(&err_info);
+        lyd_free_withsiblings(mod_data);
+        mod_data = NULL;
+        lyd_free_withsiblings(edit);
+        edit = NULL;
+    }
+
+    lyd_free_withsiblings(*data);
+    *data = mod_data;
+    mod_data = NULL;
+
+cleanup:
+    lyd_free_withsiblings(edit);
+    lyd_free_withsiblings(mod_data);
+    return err_info;
+}
+
 sr_error_info_t *
 sr_ly_val_diff_merge(struct lyd_node **diff, LYD_DIFFTYPE type, struct lyd_node *first, struct lyd_node *second,
         struct ly_ctx *ly_ctx, int *change)
@@ -3068,13 +3766,13 @@ sr_ly_val_diff_merge(struct lyd_node **diff, LYD_DIFFTYPE type, struct lyd_node
                 LY_TREE_DFS_END(tmp, next, elem);
             }
 
-            if ((err_info = sr_diff_merge_r(tmp, EDIT_CREATE, NULL, diff_parent, diff, change))) {
+            if ((err_info = sr_diff_merge_r(tmp, EDIT_CREATE, NULL, NULL, diff_parent, diff, change))) {
                 return err_info;
             }
         }
     } else {
         LY_TREE_FOR(first, tmp) {
-            if ((err_info = sr_diff_merge_r(tmp, EDIT_DELETE, NULL, diff_parent, diff, change))) {
+            if ((err_info = sr_diff_merge_r(tmp, EDIT_DELETE, NULL, NULL, diff_parent, diff, change))) {
                 return err_info;
             }
         }
@@ -3344,7 +4042,8 @@ op_error:
 }
 
 static sr_error_info_t *
-sr_edit_add_check_same_node_op(sr_session_ctx_t *session, const char *xpath, const char *value, enum edit_op op)
+sr_edit_add_check_same_node_op(sr_session_ctx_t *session, struct lyd_node *ctx_node, const char *xpath,
+        const char *value, enum edit_op op)
 {
     sr_error_info_t *err_info = NULL;
     char *uniq_xpath;
@@ -3367,7 +4066,7 @@ sr_edit_add_check_same_node_op(sr_session_ctx_t *session, const char *xpath, con
         }
 
         /* find the node */
-        set = lyd_find_path(session->dt[session->ds].edit, uniq_xpath);
+        set = lyd_find_path(ctx_node, uniq_xpath);
         free(uniq_xpath);
         if (!set || (set->number > 1)) {
             ly_set_free(set);
@@ -3392,31 +4091,42 @@ sr_edit_add_check_same_node_op(sr_session_ctx_t *session, const char *xpath, con
 }
 
 sr_error_info_t *
-sr_edit_add(sr_session_ctx_t *session, const char *xpath, const char *value, const char *operation,
-        const char *def_operation, const sr_move_position_t *position, const char *keys, const char *val,
-        const char *origin, int isolate)
+sr_edit_add(sr_session_ctx_t *session, struct lyd_node *ctx_node, const char *xpath, const char *value,
+        const char *operation, const char *def_operation, const sr_move_position_t *position, const char *keys,
+        const char *val, const char *origin, int isolate, struct lyd_node **node_p)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *node, *sibling, *parent;
+    struct lyd_node *node, *new_node, *sibling, *parent;
     const char *attr_val, *def_origin;
     const struct lys_module *ly_mod;
     enum edit_op op, def_op;
     int opts, own_oper, next_iter_oper, is_sup;
 
+    assert(!ctx_node || !isolate);
+
+    if (node_p) {
+        *node_p = NULL;
+    }
+    if (!ctx_node && !isolate) {
+        ctx_node = session->dt[session->ds].edit;
+    }
+
     /* merge the change into existing edit */
     opts = LYD_PATH_OPT_NOPARENTRET;
     if (!strcmp(operation, "remove") || !strcmp(operation, "delete") || !strcmp(operation, "purge")) {
         opts |= LYD_PATH_OPT_EDIT;
     }
-    node = lyd_new_path(isolate ? NULL : session->dt[session->ds].edit, session->conn->ly_ctx, xpath, (void *)value, 0, opts);
+    node = lyd_new_path(ctx_node, session->conn->ly_ctx, xpath, (void *)value, 0, opts);
     if (!node) {
         /* check whether it is an error */
-        if ((err_info = sr_edit_add_check_same_node_op(session, xpath, value, sr_edit_str2op(operation)))) {
+        if ((err_info = sr_edit_add_check_same_node_op(session, isolate ? session->dt[session->ds].edit : ctx_node,
+                xpath, value, sr_edit_str2op(operation)))) {
             goto error;
         }
         /* node with the same operation already exists, silently ignore */
         return NULL;
     }
+    new_node = node;
 
     /* check alllowed node types */
     for (parent = node; parent; parent = parent->parent) {
@@ -3602,6 +4312,9 @@ sr_edit_add(sr_session_ctx_t *session, const char *xpath, const char *value, con
         }
     }
 
+    if (node_p) {
+        *node_p = new_node;
+    }
     return NULL;
 
 error:
@@ -3628,36 +4341,28 @@ sr_error_info_t *
 sr_diff_set_getnext(struct ly_set *set, uint32_t *idx, struct lyd_node **node, sr_change_oper_t *op)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_attr *attr;
-    struct lyd_node *parent;
+    enum edit_op edit_op;
 
     while (*idx < set->number) {
         *node = set->set.d[*idx];
 
         /* find the (inherited) operation of the current edit node */
-        attr = NULL;
-        for (parent = *node; parent; parent = parent->parent) {
-            for (attr = parent->attr; attr && strcmp(attr->name, "operation"); attr = attr->next) {}
-            if (attr) {
-                break;
-            }
-        }
-        if (!attr) {
+        edit_op = sr_edit_find_oper(*node, 1, NULL);
+        if (!edit_op) {
             SR_ERRINFO_INT(&err_info);
             return err_info;
         }
 
         if (lys_is_key((struct lys_node_leaf *)(*node)->schema, NULL) && sr_ly_is_userord((*node)->parent) &&
-                (attr->value_str[0] == 'r')) {
+                (edit_op == EDIT_REPLACE)) {
             /* skip keys of list move operations */
             ++(*idx);
             continue;
         }
 
         /* decide operation */
-        if (attr->value_str[0] == 'n') {
-            assert(!strcmp(attr->annotation->module->name, SR_YANG_MOD));
-            assert(!strcmp(attr->value_str, "none"));
+        switch (edit_op) {
+        case EDIT_NONE:
             /* skip the node */
             ++(*idx);
 
@@ -3666,17 +4371,13 @@ sr_diff_set_getnext(struct ly_set *set, uint32_t *idx, struct lyd_node **node, s
                 *idx += ((struct lys_node_list *)(*node)->schema)->keys_size;
             }
             continue;
-        } else if (attr->value_str[0] == 'c') {
-            assert(!strcmp(attr->annotation->module->name, "ietf-netconf"));
-            assert(!strcmp(attr->value_str, "create"));
+        case EDIT_CREATE:
             *op = SR_OP_CREATED;
-        } else if (attr->value_str[0] == 'd') {
-            assert(!strcmp(attr->annotation->module->name, "ietf-netconf"));
-            assert(!strcmp(attr->value_str, "delete"));
+            break;
+        case EDIT_DELETE:
             *op = SR_OP_DELETED;
-        } else if (attr->value_str[0] == 'r') {
-            assert(!strcmp(attr->annotation->module->name, "ietf-netconf"));
-            assert(!strcmp(attr->value_str, "replace"));
+            break;
+        case EDIT_REPLACE:
             if ((*node)->schema->nodetype & (LYS_LEAF | LYS_ANYXML | LYS_ANYDATA)) {
                 *op = SR_OP_MODIFIED;
             } else if ((*node)->schema->nodetype & (LYS_LIST | LYS_LEAFLIST)) {
@@ -3685,6 +4386,10 @@ sr_diff_set_getnext(struct ly_set *set, uint32_t *idx, struct lyd_node **node, s
                 SR_ERRINFO_INT(&err_info);
                 return err_info;
             }
+            break;
+        default:
+            SR_ERRINFO_INT(&err_info);
+            return err_info;
         }
 
         /* success */
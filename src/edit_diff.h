@@ -50,6 +50,31 @@ enum edit_op {
     EDIT_REMOVE
 };
 
+/**
+ * @brief Internal attributes of edit and diff nodes.
+ */
+enum edit_attr {
+    EDIT_ATTR_UNKNOWN = 0,  /**< not an internal attribute */
+    EDIT_ATTR_OPER,         /**< ietf-netconf:operation or sysrepo:operation */
+    EDIT_ATTR_INSERT,       /**< yang:insert */
+    EDIT_ATTR_KEY,          /**< yang:key */
+    EDIT_ATTR_VALUE,        /**< yang:value */
+    EDIT_ATTR_ORIG_KEY,     /**< sysrepo:orig-key */
+    EDIT_ATTR_ORIG_VALUE,   /**< sysrepo:orig-value */
+    EDIT_ATTR_ORIG_DFLT,    /**< sysrepo:orig-dflt */
+    EDIT_ATTR_CID,          /**< sysrepo:cid */
+    EDIT_ATTR_ORIGIN        /**< ietf-origin:origin */
+};
+
+/**
+ * @brief Learn the type of an edit/diff node attribute. The module is decided based on its name, which is compared
+ * only once, and the attribute name based on the known annotations of every module.
+ *
+ * @param[in] attr Attribute to examine.
+ * @return Attribute type.
+ */
+enum edit_attr sr_edit_attr_type(const struct lyd_attr *attr);
+
 /**
  * @brief Set an operation (attribute) for an edit node.
  *
@@ -155,6 +180,17 @@ sr_error_info_t *sr_diff_mod_apply(const struct lyd_node *diff, const struct lys
  */
 sr_error_info_t *sr_diff_mod_update(struct lyd_node **diff, const struct lys_module *ly_mod, const struct lyd_node *mod_data);
 
+/**
+ * @brief Apply sysrepo diff on a specific module data tree that can differ from the data the diff was created on.
+ * Changes in the diff override any conflicting changes in the data.
+ *
+ * @param[in] diff Diff tree to apply.
+ * @param[in] ly_mod Data tree module.
+ * @param[in,out] data Data tree to modify.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_diff_mod_rebase(const struct lyd_node *diff, const struct lys_module *ly_mod, struct lyd_node **data);
+
 /**
  * @brief Merge libyang validation diff into sysrepo diff.
  *
@@ -182,6 +218,7 @@ sr_error_info_t *sr_diff_ly2sr(struct lyd_difflist *ly_diff, struct lyd_node **d
  * @brief Add change into sysrepo edit.
  *
  * @param[in] session Session to use.
+ * @param[in] ctx_node Optional edit node, @p xpath is relative to it. Cannot be set with @p isolate.
  * @param[in] xpath XPath of the change node.
  * @param[in] value Value of the change node.
  * @param[in] operation Operation of the change node.
@@ -191,11 +228,12 @@ sr_error_info_t *sr_diff_ly2sr(struct lyd_difflist *ly_diff, struct lyd_node **d
  * @param[in] val Optional relative leaf-list value for move change.
  * @param[in] origin Origin of the value, used only for ::SR_DS_OPERATIONAL.
  * @param[in] isolate Whether to create the new operation separately (isolated) from the others.
+ * @param[out] node_p Optional created edit node, NULL if the same change already was in the edit.
  * @return err_info, NULL on success.
  */
-sr_error_info_t *sr_edit_add(sr_session_ctx_t *session, const char *xpath, const char *value, const char *operation,
-        const char *def_operation, const sr_move_position_t *position, const char *keys, const char *val,
-        const char *origin, int isolate);
+sr_error_info_t *sr_edit_add(sr_session_ctx_t *session, struct lyd_node *ctx_node, const char *xpath, const char *value,
+        const char *operation, const char *def_operation, const sr_move_position_t *position, const char *keys,
+        const char *val, const char *origin, int isolate, struct lyd_node **node_p);
 
 /**
  * @brief Get next change from a sysrepo diff set.
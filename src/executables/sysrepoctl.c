@@ -23,6 +23,7 @@
 #define _XOPEN_SOURCE 500 /* strdup */
 
 #include <assert.h>
+#include <errno.h>
 #include <getopt.h>
 #include <stdarg.h>
 #include <stdint.h>
@@ -58,6 +59,12 @@ struct list_item {
     char *features;
 };
 
+struct install_item {
+    char *path;
+    char **features;
+    int feat_count;
+};
+
 static void
 version_print(void)
 {
@@ -79,6 +86,11 @@ help_print(void)
             "  -V, --version        Print only information about sysrepo version.\n"
             "  -l, --list           List YANG modules in sysrepo.\n"
             "  -i, --install <path> Install the specified schema into sysrepo. Can be in either YANG or YIN format.\n"
+            "                       Can be specified multiple times, all the schemas are then installed at once.\n"
+            "  -I, --install-manifest <path>\n"
+            "                       Install all the schemas listed in a manifest file at once. Every line of the file\n"
+            "                       is in the format \"<path> [<feature-name>]*\", empty lines and lines starting with '#'\n"
+            "                       are ignored. Can be combined with \"-i\".\n"
             "  -u, --uninstall <module>[,<module2>,<module3> ...]\n"
             "                       Uninstall the specified module(s) from sysrepo.\n"
             "  -c, --change <module>\n"
@@ -94,6 +106,7 @@ help_print(void)
             "                       modules is always searched (install, update op).\n"
             "  -e, --enable-feature <feature-name>\n"
             "                       Enabled specific feature. Can be specified multiple times (install, change op).\n"
+            "                       For install op, it applies to the preceding schema or the first one if none precedes.\n"
             "  -d, --disable-feature <feature-name>\n"
             "                       Disable specific feature. Can be specified multiple times (change op).\n"
             "  -r, --replay <state> Change replay support (storing notifications) for this module to on/off or 1/0 (change op).\n"
@@ -409,7 +422,8 @@ cleanup:
 }
 
 /* can be changed by log_cb */
-char *inst_module_name;
+char **inst_module_names;
+int inst_module_count;
 
 static void
 log_cb(sr_log_level_t level, const char *message)
@@ -431,8 +445,111 @@ log_cb(sr_log_level_t level, const char *message)
     }
 
     /* store the newly installed/updated module name */
-    free(inst_module_name);
-    inst_module_name = strndup(message + 8, end - (message + 8));
+    inst_module_names = realloc(inst_module_names, (inst_module_count + 1) * sizeof *inst_module_names);
+    inst_module_names[inst_module_count++] = strndup(message + 8, end - (message + 8));
+}
+
+static int
+srctl_install_add(const char *path, struct install_item **inst_items, int *inst_count)
+{
+    struct install_item *item;
+
+    *inst_items = realloc(*inst_items, (*inst_count + 1) * sizeof **inst_items);
+    item = &(*inst_items)[*inst_count];
+    ++(*inst_count);
+
+    memset(item, 0, sizeof *item);
+    item->path = strdup(path);
+    if (!item->path) {
+        error_print(0, "Memory allocation failed");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int
+srctl_install_add_feature(struct install_item *item, const char *feature)
+{
+    item->features = realloc(item->features, (item->feat_count + 1) * sizeof *item->features);
+    item->features[item->feat_count] = strdup(feature);
+    if (!item->features[item->feat_count]) {
+        error_print(0, "Memory allocation failed");
+        return -1;
+    }
+    ++item->feat_count;
+
+    return 0;
+}
+
+static int
+srctl_install_manifest(const char *manifest_path, struct install_item **inst_items, int *inst_count)
+{
+    FILE *file;
+    char *line = NULL, *token, *ptr;
+    size_t line_size = 0;
+    int rc = 0;
+
+    file = fopen(manifest_path, "r");
+    if (!file) {
+        error_print(0, "Failed to open manifest \"%s\" (%s)", manifest_path, strerror(errno));
+        return -1;
+    }
+
+    while (getline(&line, &line_size, file) != -1) {
+        /* schema path */
+        token = strtok_r(line, " \t\r\n", &ptr);
+        if (!token || (token[0] == '#')) {
+            /* empty line or a comment */
+            continue;
+        }
+        if ((rc = srctl_install_add(token, inst_items, inst_count))) {
+            goto cleanup;
+        }
+
+        /* its features */
+        while ((token = strtok_r(NULL, " \t\r\n", &ptr))) {
+            if ((rc = srctl_install_add_feature(&(*inst_items)[*inst_count - 1], token))) {
+                goto cleanup;
+            }
+        }
+    }
+
+cleanup:
+    free(line);
+    fclose(file);
+    return rc;
+}
+
+static int
+srctl_install(sr_conn_ctx_t *conn, struct install_item *inst_items, int inst_count, const char *search_dirs)
+{
+    const char **paths, ***features;
+    int *feat_counts, i, r;
+
+    paths = malloc(inst_count * sizeof *paths);
+    features = malloc(inst_count * sizeof *features);
+    feat_counts = malloc(inst_count * sizeof *feat_counts);
+    if (!paths || !features || !feat_counts) {
+        error_print(0, "Memory allocation failed");
+        r = SR_ERR_NOMEM;
+        goto cleanup;
+    }
+
+    for (i = 0; i < inst_count; ++i) {
+        paths[i] = inst_items[i].path;
+        features[i] = (const char **)inst_items[i].features;
+        feat_counts[i] = inst_items[i].feat_count;
+    }
+
+    /* install all the modules in a single batch */
+    r = sr_install_modules(conn, paths, inst_count, search_dirs, features, feat_counts);
+
+cleanup:
+    free(paths);
+    free(features);
+    free(feat_counts);
+    return r;
 }
 
 int
@@ -443,13 +560,16 @@ main(int argc, char **argv)
     char **features = NULL, **dis_features = NULL, *ptr;
     mode_t perms = -1;
     sr_log_level_t log_level = SR_LL_ERR;
-    int r, i, rc = EXIT_FAILURE, opt, operation = 0, feat_count = 0, dis_feat_count = 0, replay = -1, apply = 0;
+    int r, i, j, rc = EXIT_FAILURE, opt, operation = 0, feat_count = 0, dis_feat_count = 0, replay = -1, apply = 0;
+    struct install_item *inst_items = NULL;
+    int inst_count = 0;
     uint32_t conn_count;
     struct option options[] = {
         {"help",            no_argument,       NULL, 'h'},
         {"version",         no_argument,       NULL, 'V'},
         {"list",            no_argument,       NULL, 'l'},
         {"install",         required_argument, NULL, 'i'},
+        {"install-manifest", required_argument, NULL, 'I'},
         {"uninstall",       required_argument, NULL, 'u'},
         {"change",          required_argument, NULL, 'c'},
         {"update",          required_argument, NULL, 'U'},
@@ -473,7 +593,7 @@ main(int argc, char **argv)
 
     /* process options */
     opterr = 0;
-    while ((opt = getopt_long(argc, argv, "hVli:u:c:U:Cs:e:d:r:o:g:p:av:", options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, "hVli:I:u:c:U:Cs:e:d:r:o:g:p:av:", options, NULL)) != -1) {
         switch (opt) {
         case 'h':
             version_print();
@@ -492,12 +612,24 @@ main(int argc, char **argv)
             operation = 'l';
             break;
         case 'i':
-            if (operation) {
+            if (operation && (operation != 'i')) {
                 error_print(0, "Operation already specified");
                 goto cleanup;
             }
             operation = 'i';
-            file_path = optarg;
+            if (srctl_install_add(optarg, &inst_items, &inst_count)) {
+                goto cleanup;
+            }
+            break;
+        case 'I':
+            if (operation && (operation != 'i')) {
+                error_print(0, "Operation already specified");
+                goto cleanup;
+            }
+            operation = 'i';
+            if (srctl_install_manifest(optarg, &inst_items, &inst_count)) {
+                goto cleanup;
+            }
             break;
         case 'u':
             if (operation) {
@@ -542,6 +674,13 @@ main(int argc, char **argv)
                 error_print(0, "Invalid parameter -%c for the operation", opt);
                 goto cleanup;
             }
+            if ((operation == 'i') && inst_count) {
+                /* feature of the preceding installed module */
+                if (srctl_install_add_feature(&inst_items[inst_count - 1], optarg)) {
+                    goto cleanup;
+                }
+                break;
+            }
             features = realloc(features, (feat_count + 1) * sizeof *features);
             features[feat_count++] = optarg;
             break;
@@ -637,6 +776,20 @@ main(int argc, char **argv)
         goto cleanup;
     }
 
+    if (operation == 'i') {
+        if (!inst_count) {
+            error_print(0, "No schemas to install");
+            goto cleanup;
+        }
+
+        /* features specified before any schema belong to the first one */
+        for (i = 0; i < feat_count; ++i) {
+            if (srctl_install_add_feature(&inst_items[0], features[i])) {
+                goto cleanup;
+            }
+        }
+    }
+
     /* set logging */
     sr_log_stderr(log_level);
 
@@ -662,10 +815,14 @@ main(int argc, char **argv)
         break;
     case 'i':
         /* install */
-        if ((r = sr_install_module(conn, file_path, search_dirs, (const char **)features, feat_count)) != SR_ERR_OK) {
+        if ((r = srctl_install(conn, inst_items, inst_count, search_dirs)) != SR_ERR_OK) {
             /* succeed if the module is already installed */
             if (r != SR_ERR_EXISTS) {
-                error_print(r, "Failed to install module \"%s\"", file_path);
+                if (inst_count == 1) {
+                    error_print(r, "Failed to install module \"%s\"", inst_items[0].path);
+                } else {
+                    error_print(r, "Failed to install modules");
+                }
                 goto cleanup;
             }
         }
@@ -771,18 +928,31 @@ main(int argc, char **argv)
         break;
     }
 
-    /* change permissions for a newly installed/updated module */
+    /* change permissions for all newly installed/updated modules */
     if (((operation == 'i') || (operation == 'U')) && (owner || group || ((int)perms != -1))) {
-        if ((r = sr_set_module_access(conn, inst_module_name, owner, group, perms)) != SR_ERR_OK) {
-            error_print(r, "Failed to change module \"%s\" access", inst_module_name);
-            goto cleanup;
+        for (i = 0; i < inst_module_count; ++i) {
+            if ((r = sr_set_module_access(conn, inst_module_names[i], owner, group, perms)) != SR_ERR_OK) {
+                error_print(r, "Failed to change module \"%s\" access", inst_module_names[i]);
+                goto cleanup;
+            }
         }
     }
 
     rc = EXIT_SUCCESS;
 
 cleanup:
-    free(inst_module_name);
+    for (i = 0; i < inst_module_count; ++i) {
+        free(inst_module_names[i]);
+    }
+    free(inst_module_names);
+    for (i = 0; i < inst_count; ++i) {
+        free(inst_items[i].path);
+        for (j = 0; j < inst_items[i].feat_count; ++j) {
+            free(inst_items[i].features[j]);
+        }
+        free(inst_items[i].features);
+    }
+    free(inst_items);
     sr_disconnect(conn);
     free(features);
     free(dis_features);
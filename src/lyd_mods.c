@@ -52,7 +52,8 @@
 #include "../modules/sysrepo_monitoring_yang.h"
 #include "../modules/sysrepo_plugind_yang.h"
 
-static sr_error_info_t *sr_lydmods_add_deps_r(struct lyd_node *sr_mod, struct lys_node *data_root, struct lyd_node *sr_deps);
+static sr_error_info_t *sr_lydmods_add_deps_r(struct lyd_node *sr_mod, struct lys_node *data_root,
+        struct lyd_node *sr_deps, struct ly_set *atoms);
 
 sr_error_info_t *
 sr_lydmods_lock(pthread_mutex_t *lock, const struct ly_ctx *ly_ctx, const char *func)
@@ -223,7 +224,7 @@ sr_lydmods_add_rpc_deps(struct lyd_node *sr_mod, struct lys_node *op_root)
             goto cleanup;
         }
 
-        if ((err_info = sr_lydmods_add_deps_r(sr_mod, op_child, ly_cur_deps))) {
+        if ((err_info = sr_lydmods_add_deps_r(sr_mod, op_child, ly_cur_deps, NULL))) {
             goto cleanup;
         }
     }
@@ -288,7 +289,7 @@ sr_lydmods_add_notif_deps(struct lyd_node *sr_mod, struct lys_node *op_root)
         goto cleanup;
     }
 
-    if ((err_info = sr_lydmods_add_deps_r(sr_mod, op_root, ly_cur_deps))) {
+    if ((err_info = sr_lydmods_add_deps_r(sr_mod, op_root, ly_cur_deps, NULL))) {
         goto cleanup;
     }
 
@@ -451,11 +452,12 @@ sr_lydmods_moddep_expr_atom_is_foreign(const struct lys_node *atom, const struct
  * @param[in] lyxp_opt libyang lyxp options.
  * @param[out] dep_mods Array of dependent modules.
  * @param[out] dep_mod_count Dependent module count.
+ * @param[in,out] atoms Optional set of foreign atoms to add to.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
 sr_lydmods_moddep_expr_get_dep_mods(const struct lys_node *ctx_node, const char *expr, int lyxp_opt,
-        struct lys_module ***dep_mods, size_t *dep_mod_count)
+        struct lys_module ***dep_mods, size_t *dep_mod_count, struct ly_set *atoms)
 {
     sr_error_info_t *err_info = NULL;
     struct ly_set *set;
@@ -479,6 +481,11 @@ sr_lydmods_moddep_expr_get_dep_mods(const struct lys_node *ctx_node, const char
     /* find all top-level foreign nodes (augment nodes are not considered foreign now) */
     for (i = 0; i < set->number; ++i) {
         if ((dep_mod = sr_lydmods_moddep_expr_atom_is_foreign(set->set.s[i], top_node))) {
+            if (atoms) {
+                /* remember the referenced node */
+                ly_set_add(atoms, set->set.s[i], 0);
+            }
+
             /* check for duplicities */
             for (j = 0; j < *dep_mod_count; ++j) {
                 if ((*dep_mods)[j] == dep_mod) {
@@ -514,10 +521,12 @@ cleanup:
  * @param[in] type Type to inspect.
  * @param[in] node Type node.
  * @param[in] sr_deps Internal sysrepo data dependencies to add to.
+ * @param[in,out] atoms Optional set of foreign atoms to add to.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_lydmods_moddep_type(const struct lys_type *type, struct lys_node *node, struct lyd_node *sr_deps)
+sr_lydmods_moddep_type(const struct lys_type *type, struct lys_node *node, struct lyd_node *sr_deps,
+        struct ly_set *atoms)
 {
     sr_error_info_t *err_info = NULL;
     const struct lys_type *t;
@@ -528,7 +537,7 @@ sr_lydmods_moddep_type(const struct lys_type *type, struct lys_node *node, struc
     case LY_TYPE_INST:
         if ((node->nodetype == LYS_LEAF) && ((struct lys_node_leaf *)node)->dflt) {
             if ((err_info = sr_lydmods_moddep_expr_get_dep_mods(node, ((struct lys_node_leaf *)node)->dflt, 0, &dep_mods,
-                    &dep_mod_count))) {
+                    &dep_mod_count, NULL))) {
                 return err_info;
             }
             assert(dep_mod_count < 2);
@@ -542,7 +551,8 @@ sr_lydmods_moddep_type(const struct lys_type *type, struct lys_node *node, struc
         break;
     case LY_TYPE_LEAFREF:
         assert(type->info.lref.path);
-        if ((err_info = sr_lydmods_moddep_expr_get_dep_mods(node, type->info.lref.path, 0, &dep_mods, &dep_mod_count))) {
+        if ((err_info = sr_lydmods_moddep_expr_get_dep_mods(node, type->info.lref.path, 0, &dep_mods, &dep_mod_count,
+                atoms))) {
             return err_info;
         }
         assert(dep_mod_count < 2);
@@ -559,7 +569,7 @@ sr_lydmods_moddep_type(const struct lys_type *type, struct lys_node *node, struc
     case LY_TYPE_UNION:
         t = NULL;
         while ((t = lys_getnext_union_type(t, type))) {
-            if ((err_info = sr_lydmods_moddep_type(t, node, sr_deps))) {
+            if ((err_info = sr_lydmods_moddep_type(t, node, sr_deps, atoms))) {
                 return err_info;
             }
         }
@@ -578,10 +588,12 @@ sr_lydmods_moddep_type(const struct lys_type *type, struct lys_node *node, struc
  * @param[in] sr_mod Module of the data from sysrepo data tree.
  * @param[in] data_root Root node of the data to inspect.
  * @param[in] sr_deps Internal sysrepo dependencies to add to.
+ * @param[in,out] atoms Optional set of all the referenced foreign nodes to add to.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_lydmods_add_deps_r(struct lyd_node *sr_mod, struct lys_node *data_root, struct lyd_node *sr_deps)
+sr_lydmods_add_deps_r(struct lyd_node *sr_mod, struct lys_node *data_root, struct lyd_node *sr_deps,
+        struct ly_set *atoms)
 {
     sr_error_info_t *err_info = NULL;
     struct lys_module **dep_mods;
@@ -682,17 +694,19 @@ sr_lydmods_add_deps_r(struct lyd_node *sr_mod, struct lys_node *data_root, struc
 
         /* collect the dependencies */
         if (type) {
-            if ((err_info = sr_lydmods_moddep_type(type, elem, sr_deps))) {
+            if ((err_info = sr_lydmods_moddep_type(type, elem, sr_deps, atoms))) {
                 return err_info;
             }
         }
         if (when) {
-            if ((err_info = sr_lydmods_moddep_expr_get_dep_mods(elem, when->cond, LYXP_WHEN, &dep_mods, &dep_mod_count))) {
+            if ((err_info = sr_lydmods_moddep_expr_get_dep_mods(elem, when->cond, LYXP_WHEN, &dep_mods, &dep_mod_count,
+                    atoms))) {
                 return err_info;
             }
         }
         for (i = 0; i < must_size; ++i) {
-            if ((err_info = sr_lydmods_moddep_expr_get_dep_mods(elem, musts[i].expr, LYXP_MUST, &dep_mods, &dep_mod_count))) {
+            if ((err_info = sr_lydmods_moddep_expr_get_dep_mods(elem, musts[i].expr, LYXP_MUST, &dep_mods,
+                    &dep_mod_count, atoms))) {
                 free(dep_mods);
                 return err_info;
             }
@@ -1056,19 +1070,22 @@ sr_lydmods_ctx_load_modules(const struct lyd_node *sr_mods, struct ly_ctx *ly_ct
  * @brief Check that persistent (startup) module data can be loaded into updated context.
  * On success print the new updated LYB data.
  *
+ * @param[in] main_shm Main SHM.
  * @param[in] sr_mods Sysrepo module data.
  * @param[in] new_ctx Context with all scheduled module changes.
  * @param[out] fail Whether any data failed to be parsed.
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_lydmods_sched_update_data(const struct lyd_node *sr_mods, const struct ly_ctx *new_ctx, int *fail)
+sr_lydmods_sched_update_data(sr_main_shm_t *main_shm, const struct lyd_node *sr_mods, const struct ly_ctx *new_ctx,
+        int *fail)
 {
     sr_error_info_t *err_info = NULL;
     struct lyd_node *old_start_data = NULL, *new_start_data = NULL, *old_run_data = NULL, *new_run_data = NULL, *mod_data;
     struct ly_ctx *old_ctx = NULL;
     struct ly_set *mod_set = NULL, *del_mod_set = NULL, *startup_set = NULL;
     const struct lys_module *ly_mod, *ly_mod2;
+    sr_mod_t *shm_mod;
     char *start_data_json = NULL, *run_data_json = NULL, *path;
     uint32_t idx;
     int exists;
@@ -1106,7 +1123,14 @@ sr_lydmods_sched_update_data(const struct lyd_node *sr_mods, const struct ly_ctx
         exists = sr_file_exists(path);
         free(path);
 
-        if (exists) {
+        /* running data may not have been copied from startup yet */
+        shm_mod = sr_shmmain_find_module(main_shm, ly_mod->name);
+        if (shm_mod && ATOMIC_LOAD_RELAXED(shm_mod->run_pending)) {
+            /* append startup data instead */
+            if ((err_info = sr_module_file_data_append(ly_mod, SR_DS_STARTUP, &old_run_data))) {
+                goto cleanup;
+            }
+        } else if (exists) {
             /* append running data */
             if ((err_info = sr_module_file_data_append(ly_mod, SR_DS_RUNNING, &old_run_data))) {
                 goto cleanup;
@@ -1487,10 +1511,10 @@ sr_lydmods_add_all(struct lyd_node *sr_mod, const struct lys_module *ly_mod)
 {
     sr_error_info_t *err_info = NULL;
     struct lys_node *root;
-    struct ly_set *set = NULL, *set2;
+    struct ly_set *set = NULL, *set2, *atoms = NULL;
     struct lyd_node *ly_deps;
-    uint16_t i;
-    char *xpath;
+    uint32_t i;
+    char *xpath, *path;
 
 #ifndef NDEBUG
     /* there can be no dependencies yet (but inverse ones yes) */
@@ -1509,12 +1533,26 @@ sr_lydmods_add_all(struct lyd_node *sr_mod, const struct lys_module *ly_mod)
     }
 
     /* add all the data */
+    atoms = ly_set_new();
+    SR_CHECK_MEM_GOTO(!atoms, err_info, cleanup);
     LY_TREE_FOR(ly_mod->data, root) {
-        if ((err_info = sr_lydmods_add_deps_r(sr_mod, root, ly_deps))) {
+        if ((err_info = sr_lydmods_add_deps_r(sr_mod, root, ly_deps, atoms))) {
             goto cleanup;
         }
     }
 
+    /* add all the referenced foreign nodes */
+    for (i = 0; i < atoms->number; ++i) {
+        path = lys_data_path(atoms->set.s[i]);
+        SR_CHECK_MEM_GOTO(!path, err_info, cleanup);
+        if (!lyd_new_leaf(ly_deps, NULL, "ref", path)) {
+            free(path);
+            sr_errinfo_new_ly(&err_info, ly_mod->ctx);
+            goto cleanup;
+        }
+        free(path);
+    }
+
     /* add inverse data deps */
     set = lyd_find_path(sr_mod, "deps/module");
     if (!set) {
@@ -1546,6 +1584,7 @@ sr_lydmods_add_all(struct lyd_node *sr_mod, const struct lys_module *ly_mod)
 
 cleanup:
     ly_set_free(set);
+    ly_set_free(atoms);
     return err_info;
 }
 
@@ -2111,6 +2150,7 @@ cleanup:
 /**
  * @brief Apply all scheduled changes in sysrepo module data.
  *
+ * @param[in] main_shm Main SHM.
  * @param[in,out] sr_mods Sysrepo modules data tree.
  * @param[in,out] new_ctx Initalized context with no SR modules loaded. On return all SR modules are loaded
  * with all the changes (if any) applied.
@@ -2120,7 +2160,7 @@ cleanup:
  * @return err_info, NULL on success.
  */
 static sr_error_info_t *
-sr_lydmods_sched_apply(struct lyd_node *sr_mods, struct ly_ctx *new_ctx, int *change, int *fail)
+sr_lydmods_sched_apply(sr_main_shm_t *main_shm, struct lyd_node *sr_mods, struct ly_ctx *new_ctx, int *change, int *fail)
 {
     sr_error_info_t *err_info = NULL;
     struct lyd_node *next, *next2, *sr_mod, *node;
@@ -2163,7 +2203,7 @@ sr_lydmods_sched_apply(struct lyd_node *sr_mods, struct ly_ctx *new_ctx, int *ch
         }
 
         /* check that persistent module data can be loaded with updated modules */
-        if ((err_info = sr_lydmods_sched_update_data(sr_mods, new_ctx, fail)) || *fail) {
+        if ((err_info = sr_lydmods_sched_update_data(main_shm, sr_mods, new_ctx, fail)) || *fail) {
             goto cleanup;
         }
 
@@ -2271,7 +2311,7 @@ sr_lydmods_conn_ctx_update(sr_main_shm_t *main_shm, struct ly_ctx **ly_ctx, int
                 goto cleanup;
             }
             if (!conn_count) {
-                if ((err_info = sr_lydmods_sched_apply(*sr_mods, *ly_ctx, &chng, &fail))) {
+                if ((err_info = sr_lydmods_sched_apply(main_shm, *sr_mods, *ly_ctx, &chng, &fail))) {
                     goto cleanup;
                 }
                 if (fail) {
@@ -2329,26 +2369,25 @@ cleanup:
     return err_info;
 }
 
-sr_error_info_t *
-sr_lydmods_deferred_add_module(sr_main_shm_t *main_shm, struct ly_ctx *ly_ctx, const struct lys_module *ly_mod,
-        const char **features, int feat_count)
+/**
+ * @brief Add a module scheduled for installation into sysrepo module data.
+ *
+ * @param[in] sr_mods Sysrepo module data.
+ * @param[in] ly_mod Module that is scheduled to be installed.
+ * @param[in] features Array of enabled features.
+ * @param[in] feat_count Number of enabled features.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_lydmods_sched_add_module(struct lyd_node *sr_mods, const struct lys_module *ly_mod, const char **features,
+        int feat_count)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_node *sr_mods = NULL, *inst_mod;
+    struct lyd_node *inst_mod;
     struct ly_set *set = NULL;
     char *path = NULL, *yang_str = NULL;
     int i;
 
-    /* LYDMODS LOCK */
-    if ((err_info = sr_lydmods_lock(&main_shm->lydmods_lock, ly_ctx, __func__))) {
-        return err_info;
-    }
-
-    /* parse current module information */
-    if ((err_info = sr_lydmods_parse(ly_ctx, &sr_mods))) {
-        goto cleanup;
-    }
-
     /* check that the module is not already marked for installation */
     if (asprintf(&path, "installed-module[name=\"%s\"]", ly_mod->name) == -1) {
         SR_ERRINFO_MEM(&err_info);
@@ -2363,18 +2402,18 @@ sr_lydmods_deferred_add_module(sr_main_shm_t *main_shm, struct ly_ctx *ly_ctx, c
 
     /* store all info for installation */
     if (!(inst_mod = lyd_new_path(sr_mods, NULL, path, NULL, 0, 0))) {
-        sr_errinfo_new_ly(&err_info, ly_ctx);
+        sr_errinfo_new_ly(&err_info, lyd_node_module(sr_mods)->ctx);
         goto cleanup;
     }
 
     if (ly_mod->rev_size && !lyd_new_leaf(inst_mod, NULL, "revision", ly_mod->rev[0].date)) {
-        sr_errinfo_new_ly(&err_info, ly_ctx);
+        sr_errinfo_new_ly(&err_info, lyd_node_module(sr_mods)->ctx);
         goto cleanup;
     }
 
     for (i = 0; i < feat_count; ++i) {
         if (!lyd_new_leaf(inst_mod, NULL, "enabled-feature", features[i])) {
-            sr_errinfo_new_ly(&err_info, ly_ctx);
+            sr_errinfo_new_ly(&err_info, lyd_node_module(sr_mods)->ctx);
             goto cleanup;
         }
     }
@@ -2386,24 +2425,55 @@ sr_lydmods_deferred_add_module(sr_main_shm_t *main_shm, struct ly_ctx *ly_ctx, c
     }
 
     if (!lyd_new_leaf(inst_mod, NULL, "module-yang", yang_str)) {
-        sr_errinfo_new_ly(&err_info, ly_ctx);
+        sr_errinfo_new_ly(&err_info, lyd_node_module(sr_mods)->ctx);
         goto cleanup;
     }
 
-    /* store the updated persistent data tree */
+cleanup:
+    free(path);
+    free(yang_str);
+    ly_set_free(set);
+    return err_info;
+}
+
+sr_error_info_t *
+sr_lydmods_deferred_add_modules(sr_main_shm_t *main_shm, struct ly_ctx *ly_ctx, const struct lys_module **ly_mods,
+        const char ***features, const int *feat_counts, uint32_t mod_count)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *sr_mods = NULL;
+    uint32_t i;
+
+    /* LYDMODS LOCK */
+    if ((err_info = sr_lydmods_lock(&main_shm->lydmods_lock, ly_ctx, __func__))) {
+        return err_info;
+    }
+
+    /* parse current module information */
+    if ((err_info = sr_lydmods_parse(ly_ctx, &sr_mods))) {
+        goto cleanup;
+    }
+
+    /* add all the modules */
+    for (i = 0; i < mod_count; ++i) {
+        if ((err_info = sr_lydmods_sched_add_module(sr_mods, ly_mods[i], features[i], feat_counts[i]))) {
+            goto cleanup;
+        }
+    }
+
+    /* store the updated persistent data tree, only once for all the modules */
     if ((err_info = sr_lydmods_print(&sr_mods))) {
         goto cleanup;
     }
 
-    SR_LOG_INF("Module \"%s\" scheduled for installation.", ly_mod->name);
+    for (i = 0; i < mod_count; ++i) {
+        SR_LOG_INF("Module \"%s\" scheduled for installation.", ly_mods[i]->name);
+    }
 
 cleanup:
     /* LYDMODS UNLOCK */
     sr_munlock(&main_shm->lydmods_lock);
 
-    free(path);
-    free(yang_str);
-    ly_set_free(set);
     lyd_free_withsiblings(sr_mods);
     return err_info;
 }
@@ -60,17 +60,18 @@ sr_error_info_t *sr_lydmods_conn_ctx_update(sr_main_shm_t *main_shm, struct ly_c
         int err_on_sched_fail, struct lyd_node **sr_mods, int *changed);
 
 /**
- * @brief Schedule module installation to sysrepo module data.
+ * @brief Schedule installation of several modules to sysrepo module data. Module data are parsed and stored only once.
  *
  * @param[in] main_shm Main SHM.
  * @param[in] ly_ctx Context to use for parsing the data.
- * @param[in] ly_mod Module that is scheduled to be installed.
- * @param[in] features Array of enabled features.
- * @param[in] feat_count Number of enabled features.
+ * @param[in] ly_mods Array of modules that are scheduled to be installed.
+ * @param[in] features Array of arrays of enabled features for each module.
+ * @param[in] feat_counts Array of numbers of enabled features for each module.
+ * @param[in] mod_count Number of modules.
  * @return err_info, NULL on success.
  */
-sr_error_info_t *sr_lydmods_deferred_add_module(sr_main_shm_t *main_shm, struct ly_ctx *ly_ctx,
-        const struct lys_module *ly_mod, const char **features, int feat_count);
+sr_error_info_t *sr_lydmods_deferred_add_modules(sr_main_shm_t *main_shm, struct ly_ctx *ly_ctx,
+        const struct lys_module **ly_mods, const char ***features, const int *feat_counts, uint32_t mod_count);
 
 /**
  * @brief Unschedule module installation from sysrepo module data.
@@ -24,6 +24,7 @@
 #include <assert.h>
 #include <fcntl.h>
 #include <inttypes.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <sys/mman.h>
@@ -642,6 +643,68 @@ sr_xpath_oper_data_append(sr_mod_oper_sub_t *shm_msub, const struct lys_module *
     return NULL;
 }
 
+/**
+ * @brief Get operational subscription decisions of a prepared XPath for a module, update them if the subscriptions
+ * changed. Module operational subscriptions must be READ locked.
+ *
+ * @param[in] prepared Prepared XPath.
+ * @param[in] mod Mod info module with the subscriptions.
+ * @param[in] conn Connection to use.
+ * @param[out] prep_mod Prepared XPath module with valid decisions.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_xpath_prepared_oper_mod(struct sr_xpath_prepared_s *prepared, struct sr_mod_info_mod_s *mod, sr_conn_ctx_t *conn,
+        struct sr_xpath_prepared_mod_s **prep_mod)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_mod_oper_sub_t *shm_sub;
+    void *mem;
+    uint32_t i;
+
+    /* find the module */
+    for (i = 0; i < prepared->mod_count; ++i) {
+        if (prepared->mods[i].ly_mod == mod->ly_mod) {
+            break;
+        }
+    }
+    if (i == prepared->mod_count) {
+        /* add new module */
+        mem = realloc(prepared->mods, (i + 1) * sizeof *prepared->mods);
+        SR_CHECK_MEM_RET(!mem, err_info);
+        prepared->mods = mem;
+        memset(&prepared->mods[i], 0, sizeof *prepared->mods);
+        prepared->mods[i].ly_mod = mod->ly_mod;
+        ++prepared->mod_count;
+    }
+    *prep_mod = &prepared->mods[i];
+
+    if ((*prep_mod)->oper_sub_ver == mod->shm_mod->oper_sub_ver) {
+        /* decisions are still valid */
+        return NULL;
+    }
+
+    /* decide for the current subscriptions */
+    mem = realloc((*prep_mod)->oper_required, mod->shm_mod->oper_sub_count * sizeof *(*prep_mod)->oper_required);
+    if (!mem && mod->shm_mod->oper_sub_count) {
+        (*prep_mod)->oper_sub_ver = 0;
+        (*prep_mod)->oper_sub_count = 0;
+        SR_ERRINFO_MEM(&err_info);
+        return err_info;
+    }
+    (*prep_mod)->oper_required = mem;
+    (*prep_mod)->oper_sub_count = mod->shm_mod->oper_sub_count;
+
+    shm_sub = (sr_mod_oper_sub_t *)(conn->ext_shm.addr + mod->shm_mod->oper_subs);
+    for (i = 0; i < mod->shm_mod->oper_sub_count; ++i) {
+        (*prep_mod)->oper_required[i] = sr_xpath_oper_data_required(prepared->xpath,
+                conn->ext_shm.addr + shm_sub[i].xpath) ? 1 : 0;
+    }
+    (*prep_mod)->oper_sub_ver = mod->shm_mod->oper_sub_ver;
+
+    return NULL;
+}
+
 /**
  * @brief Update (replace or append) operational data for a specific module.
  *
@@ -650,6 +713,7 @@ sr_xpath_oper_data_append(sr_mod_oper_sub_t *shm_msub, const struct lys_module *
  * @param[in] sid Sysrepo session ID.
  * @param[in] conn Connection to use.
  * @param[in] request_xpath XPath of the data request.
+ * @param[in] prepared Prepared @p request_xpath, if any.
  * @param[in] timeout_ms Operational callback timeout in milliseconds.
  * @param[in] opts Get oper data options.
  * @param[in,out] data Operational data tree.
@@ -658,24 +722,27 @@ sr_xpath_oper_data_append(sr_mod_oper_sub_t *shm_msub, const struct lys_module *
  */
 static sr_error_info_t *
 sr_module_oper_data_update(struct sr_mod_info_mod_s *mod, sr_sid_t sid, sr_conn_ctx_t *conn,
-        const char *request_xpath, uint32_t timeout_ms, sr_get_oper_options_t opts, struct lyd_node **data,
-        sr_error_info_t **cb_error_info)
+        const char *request_xpath, struct sr_xpath_prepared_s *prepared, uint32_t timeout_ms, sr_get_oper_options_t opts,
+        struct lyd_node **data, sr_error_info_t **cb_error_info)
 {
     sr_error_info_t *err_info = NULL;
     sr_mod_oper_sub_t *shm_sub;
+    struct sr_xpath_prepared_mod_s *prep_mod = NULL;
     const char *sub_xpath;
     char *parent_xpath = NULL;
     uint16_t i, j;
+    int required;
     struct ly_set *set = NULL;
-    struct lyd_node *diff = NULL;
+    const struct lyd_node *diff;
+    struct sr_oper_cache_borrow_s *borrow;
 
     if (!(opts & SR_OPER_NO_STORED)) {
-        /* apply stored operational diff */
-        if ((err_info = sr_module_file_oper_data_load(mod, &diff))) {
+        /* apply stored operational diff, shared with the cache */
+        if ((err_info = sr_module_file_oper_data_borrow(conn, mod, &diff, &borrow))) {
             return err_info;
         }
         err_info = sr_diff_mod_apply(diff, mod->ly_mod, opts & SR_OPER_WITH_ORIGIN, data);
-        lyd_free_withsiblings(diff);
+        sr_module_file_oper_data_release(conn, borrow);
         if (err_info) {
             return err_info;
         }
@@ -699,6 +766,10 @@ sr_module_oper_data_update(struct sr_mod_info_mod_s *mod, sr_sid_t sid, sr_conn_
         goto cleanup_opersub_unlock;
     }
 
+    if (prepared && (err_info = sr_xpath_prepared_oper_mod(prepared, mod, conn, &prep_mod))) {
+        goto cleanup_opersub_ext_unlock;
+    }
+
     /* XPaths are ordered based on depth */
     i = 0;
     while (i < mod->shm_mod->oper_sub_count) {
@@ -714,10 +785,16 @@ sr_module_oper_data_update(struct sr_mod_info_mod_s *mod, sr_sid_t sid, sr_conn_
             continue;
         }
 
+        if (prep_mod && (prep_mod->oper_sub_ver == mod->shm_mod->oper_sub_ver) && (i < prep_mod->oper_sub_count)) {
+            /* decided when preparing, valid unless a dead subscription was just removed */
+            required = prep_mod->oper_required[i];
+        } else {
+            required = sr_xpath_oper_data_required(request_xpath, sub_xpath);
+        }
+
         /* useless to retrieve configuration data, state data, or filtered out data */
         if (((shm_sub->sub_type == SR_OPER_SUB_CONFIG) && (opts & SR_OPER_NO_CONFIG)) ||
-                ((shm_sub->sub_type == SR_OPER_SUB_STATE) && (opts & SR_OPER_NO_STATE)) ||
-                !sr_xpath_oper_data_required(request_xpath, sub_xpath)) {
+                ((shm_sub->sub_type == SR_OPER_SUB_STATE) && (opts & SR_OPER_NO_STATE)) || !required) {
             ++i;
             continue;
         }
@@ -909,6 +986,102 @@ error_sub_unlock:
     return err_info;
 }
 
+/**
+ * @brief Make sure the cached running data are not borrowed before changing them. Borrowers keep the current
+ * tree and the cache continues with its copy. Cache must be WRITE locked.
+ *
+ * @param[in] mod_cache Module cache.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modcache_unborrow(struct sr_mod_cache_s *mod_cache)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *data = NULL;
+
+    /* BORROW LOCK */
+    if ((err_info = sr_mlock(&mod_cache->borrow_lock, SR_MOD_CACHE_LOCK_TIMEOUT, __func__, NULL, NULL))) {
+        return err_info;
+    }
+
+    if (mod_cache->borrow) {
+        if (mod_cache->data) {
+            data = lyd_dup_withsiblings(mod_cache->data, LYD_DUP_OPT_RECURSIVE | LYD_DUP_OPT_WITH_WHEN);
+            if (!data) {
+                sr_errinfo_new_ly(&err_info, lyd_node_module(mod_cache->data)->ctx);
+                goto cleanup;
+            }
+        }
+
+        /* the borrowed tree is now owned by the borrowers */
+        assert(mod_cache->borrow->data == mod_cache->data);
+        mod_cache->borrow = NULL;
+        mod_cache->data = data;
+    }
+
+cleanup:
+    /* BORROW UNLOCK */
+    sr_munlock(&mod_cache->borrow_lock);
+
+    return err_info;
+}
+
+sr_error_info_t *
+sr_modcache_borrow(sr_conn_ctx_t *conn, sr_borrowed_data_t *data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_cache_s *mod_cache = &conn->mod_cache;
+
+    /* BORROW LOCK */
+    if ((err_info = sr_mlock(&mod_cache->borrow_lock, SR_MOD_CACHE_LOCK_TIMEOUT, __func__, NULL, NULL))) {
+        return err_info;
+    }
+
+    if (!mod_cache->borrow) {
+        mod_cache->borrow = calloc(1, sizeof *mod_cache->borrow);
+        SR_CHECK_MEM_GOTO(!mod_cache->borrow, err_info, cleanup);
+        mod_cache->borrow->data = mod_cache->data;
+    }
+    ++mod_cache->borrow->refcount;
+    data->cache_borrow = mod_cache->borrow;
+
+cleanup:
+    /* BORROW UNLOCK */
+    sr_munlock(&mod_cache->borrow_lock);
+
+    return err_info;
+}
+
+void
+sr_modcache_borrow_release(sr_borrowed_data_t *data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_cache_s *mod_cache = &data->conn->mod_cache;
+    struct sr_mod_cache_borrow_s *borrow = data->cache_borrow;
+
+    data->cache_borrow = NULL;
+
+    /* BORROW LOCK */
+    if ((err_info = sr_mlock(&mod_cache->borrow_lock, SR_MOD_CACHE_LOCK_TIMEOUT, __func__, NULL, NULL))) {
+        sr_errinfo_free(&err_info);
+        return;
+    }
+
+    if (!--borrow->refcount) {
+        if (mod_cache->borrow == borrow) {
+            /* still the cached tree */
+            mod_cache->borrow = NULL;
+        } else {
+            /* last borrower of a tree no longer cached */
+            lyd_free_withsiblings(borrow->data);
+        }
+        free(borrow);
+    }
+
+    /* BORROW UNLOCK */
+    sr_munlock(&mod_cache->borrow_lock);
+}
+
 /**
  * @brief Update cached running module data (if required).
  *
@@ -959,6 +1132,11 @@ sr_modcache_module_running_update(struct sr_mod_cache_s *mod_cache, struct sr_mo
             }
             cur_mode = SR_LOCK_WRITE;
 
+            /* cached data can be changed */
+            if ((err_info = sr_modcache_unborrow(mod_cache))) {
+                goto cleanup;
+            }
+
             /* data needs to be updated, remove old data */
             lyd_free_withsiblings(sr_module_data_unlink(&mod_cache->data, mod->ly_mod));
             mod_cache->mods[i].ver = 0;
@@ -971,6 +1149,11 @@ sr_modcache_module_running_update(struct sr_mod_cache_s *mod_cache, struct sr_mo
         }
         cur_mode = SR_LOCK_WRITE;
 
+        /* cached data can be changed */
+        if ((err_info = sr_modcache_unborrow(mod_cache))) {
+            goto cleanup;
+        }
+
         /* module is not in cache yet, add an item */
         mem = realloc(mod_cache->mods, (i + 1) * sizeof *mod_cache->mods);
         SR_CHECK_MEM_GOTO(!mem, err_info, cleanup);
@@ -1575,6 +1758,7 @@ cleanup:
  * @param[in] load_diff Whether to load stored operational diff of the module.
  * @param[in] sid Sysrepo session ID.
  * @param[in] request_xpath XPath of the data request.
+ * @param[in] prune Whether only data selected by @p request_xpath can be loaded.
  * @param[in] timeout_ms Operational callback timeout in milliseconds.
  * @param[in] opts Get oper data options.
  * @param[out] cb_error_info Callback error info returned by operational subscribers, if any.
@@ -1582,13 +1766,15 @@ cleanup:
  */
 static sr_error_info_t *
 sr_modinfo_module_data_load(struct sr_mod_info_s *mod_info, struct sr_mod_info_mod_s *mod, sr_sid_t sid,
-        const char *request_xpath, uint32_t timeout_ms, sr_get_oper_options_t opts, sr_error_info_t **cb_error_info)
+        const char *request_xpath, int prune, uint32_t timeout_ms, sr_get_oper_options_t opts,
+        sr_error_info_t **cb_error_info)
 {
     sr_error_info_t *err_info = NULL;
     sr_conn_ctx_t *conn = mod_info->conn;
     struct sr_mod_cache_s *mod_cache = NULL;
     struct lyd_node *mod_data = NULL;
     sr_datastore_t conf_ds;
+    int pruned = 0;
 
     if (((mod_info->ds == SR_DS_RUNNING) || (mod_info->ds2 == SR_DS_RUNNING)) && (conn->opts & SR_CONN_CACHE_RUNNING)) {
         /* we are caching running data we will use, so in all cases load the module into cache if not yet there */
@@ -1635,8 +1821,16 @@ sr_modinfo_module_data_load(struct sr_mod_info_s *mod_info, struct sr_mod_info_m
             } else {
                 conf_ds = mod_info->ds;
             }
+            if (prune && (mod->state & MOD_INFO_REQ) && (mod_info->ds == conf_ds)) {
+                /* try to get only the requested persistent data */
+                if ((err_info = sr_module_file_data_append_pruned(mod->ly_mod, conf_ds, request_xpath, &mod_info->data,
+                        &pruned))) {
+                    return err_info;
+                }
+            }
+
             /* get current persistent data */
-            if ((err_info = sr_module_file_data_append(mod->ly_mod, conf_ds, &mod_info->data))) {
+            if (!pruned && (err_info = sr_module_file_data_append(mod->ly_mod, conf_ds, &mod_info->data))) {
                 return err_info;
             }
 
@@ -1668,8 +1862,8 @@ sr_modinfo_module_data_load(struct sr_mod_info_s *mod_info, struct sr_mod_info_m
             }
 
             /* append any operational data provided by clients */
-            if ((err_info = sr_module_oper_data_update(mod, sid, conn, request_xpath, timeout_ms, opts,
-                    &mod_info->data, cb_error_info))) {
+            if ((err_info = sr_module_oper_data_update(mod, sid, conn, request_xpath, mod_info->prepared, timeout_ms,
+                    opts, &mod_info->data, cb_error_info))) {
                 return err_info;
             }
 
@@ -1814,7 +2008,7 @@ sr_modinfo_qsort_cmp(const void *ptr1, const void *ptr2)
 }
 
 sr_error_info_t *
-sr_modinfo_data_load(struct sr_mod_info_s *mod_info, int cache, sr_sid_t sid, const char *request_xpath,
+sr_modinfo_data_load(struct sr_mod_info_s *mod_info, int mi_opts, sr_sid_t sid, const char *request_xpath,
         uint32_t timeout_ms, sr_get_oper_options_t opts, sr_error_info_t **cb_error_info)
 {
     sr_error_info_t *err_info = NULL;
@@ -1822,7 +2016,7 @@ sr_modinfo_data_load(struct sr_mod_info_s *mod_info, int cache, sr_sid_t sid, co
     uint32_t i;
 
     /* we can use cache only if we are working with the running datastore (as the main datastore) */
-    if (!mod_info->data_cached && cache && (mod_info->conn->opts & SR_CONN_CACHE_RUNNING) &&
+    if (!mod_info->data_cached && (mi_opts & SR_MI_DATA_CACHE) && (mod_info->conn->opts & SR_CONN_CACHE_RUNNING) &&
             (mod_info->ds == SR_DS_RUNNING)) {
         /* CACHE READ LOCK */
         if ((err_info = sr_rwlock(&mod_info->conn->mod_cache.lock, SR_MOD_CACHE_LOCK_TIMEOUT, SR_LOCK_READ,
@@ -1842,7 +2036,8 @@ sr_modinfo_data_load(struct sr_mod_info_s *mod_info, int cache, sr_sid_t sid, co
             continue;
         }
 
-        if ((err_info = sr_modinfo_module_data_load(mod_info, mod, sid, request_xpath, timeout_ms, opts, cb_error_info))) {
+        if ((err_info = sr_modinfo_module_data_load(mod_info, mod, sid, request_xpath, mi_opts & SR_MI_DATA_PRUNE,
+                timeout_ms, opts, cb_error_info))) {
             /* if cached, we keep both cache lock and flag, so it is fine */
             return err_info;
         }
@@ -1928,7 +2123,7 @@ sr_modinfo_add_modules(struct sr_mod_info_s *mod_info, const struct ly_set *mod_
 
     if (!(mi_opts & SR_MI_DATA_NO)) {
         /* load all modules data */
-        if ((err_info = sr_modinfo_data_load(mod_info, mi_opts & SR_MI_DATA_CACHE, sid, request_xpath, timeout_ms,
+        if ((err_info = sr_modinfo_data_load(mod_info, mi_opts, sid, request_xpath, timeout_ms,
                 get_opts, &cb_err_info))) {
             return err_info;
         }
@@ -1982,37 +2177,544 @@ sr_modinfo_ly_val_diff_merge(struct sr_mod_info_s *mod_info, struct lyd_difflist
     return NULL;
 }
 
+/**
+ * @brief Collect schema nodes of all the nodes changed in a diff.
+ *
+ * @param[in] diff Sysrepo diff.
+ * @param[in,out] touched Set of schema nodes of all the changed nodes and their parents.
+ * @param[in,out] subtrees Set of schema nodes of all the created or deleted subtrees.
+ */
+static void
+sr_modinfo_diff_touched(const struct lyd_node *diff, struct ly_set *touched, struct ly_set *subtrees)
+{
+    const struct lyd_node *root, *next, *elem;
+    enum edit_op op;
+
+    LY_TREE_FOR(diff, root) {
+        LY_TREE_DFS_BEGIN(root, next, elem) {
+            ly_set_add(touched, elem->schema, 0);
+
+            op = sr_edit_find_oper(elem, 0, NULL);
+            if ((op == EDIT_CREATE) || (op == EDIT_DELETE)) {
+                ly_set_add(subtrees, elem->schema, 0);
+            }
+
+            LY_TREE_DFS_END(root, next, elem);
+        }
+    }
+}
+
+/**
+ * @brief Collect schema nodes of all the nodes changed by validation.
+ *
+ * @param[in] val_diff libyang validation diff.
+ * @param[in,out] touched Set of schema nodes of all the changed nodes and their parents.
+ * @param[in,out] subtrees Set of schema nodes of all the created or deleted subtrees.
+ */
+static void
+sr_modinfo_val_diff_touched(const struct lyd_difflist *val_diff, struct ly_set *touched, struct ly_set *subtrees)
+{
+    struct lyd_node *node;
+    struct lys_node *snode;
+    uint32_t i;
+
+    for (i = 0; val_diff->type[i] != LYD_DIFF_END; ++i) {
+        if (val_diff->type[i] == LYD_DIFF_CREATED) {
+            node = val_diff->second[i];
+        } else {
+            node = val_diff->first[i];
+        }
+
+        ly_set_add(subtrees, node->schema, 0);
+        for (snode = node->schema; snode; snode = lys_parent(snode)) {
+            ly_set_add(touched, snode, 0);
+        }
+    }
+}
+
+/**
+ * @brief Learn whether an inverse dependency module references any changed nodes and needs to be validated.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in] mod Inverse dependency module.
+ * @param[in] touched Set of schema nodes of all the changed nodes and their parents.
+ * @param[in] subtrees Set of schema nodes of all the created or deleted subtrees.
+ * @return Whether the module data validity could have been affected by the changes.
+ */
+static int
+sr_modinfo_inv_dep_affected(struct sr_mod_info_s *mod_info, const struct sr_mod_info_mod_s *mod,
+        const struct ly_set *touched, const struct ly_set *subtrees)
+{
+    const struct lys_node *snode;
+    sr_dep_t *shm_deps;
+    off_t *shm_refs;
+    uint32_t i;
+
+    shm_deps = (sr_dep_t *)(mod_info->conn->main_shm.addr + mod->shm_mod->deps);
+    for (i = 0; i < mod->shm_mod->dep_count; ++i) {
+        if (shm_deps[i].type == SR_DEP_INSTID) {
+            /* instance-identifiers can reference anything */
+            return 1;
+        }
+    }
+
+    if (mod->shm_mod->dep_count && !mod->shm_mod->ref_count) {
+        /* referenced nodes were not stored with the dependencies */
+        return 1;
+    }
+
+    /* the foreign nodes referenced by the module were collected with its dependencies */
+    shm_refs = (off_t *)(mod_info->conn->main_shm.addr + mod->shm_mod->refs);
+    for (i = 0; i < mod->shm_mod->ref_count; ++i) {
+        snode = ly_ctx_get_node(mod_info->conn->ly_ctx, NULL, mod_info->conn->main_shm.addr + shm_refs[i], 0);
+        if (!snode) {
+            /* should not happen, be safe */
+            return 1;
+        }
+
+        if (ly_set_contains(touched, (void *)snode) > -1) {
+            /* referenced node was changed */
+            return 1;
+        }
+        for (; snode; snode = lys_parent(snode)) {
+            if (ly_set_contains(subtrees, (void *)snode) > -1) {
+                /* referenced node was created or deleted with its parent */
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Set of modules whose data can be validated independently of all the other modules.
+ */
+struct sr_valid_comp_s {
+    const struct lys_module **mods; /**< Modules to validate. */
+    uint32_t mod_count;             /**< Count of modules to validate. */
+    uint32_t root;                  /**< Index of the first mod info module in the set. */
+    uint32_t node_count;            /**< Count of data nodes of the set, at most ::SR_VALIDATE_PARALLEL_MIN_NODES. */
+    struct lyd_node *data;          /**< Data of all the modules in the set. */
+    struct lyd_difflist *diff;      /**< Validation diff. */
+    sr_error_info_t *err_info;      /**< Validation error. */
+};
+
+/**
+ * @brief Shared information for validation threads.
+ */
+struct sr_valid_pool_s {
+    struct sr_valid_comp_s *comps;  /**< Sets of modules to validate. */
+    uint32_t comp_count;            /**< Count of sets. */
+    ATOMIC_T next_comp;             /**< Index of the next set to validate. */
+    struct ly_ctx *ly_ctx;          /**< libyang context. */
+    int flags;                      /**< Validation flags. */
+};
+
+/**
+ * @brief Thread validating sets of modules until there are none left.
+ *
+ * @param[in] arg Validation pool.
+ * @return Always NULL.
+ */
+static void *
+sr_modinfo_validate_thread(void *arg)
+{
+    struct sr_valid_pool_s *pool = arg;
+    struct sr_valid_comp_s *comp;
+    uint32_t idx;
+
+    while ((idx = ATOMIC_INC_RELAXED(pool->next_comp)) < pool->comp_count) {
+        comp = &pool->comps[idx];
+        if (lyd_validate_modules(&comp->data, comp->mods, comp->mod_count, pool->flags, &comp->diff)) {
+            sr_errinfo_new_ly(&comp->err_info, pool->ly_ctx);
+            SR_ERRINFO_VALID(&comp->err_info);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Find the index of the set (union-find) a mod info module belongs to.
+ *
+ * @param[in] comp Array of parent indices.
+ * @param[in] i Mod info module index.
+ * @return Index of the first module in the set.
+ */
+static uint32_t
+sr_modinfo_comp_find(uint32_t *comp, uint32_t i)
+{
+    while (comp[i] != i) {
+        comp[i] = comp[comp[i]];
+        i = comp[i];
+    }
+
+    return i;
+}
+
+/**
+ * @brief Mod info module lookup item.
+ */
+struct sr_valid_key_s {
+    const void *key;                /**< Module name in main SHM or libyang module. */
+    uint32_t idx;                   /**< Mod info module index. */
+};
+
+/**
+ * @brief Comparator for qsort and bsearch of module lookup items.
+ *
+ * @param[in] ptr1 First item.
+ * @param[in] ptr2 Second item.
+ * @return Comparison result.
+ */
+static int
+sr_modinfo_valid_key_cmp(const void *ptr1, const void *ptr2)
+{
+    const struct sr_valid_key_s *key1 = ptr1, *key2 = ptr2;
+
+    if ((uintptr_t)key1->key < (uintptr_t)key2->key) {
+        return -1;
+    } else if ((uintptr_t)key1->key > (uintptr_t)key2->key) {
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Join sets of 2 mod info modules (union-find).
+ *
+ * @param[in] keys Sorted module lookup items.
+ * @param[in] key_count Count of @p keys.
+ * @param[in] comp Array of parent indices.
+ * @param[in] i Mod info module index.
+ * @param[in] key Key of the other module, is ignored if not in @p keys.
+ */
+static void
+sr_modinfo_comp_union(const struct sr_valid_key_s *keys, uint32_t key_count, uint32_t *comp, uint32_t i,
+        const void *key)
+{
+    struct sr_valid_key_s key_item = {key, 0};
+    const struct sr_valid_key_s *found;
+    uint32_t j;
+
+    found = bsearch(&key_item, keys, key_count, sizeof *keys, sr_modinfo_valid_key_cmp);
+    if (!found) {
+        /* no data of this module */
+        return;
+    }
+
+    i = sr_modinfo_comp_find(comp, i);
+    j = sr_modinfo_comp_find(comp, found->idx);
+    if (i < j) {
+        comp[j] = i;
+    } else {
+        comp[i] = j;
+    }
+}
+
+/**
+ * @brief Count data nodes of a module, stop counting at a limit.
+ *
+ * @param[in] data Data tree.
+ * @param[in] ly_mod Module whose data to count.
+ * @param[in] limit Maximum count to reach.
+ * @return Count of data nodes, at most @p limit.
+ */
+static uint32_t
+sr_modinfo_data_count(const struct lyd_node *data, const struct lys_module *ly_mod, uint32_t limit)
+{
+    const struct lyd_node *root, *next, *elem;
+    uint32_t count = 0;
+
+    LY_TREE_FOR(data, root) {
+        if (lyd_node_module(root) != ly_mod) {
+            continue;
+        }
+
+        LY_TREE_DFS_BEGIN(root, next, elem) {
+            if (++count == limit) {
+                return count;
+            }
+            LY_TREE_DFS_END(root, next, elem);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Validate data of modules. Modules without any dependencies between them are validated in parallel
+ * if there are at least 2 such sets with enough data.
+ *
+ * @param[in] mod_info Mod info to use.
+ * @param[in] valid_mods Modules to validate.
+ * @param[in] valid_mod_count Count of @p valid_mods.
+ * @param[in] flags Validation flags.
+ * @param[out] diffs Array of validation diffs, in a deterministic order.
+ * @param[out] diff_count Count of @p diffs.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_modinfo_validate_modules(struct sr_mod_info_s *mod_info, const struct lys_module **valid_mods,
+        uint32_t valid_mod_count, int flags, struct lyd_difflist ***diffs, uint32_t *diff_count)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_info_mod_s *mod;
+    struct sr_valid_pool_s pool = {0};
+    struct sr_valid_comp_s *vcomp;
+    struct lyd_node *mod_data;
+    struct sr_valid_key_s *keys = NULL;
+    sr_dep_t *shm_deps;
+    pthread_t tids[SR_VALIDATE_THREAD_COUNT - 1];
+    uint32_t i, j, r, *comp = NULL, tid_count = 0;
+    void *mem;
+
+    *diffs = NULL;
+    *diff_count = 0;
+
+    if (valid_mod_count < 2) {
+        goto validate;
+    }
+
+    /* prepare module lookup by their name in main SHM (dependencies) and by libyang module (augments) */
+    keys = malloc(2 * mod_info->mod_count * sizeof *keys);
+    SR_CHECK_MEM_GOTO(!keys, err_info, cleanup);
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        keys[i].key = mod_info->conn->main_shm.addr + mod_info->mods[i].shm_mod->name;
+        keys[i].idx = i;
+        keys[mod_info->mod_count + i].key = mod_info->mods[i].ly_mod;
+        keys[mod_info->mod_count + i].idx = i;
+    }
+    qsort(keys, mod_info->mod_count, sizeof *keys, sr_modinfo_valid_key_cmp);
+    qsort(keys + mod_info->mod_count, mod_info->mod_count, sizeof *keys, sr_modinfo_valid_key_cmp);
+
+    /* divide all the modules into sets connected by dependencies, inverse dependencies are dependencies
+     * of the other modules so they are joined as well */
+    comp = malloc(mod_info->mod_count * sizeof *comp);
+    SR_CHECK_MEM_GOTO(!comp, err_info, cleanup);
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        comp[i] = i;
+    }
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+
+        shm_deps = (sr_dep_t *)(mod_info->conn->main_shm.addr + mod->shm_mod->deps);
+        for (j = 0; j < mod->shm_mod->dep_count; ++j) {
+            if (shm_deps[j].type == SR_DEP_INSTID) {
+                /* can reference data of any module */
+                goto validate;
+            }
+            sr_modinfo_comp_union(keys, mod_info->mod_count, comp, i,
+                    mod_info->conn->main_shm.addr + shm_deps[j].module);
+        }
+
+        for (j = 0; j < mod->ly_mod->augment_size; ++j) {
+            /* augment data are a part of the target module data */
+            sr_modinfo_comp_union(keys + mod_info->mod_count, mod_info->mod_count, comp, i,
+                    lys_node_module(mod->ly_mod->augment[j].target));
+        }
+    }
+
+    /* collect the sets with modules to validate */
+    pool.comps = calloc(valid_mod_count, sizeof *pool.comps);
+    SR_CHECK_MEM_GOTO(!pool.comps, err_info, cleanup);
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        for (j = 0; j < valid_mod_count; ++j) {
+            if (valid_mods[j] == mod_info->mods[i].ly_mod) {
+                break;
+            }
+        }
+        if (j == valid_mod_count) {
+            /* not validated */
+            continue;
+        }
+
+        r = sr_modinfo_comp_find(comp, i);
+        for (j = 0; j < pool.comp_count; ++j) {
+            if (pool.comps[j].root == r) {
+                break;
+            }
+        }
+        vcomp = &pool.comps[j];
+        if (j == pool.comp_count) {
+            vcomp->root = r;
+            vcomp->mods = malloc(valid_mod_count * sizeof *vcomp->mods);
+            SR_CHECK_MEM_GOTO(!vcomp->mods, err_info, cleanup);
+            ++pool.comp_count;
+        }
+        vcomp->mods[vcomp->mod_count] = mod_info->mods[i].ly_mod;
+        ++vcomp->mod_count;
+    }
+
+    if (pool.comp_count < 2) {
+        /* nothing to parallelize */
+        goto validate;
+    }
+
+    /* count the data of each set, validating small sets in threads would only be slower */
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        r = sr_modinfo_comp_find(comp, i);
+        for (j = 0; j < pool.comp_count; ++j) {
+            if (pool.comps[j].root == r) {
+                break;
+            }
+        }
+        if ((j < pool.comp_count) && (pool.comps[j].node_count < SR_VALIDATE_PARALLEL_MIN_NODES)) {
+            pool.comps[j].node_count += sr_modinfo_data_count(mod_info->data, mod_info->mods[i].ly_mod,
+                    SR_VALIDATE_PARALLEL_MIN_NODES - pool.comps[j].node_count);
+        }
+    }
+    for (i = 0, j = 0; i < pool.comp_count; ++i) {
+        if (pool.comps[i].node_count == SR_VALIDATE_PARALLEL_MIN_NODES) {
+            ++j;
+        }
+    }
+    if (j < 2) {
+        /* not enough data to parallelize */
+        goto validate;
+    }
+
+    /* separate data of each set */
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        r = sr_modinfo_comp_find(comp, i);
+        for (j = 0; j < pool.comp_count; ++j) {
+            if (pool.comps[j].root == r) {
+                break;
+            }
+        }
+        if (j == pool.comp_count) {
+            /* data not needed for validation */
+            continue;
+        }
+
+        if ((mod_data = sr_module_data_unlink(&mod_info->data, mod_info->mods[i].ly_mod))) {
+            if (pool.comps[j].data) {
+                sr_ly_link(pool.comps[j].data, mod_data);
+            } else {
+                pool.comps[j].data = mod_data;
+            }
+        }
+    }
+
+    /* validate the sets, this thread is one of the validating threads; libyang context is only read during
+     * validation (its dictionary is locked and errors are thread-specific) and every thread validates
+     * a separate data tree so it is safe to validate in parallel */
+    pool.ly_ctx = mod_info->conn->ly_ctx;
+    pool.flags = flags;
+    ATOMIC_STORE_RELAXED(pool.next_comp, 0);
+    for (i = 0; (i < pool.comp_count - 1) && (i < SR_VALIDATE_THREAD_COUNT - 1); ++i) {
+        if (pthread_create(&tids[tid_count], NULL, sr_modinfo_validate_thread, &pool)) {
+            /* just use fewer threads */
+            break;
+        }
+        ++tid_count;
+    }
+    sr_modinfo_validate_thread(&pool);
+    for (i = 0; i < tid_count; ++i) {
+        pthread_join(tids[i], NULL);
+    }
+
+    /* connect the data back and collect the results */
+    *diffs = calloc(pool.comp_count, sizeof **diffs);
+    for (i = 0; i < pool.comp_count; ++i) {
+        vcomp = &pool.comps[i];
+        if (vcomp->data) {
+            if (mod_info->data) {
+                sr_ly_link(mod_info->data, vcomp->data);
+            } else {
+                mod_info->data = vcomp->data;
+            }
+            vcomp->data = NULL;
+        }
+
+        if (*diffs) {
+            (*diffs)[i] = vcomp->diff;
+        } else {
+            lyd_free_val_diff(vcomp->diff);
+        }
+        vcomp->diff = NULL;
+
+        if (vcomp->err_info) {
+            sr_errinfo_merge(&err_info, vcomp->err_info);
+            vcomp->err_info = NULL;
+        }
+    }
+    if (*diffs) {
+        *diff_count = pool.comp_count;
+    } else if (!err_info) {
+        SR_ERRINFO_MEM(&err_info);
+    }
+    goto cleanup;
+
+validate:
+    /* validate all the modules together */
+    mem = calloc(1, sizeof **diffs);
+    SR_CHECK_MEM_GOTO(!mem, err_info, cleanup);
+    *diffs = mem;
+    *diff_count = 1;
+    if (lyd_validate_modules(&mod_info->data, valid_mods, valid_mod_count, flags, &(*diffs)[0])) {
+        sr_errinfo_new_ly(&err_info, mod_info->conn->ly_ctx);
+        SR_ERRINFO_VALID(&err_info);
+    }
+
+cleanup:
+    for (i = 0; i < pool.comp_count; ++i) {
+        free(pool.comps[i].mods);
+    }
+    free(pool.comps);
+    free(comp);
+    free(keys);
+    return err_info;
+}
+
 sr_error_info_t *
 sr_modinfo_validate(struct sr_mod_info_s *mod_info, int mod_state, int finish_diff)
 {
     sr_error_info_t *err_info = NULL;
     struct sr_mod_info_mod_s *mod;
-    struct lyd_difflist *diff = NULL;
+    struct lyd_difflist **diffs = NULL, **full_diffs = NULL;
     const struct lys_module **valid_mods = NULL;
-    uint32_t i, j, valid_mod_count = 0;
-    int flags;
+    struct sr_mod_info_mod_s **skip_mods = NULL;
+    struct ly_set *touched = NULL, *subtrees = NULL;
+    uint32_t i, valid_mod_count = 0, skip_mod_count = 0, diff_count = 0, full_diff_count = 0;
+    int flags, val_change;
 
     assert(!mod_info->data_cached);
 
-    for (i = 0; i < mod_info->mod_count; ++i) {
-        mod = &mod_info->mods[i];
-        if (mod->state & mod_state) {
-            /* this module will be validated */
-            ++valid_mod_count;
-        }
+    valid_mods = malloc(mod_info->mod_count * sizeof *valid_mods);
+    skip_mods = malloc(mod_info->mod_count * sizeof *skip_mods);
+    SR_CHECK_MEM_GOTO(!valid_mods || !skip_mods, err_info, cleanup);
+
+    if ((mod_state & MOD_INFO_INV_DEP) && mod_info->diff) {
+        /* we know the changes, inverse dependencies need to be validated only if they reference any changed nodes */
+        touched = ly_set_new();
+        subtrees = ly_set_new();
+        SR_CHECK_MEM_GOTO(!touched || !subtrees, err_info, cleanup);
+        sr_modinfo_diff_touched(mod_info->diff, touched, subtrees);
     }
 
     /* create an array of all the modules that will be validated */
-    valid_mods = malloc(valid_mod_count * sizeof *valid_mods);
-    SR_CHECK_MEM_GOTO(!valid_mods, err_info, cleanup);
-    for (i = 0, j = 0; i < mod_info->mod_count; ++i) {
+    for (i = 0; i < mod_info->mod_count; ++i) {
         mod = &mod_info->mods[i];
-        if (mod->state & mod_state) {
-            valid_mods[j] = mod->ly_mod;
-            ++j;
+        if (!(mod->state & mod_state)) {
+            continue;
         }
+
+        if (touched && !(mod->state & mod_state & ~MOD_INFO_INV_DEP)) {
+            /* unchanged inverse dependency */
+            if (!sr_modinfo_inv_dep_affected(mod_info, mod, touched, subtrees)) {
+                /* this module will not be validated */
+                skip_mods[skip_mod_count] = mod;
+                ++skip_mod_count;
+                continue;
+            }
+        }
+
+        /* this module will be validated */
+        valid_mods[valid_mod_count] = mod->ly_mod;
+        ++valid_mod_count;
     }
-    assert(j == valid_mod_count);
 
     /* validate */
     if (SR_IS_CONVENTIONAL_DS(mod_info->ds)) {
@@ -2020,24 +2722,71 @@ sr_modinfo_validate(struct sr_mod_info_s *mod_info, int mod_state, int finish_di
     } else {
         flags = LYD_OPT_DATA | LYD_OPT_WHENAUTODEL | LYD_OPT_VAL_DIFF;
     }
-    if (lyd_validate_modules(&mod_info->data, valid_mods, valid_mod_count, flags, &diff)) {
-        sr_errinfo_new_ly(&err_info, mod_info->conn->ly_ctx);
-        SR_ERRINFO_VALID(&err_info);
+    if ((err_info = sr_modinfo_validate_modules(mod_info, valid_mods, valid_mod_count, flags, &diffs, &diff_count))) {
         goto cleanup;
     }
 
+    val_change = 0;
+    for (i = 0; i < diff_count; ++i) {
+        if (diffs[i]->type[0] != LYD_DIFF_END) {
+            val_change = 1;
+            break;
+        }
+    }
+
+    if (skip_mod_count && val_change) {
+        /* validation changed some data, check the skipped modules again */
+        for (i = 0; i < diff_count; ++i) {
+            sr_modinfo_val_diff_touched(diffs[i], touched, subtrees);
+        }
+        for (i = 0; i < skip_mod_count; ++i) {
+            if (sr_modinfo_inv_dep_affected(mod_info, skip_mods[i], touched, subtrees)) {
+                break;
+            }
+        }
+
+        if (i < skip_mod_count) {
+            /* validate all the modules together, as with no changes known */
+            for (i = 0; i < skip_mod_count; ++i) {
+                valid_mods[valid_mod_count] = skip_mods[i]->ly_mod;
+                ++valid_mod_count;
+            }
+            if ((err_info = sr_modinfo_validate_modules(mod_info, valid_mods, valid_mod_count, flags, &full_diffs,
+                    &full_diff_count))) {
+                goto cleanup;
+            }
+        }
+    }
+
     if (finish_diff) {
         /* merge the changes made by the validation into our diff */
-        if ((err_info = sr_modinfo_ly_val_diff_merge(mod_info, diff))) {
-            goto cleanup;
+        for (i = 0; i < diff_count; ++i) {
+            if ((err_info = sr_modinfo_ly_val_diff_merge(mod_info, diffs[i]))) {
+                goto cleanup;
+            }
+        }
+        for (i = 0; i < full_diff_count; ++i) {
+            if ((err_info = sr_modinfo_ly_val_diff_merge(mod_info, full_diffs[i]))) {
+                goto cleanup;
+            }
         }
     }
 
     /* success */
 
 cleanup:
-    lyd_free_val_diff(diff);
+    for (i = 0; i < diff_count; ++i) {
+        lyd_free_val_diff(diffs[i]);
+    }
+    free(diffs);
+    for (i = 0; i < full_diff_count; ++i) {
+        lyd_free_val_diff(full_diffs[i]);
+    }
+    free(full_diffs);
+    ly_set_free(touched);
+    ly_set_free(subtrees);
     free(valid_mods);
+    free(skip_mods);
     return err_info;
 }
 
@@ -2468,16 +3217,16 @@ sr_modinfo_data_store(struct sr_mod_info_s *mod_info)
     sr_error_info_t *err_info = NULL, *tmp_err_info = NULL;
     struct sr_mod_info_mod_s *mod;
     struct lyd_node *mod_data, *diff = NULL;
+    char **tmp_paths = NULL;
     uint32_t i;
-    int change, create_flags;
+    int change;
 
     assert(!mod_info->data_cached);
 
-    /* candidate file may need to be created */
-    if (mod_info->ds == SR_DS_CANDIDATE) {
-        create_flags = O_CREAT;
-    } else {
-        create_flags = 0;
+    if (mod_info->ds == SR_DS_STARTUP) {
+        /* startup files are all replaced at once */
+        tmp_paths = calloc(mod_info->mod_count, sizeof *tmp_paths);
+        SR_CHECK_MEM_RET(!tmp_paths, err_info);
     }
 
     for (i = 0; i < mod_info->mod_count; ++i) {
@@ -2486,7 +3235,7 @@ sr_modinfo_data_store(struct sr_mod_info_s *mod_info)
             if (mod_info->ds == SR_DS_OPERATIONAL) {
                 /* load current diff and merge it with the new diff */
                 assert(mod->state & MOD_INFO_WLOCK);
-                if ((err_info = sr_module_file_oper_data_load(mod, &diff))) {
+                if ((err_info = sr_module_file_oper_data_load(mod_info->conn, mod, &diff))) {
                     goto cleanup;
                 }
                 if ((err_info = sr_diff_mod_merge(mod_info->diff, mod_info->conn, mod->ly_mod, &diff, &change))) {
@@ -2494,8 +3243,7 @@ sr_modinfo_data_store(struct sr_mod_info_s *mod_info)
                 }
 
                 /* store the new diff */
-                if (change && (err_info = sr_module_file_data_set(mod->ly_mod->name, SR_DS_OPERATIONAL, diff, 0,
-                        SR_FILE_PERM))) {
+                if (change && (err_info = sr_module_file_oper_data_store(mod_info->conn, mod, diff))) {
                     goto cleanup;
                 }
                 lyd_free_withsiblings(diff);
@@ -2505,8 +3253,17 @@ sr_modinfo_data_store(struct sr_mod_info_s *mod_info)
                 mod_data = sr_module_data_unlink(&mod_info->data, mod->ly_mod);
 
                 /* store the new data */
-                if ((err_info = sr_module_file_data_set(mod->ly_mod->name, mod_info->ds, mod_data, create_flags,
-                        SR_FILE_PERM))) {
+                if (mod_info->ds == SR_DS_STARTUP) {
+                    err_info = sr_module_file_startup_prepare(mod->ly_mod->name, mod_data, &tmp_paths[i]);
+                } else if (mod_info->ds == SR_DS_CANDIDATE) {
+                    /* only the changes relative to running are stored */
+                    err_info = sr_module_file_candidate_store(mod, mod_info->diff, mod_data);
+                } else if (mod_info->ds == SR_DS_RUNNING) {
+                    err_info = sr_module_file_running_update(mod->ly_mod->name, mod_data, mod_info->diff);
+                } else {
+                    err_info = sr_module_file_data_set(mod->ly_mod->name, mod_info->ds, mod_data, 0, SR_FILE_PERM);
+                }
+                if (err_info) {
                     goto cleanup;
                 }
 
@@ -2535,7 +3292,7 @@ sr_modinfo_data_store(struct sr_mod_info_s *mod_info)
 
                 if (mod_info->ds == SR_DS_RUNNING) {
                     /* update diffs of stored operational data, if any */
-                    if ((err_info = sr_module_file_oper_data_load(mod, &diff))) {
+                    if ((err_info = sr_module_file_oper_data_load(mod_info->conn, mod, &diff))) {
                         goto cleanup;
                     }
 
@@ -2547,8 +3304,7 @@ sr_modinfo_data_store(struct sr_mod_info_s *mod_info)
                         if ((err_info = sr_diff_mod_update(&diff, mod->ly_mod, mod_data))) {
                             goto cleanup;
                         }
-                        if ((err_info = sr_module_file_data_set(mod->ly_mod->name, SR_DS_OPERATIONAL, diff, 0,
-                                SR_FILE_PERM))) {
+                        if ((err_info = sr_module_file_oper_data_store(mod_info->conn, mod, diff))) {
                             goto cleanup;
                         }
                         lyd_free_withsiblings(diff);
@@ -2559,7 +3315,16 @@ sr_modinfo_data_store(struct sr_mod_info_s *mod_info)
         }
     }
 
+    if (tmp_paths) {
+        /* replace all the startup files */
+        err_info = sr_module_file_startup_commit(tmp_paths, mod_info->mod_count);
+    }
+
 cleanup:
+    if (tmp_paths) {
+        sr_module_file_startup_discard(tmp_paths, mod_info->mod_count);
+        free(tmp_paths);
+    }
     if (tmp_err_info) {
         sr_errinfo_merge(&err_info, tmp_err_info);
     }
@@ -50,6 +50,7 @@ struct sr_mod_info_s {
     struct lyd_node *data;      /**< Data tree. */
     int data_cached;            /**< Whether the data are actually in cache (conn cache READ lock is held). */
     sr_conn_ctx_t *conn;        /**< Associated connection. */
+    struct sr_xpath_prepared_s *prepared;   /**< Prepared XPath of the data request, if any. */
 
     struct sr_mod_info_mod_s {
         sr_mod_t *shm_mod;      /**< Module SHM structure. */
@@ -130,7 +131,7 @@ void sr_modinfo_changesub_rdunlock(struct sr_mod_info_s *mod_info);
  * Should not be called directly because it is normally a part of ::sr_modinfo_add_modules()!
  *
  * @param[in] mod_info Mod info to use.
- * @param[in] cache Whether it makes sense to use cached data, if available.
+ * @param[in] mi_opts Mod info options, only SR_MI_DATA_CACHE and SR_MI_DATA_PRUNE are relevant.
  * @param[in] sid Sysrepo session ID.
  * @param[in] request_id XPath of the data request.
  * @param[in] timeout_ms Operational callback timeout in milliseconds.
@@ -139,7 +140,7 @@ void sr_modinfo_changesub_rdunlock(struct sr_mod_info_s *mod_info);
  * @return err_info, NULL on success.
  */
 sr_error_info_t *
-sr_modinfo_data_load(struct sr_mod_info_s *mod_info, int cache, sr_sid_t sid, const char *request_xpath,
+sr_modinfo_data_load(struct sr_mod_info_s *mod_info, int mi_opts, sr_sid_t sid, const char *request_xpath,
         uint32_t timeout_ms, sr_get_oper_options_t opts, sr_error_info_t **cb_error_info);
 
 #define SR_MI_MOD_DEPS          0x01    /**< add modules not as MOD_INFO_REQ but as MOD_INFO_DEP */
@@ -151,6 +152,8 @@ sr_modinfo_data_load(struct sr_mod_info_s *mod_info, int cache, sr_sid_t sid, co
 #define SR_MI_PERM_NO           0x20    /**< do not check any permissions */
 #define SR_MI_PERM_READ         0x40    /**< check read permissions of the MOD_INFO_REQ modules */
 #define SR_MI_PERM_WRITE        0x80    /**< check write permissions of the MOD_INFO_REQ modules */
+#define SR_MI_DATA_PRUNE        0x100   /**< load only the data selected by the request XPath, if the stored data
+                                             allow it; the loaded data must not be used for anything else */
 
 /**
  * @brief Add new modules and their dependnecies into mod_info, check their permissions, lock, and load their data.
@@ -243,6 +246,22 @@ sr_error_info_t *sr_modinfo_data_store(struct sr_mod_info_s *mod_info);
  */
 sr_error_info_t *sr_modinfo_candidate_reset(struct sr_mod_info_s *mod_info);
 
+/**
+ * @brief Borrow the current running data cache tree of a connection. Cache must be READ locked.
+ *
+ * @param[in] conn Connection with the cache.
+ * @param[in,out] data Borrowed data to store the reference in.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_modcache_borrow(sr_conn_ctx_t *conn, sr_borrowed_data_t *data);
+
+/**
+ * @brief Release a borrowed running data cache tree, it is freed if no longer cached nor borrowed.
+ *
+ * @param[in] data Borrowed data with the reference.
+ */
+void sr_modcache_borrow_release(sr_borrowed_data_t *data);
+
 /**
  * @brief Free mod info.
  *
@@ -32,7 +32,7 @@
 #include "common.h"
 
 #define SR_MAIN_SHM_LOCK "sr_main_lock"     /**< Main SHM file lock name. */
-#define SR_SHM_VER 6                        /**< Main and ext SHM version of their expected content structures. */
+#define SR_SHM_VER 10                       /**< Main and ext SHM version of their expected content structures. */
 
 /**
  * Main SHM organization
@@ -100,10 +100,14 @@ struct sr_mod_s {
     } data_lock_info[SR_DS_COUNT]; /**< Module data lock information for each datastore. */
     sr_rwlock_t replay_lock;    /**< Process-shared lock for accessing stored notifications for replay. */
     uint32_t ver;               /**< Module data version (non-zero). */
+    uint32_t cand_run_ver;      /**< Running module data version the stored candidate diff is relative to. */
+    uint32_t oper_ver;          /**< Stored operational diff version (non-zero). */
 
     off_t name;                 /**< Module name (offset in main SHM). */
     char rev[11];               /**< Module revision. */
     ATOMIC_T replay_supp;       /**< Whether module supports replay. */
+    ATOMIC_T run_pending;       /**< Whether running data file was not yet copied from startup, it is copied
+                                     on the first access of the module data. */
 
     off_t features;             /**< Array of enabled features (off_t *) (offset in main SHM). */
     uint16_t feat_count;        /**< Number of enabled features. */
@@ -116,6 +120,9 @@ struct sr_mod_s {
     uint16_t dep_count;         /**< Number of module data dependencies. */
     off_t inv_deps;             /**< Array of inverse module data dependencies (off_t *) (offset in main SHM). */
     uint16_t inv_dep_count;     /**< Number of inverse module data dependencies. */
+    off_t refs;                 /**< Array of paths of foreign nodes referenced by the module data (off_t *)
+                                     (offset in main SHM). */
+    uint16_t ref_count;         /**< Number of referenced foreign nodes. */
 
     struct {
         sr_rwlock_t lock;       /**< Process-shared lock for reading or preventing changes (READ) or modifying (WRITE)
@@ -128,6 +135,8 @@ struct sr_mod_s {
                                      operational subscriptions. */
     off_t oper_subs;            /**< Array of operational subscriptions (offset in ext SHM). */
     uint32_t oper_sub_count;    /**< Number of operational subscriptions. */
+    uint32_t oper_sub_ver;      /**< Operational subscriptions version (non-zero), changed with every added or removed
+                                     subscription. */
 
     sr_rwlock_t notif_lock;     /**< Process-shared lock for reading or preventing changes (READ) or modifying (WRITE)
                                      notification subscriptions. */
@@ -394,16 +403,47 @@ sr_error_info_t *sr_shmmain_conn_list_del(sr_cid_t cid);
  */
 sr_error_info_t *sr_shmmain_ly_ctx_init(struct ly_ctx **ly_ctx);
 
+/**
+ * @brief Remove stale temporary startup files of all the modules left after a crash.
+ * Every module startup data are WRITE-locked while its temporary file is being removed.
+ *
+ * @param[in] main_shm Main SHM.
+ * @param[in] cid Connection ID.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmmain_files_startup_clean(sr_main_shm_t *main_shm, sr_cid_t cid);
+
 /**
  * @brief Copy startup files into running files.
  *
  * @param[in] main_shm Main SHM.
  * @param[in] replace Whether replace any existing running data (standard copy-config) or copy data
- * only for modules that do not have any running data.
+ * only for modules that do not have any running data. When replacing, the data are not copied right away,
+ * modules are only marked and their data copied on their first access.
  * @return err_info, NULL on success.
  */
 sr_error_info_t *sr_shmmain_files_startup2running(sr_main_shm_t *main_shm, int replace);
 
+/**
+ * @brief Learn all the modules with running data still waiting to be copied from startup.
+ *
+ * @param[in] main_shm Main SHM.
+ * @param[out] mod_names Array of module names.
+ * @param[out] mod_count Count of @p mod_names.
+ * @return err_info, NULL on success.
+ */
+sr_error_info_t *sr_shmmain_files_run_pending_get(sr_main_shm_t *main_shm, char ***mod_names, uint32_t *mod_count);
+
+/**
+ * @brief Mark modules with running data still waiting to be copied from startup. Meant to be used
+ * after main SHM modules are recreated.
+ *
+ * @param[in] main_shm Main SHM.
+ * @param[in] mod_names Array of module names, are freed.
+ * @param[in] mod_count Count of @p mod_names.
+ */
+void sr_shmmain_files_run_pending_set(sr_main_shm_t *main_shm, char **mod_names, uint32_t mod_count);
+
 /**
  * @brief Remap main SHM and store modules and all their static information (name, deps, ...) in it.
  *
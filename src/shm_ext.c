@@ -736,6 +736,11 @@ sr_shmext_oper_subscription_add(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, const ch
     shm_sub->evpipe_num = evpipe_num;
     shm_sub->cid = conn->cid;
 
+    /* subscriptions changed */
+    if (!++shm_mod->oper_sub_ver) {
+        ++shm_mod->oper_sub_ver;
+    }
+
     SR_LOG_DBG("#SHM after (adding oper sub)");
     sr_shmext_print(SR_CONN_MAIN_SHM(conn), &conn->ext_shm);
 
@@ -791,6 +796,11 @@ sr_shmext_oper_subscription_free(sr_conn_ctx_t *conn, sr_mod_t *shm_mod, uint32_
     sr_shmrealloc_del(&conn->ext_shm, &shm_mod->oper_subs, &shm_mod->oper_sub_count, sizeof *shm_sub, del_idx,
             sr_strshmlen(conn->ext_shm.addr + shm_sub[del_idx].xpath), shm_sub[del_idx].xpath);
 
+    /* subscriptions changed */
+    if (!++shm_mod->oper_sub_ver) {
+        ++shm_mod->oper_sub_ver;
+    }
+
     SR_LOG_DBG("#SHM after (removing oper sub)");
     sr_shmext_print(SR_CONN_MAIN_SHM(conn), &conn->ext_shm);
 
@@ -461,6 +461,51 @@ sr_shmmain_ly_ctx_init(struct ly_ctx **ly_ctx)
     return NULL;
 }
 
+sr_error_info_t *
+sr_shmmain_files_startup_clean(sr_main_shm_t *main_shm, sr_cid_t cid)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_mod_t *shm_mod;
+    char *startup_path, *tmp_path;
+    const char *mod_name;
+    uint32_t i;
+
+    for (i = 0; i < main_shm->mod_count; ++i) {
+        shm_mod = SR_SHM_MOD_IDX(main_shm, i);
+        mod_name = ((char *)main_shm) + shm_mod->name;
+
+        if ((err_info = sr_path_startup_file(mod_name, &startup_path))) {
+            return err_info;
+        }
+        if (asprintf(&tmp_path, "%s%s", startup_path, SR_FILE_TEMP_SUFFIX) == -1) {
+            free(startup_path);
+            SR_ERRINFO_MEM(&err_info);
+            return err_info;
+        }
+        free(startup_path);
+
+        /* STARTUP WRITE LOCK, no writer can be preparing a new startup file meanwhile */
+        if ((err_info = sr_rwlock(&shm_mod->data_lock_info[SR_DS_STARTUP].lock, SR_MOD_LOCK_TIMEOUT, SR_LOCK_WRITE,
+                cid, __func__, NULL, NULL))) {
+            free(tmp_path);
+            return err_info;
+        }
+
+        /* remove any temporary file left after a crash */
+        if (!unlink(tmp_path)) {
+            SR_LOG_WRN("Removed stale temporary startup data file \"%s\".", tmp_path);
+        } else if (errno != ENOENT) {
+            SR_LOG_WRN("Failed to remove stale temporary startup data file \"%s\" (%s).", tmp_path, strerror(errno));
+        }
+
+        /* STARTUP UNLOCK */
+        sr_rwunlock(&shm_mod->data_lock_info[SR_DS_STARTUP].lock, SR_MOD_LOCK_TIMEOUT, SR_LOCK_WRITE, cid, __func__);
+        free(tmp_path);
+    }
+
+    return NULL;
+}
+
 sr_error_info_t *
 sr_shmmain_files_startup2running(sr_main_shm_t *main_shm, int replace)
 {
@@ -469,6 +514,7 @@ sr_shmmain_files_startup2running(sr_main_shm_t *main_shm, int replace)
     char *startup_path, *running_path;
     const char *mod_name;
     uint32_t i;
+    int exists;
 
     for (i = 0; i < main_shm->mod_count; ++i) {
         shm_mod = SR_SHM_MOD_IDX(main_shm, i);
@@ -477,8 +523,20 @@ sr_shmmain_files_startup2running(sr_main_shm_t *main_shm, int replace)
         if ((err_info = sr_path_ds_shm(mod_name, SR_DS_RUNNING, &running_path))) {
             goto error;
         }
+        exists = sr_file_exists(running_path);
 
-        if (!replace && sr_file_exists(running_path)) {
+        if (replace) {
+            /* copy the data only on the first access, but the running file must exist */
+            free(running_path);
+            ATOMIC_STORE_RELAXED(shm_mod->run_pending, 1);
+            if (!exists && (err_info = sr_module_file_data_set(mod_name, SR_DS_RUNNING, NULL, O_CREAT | O_EXCL,
+                    SR_FILE_PERM))) {
+                goto error;
+            }
+            continue;
+        }
+
+        if (exists) {
             /* there are some running data, keep them */
             free(running_path);
             continue;
@@ -497,7 +555,7 @@ sr_shmmain_files_startup2running(sr_main_shm_t *main_shm, int replace)
     }
 
     if (replace) {
-        SR_LOG_INF("Datastore copied from <startup> to <running>.");
+        SR_LOG_INF("Datastore copied from <startup> to <running> (on first access of every module).");
     }
     return NULL;
 
@@ -506,6 +564,61 @@ error:
     return err_info;
 }
 
+sr_error_info_t *
+sr_shmmain_files_run_pending_get(sr_main_shm_t *main_shm, char ***mod_names, uint32_t *mod_count)
+{
+    sr_error_info_t *err_info = NULL;
+    sr_mod_t *shm_mod;
+    void *mem;
+    uint32_t i;
+
+    *mod_names = NULL;
+    *mod_count = 0;
+
+    for (i = 0; i < main_shm->mod_count; ++i) {
+        shm_mod = SR_SHM_MOD_IDX(main_shm, i);
+        if (!ATOMIC_LOAD_RELAXED(shm_mod->run_pending)) {
+            continue;
+        }
+
+        /* store the name, main SHM is going to be recreated */
+        mem = realloc(*mod_names, (*mod_count + 1) * sizeof **mod_names);
+        SR_CHECK_MEM_GOTO(!mem, err_info, error);
+        *mod_names = mem;
+        (*mod_names)[*mod_count] = strdup(((char *)main_shm) + shm_mod->name);
+        SR_CHECK_MEM_GOTO(!(*mod_names)[*mod_count], err_info, error);
+        ++(*mod_count);
+    }
+
+    return NULL;
+
+error:
+    for (i = 0; i < *mod_count; ++i) {
+        free((*mod_names)[i]);
+    }
+    free(*mod_names);
+    *mod_names = NULL;
+    *mod_count = 0;
+    return err_info;
+}
+
+void
+sr_shmmain_files_run_pending_set(sr_main_shm_t *main_shm, char **mod_names, uint32_t mod_count)
+{
+    sr_mod_t *shm_mod;
+    uint32_t i;
+
+    for (i = 0; i < mod_count; ++i) {
+        /* the module may have been removed */
+        shm_mod = sr_shmmain_find_module(main_shm, mod_names[i]);
+        if (shm_mod) {
+            ATOMIC_STORE_RELAXED(shm_mod->run_pending, 1);
+        }
+        free(mod_names[i]);
+    }
+    free(mod_names);
+}
+
 /**
  * @brief Fill main SHM dependency information based on internal sysrepo data.
  *
@@ -611,6 +724,8 @@ sr_shmmain_fill_module(const struct lyd_node *sr_mod, size_t shm_mod_idx, sr_shm
         return err_info;
     }
     shm_mod->ver = 1;
+    shm_mod->oper_ver = 1;
+    shm_mod->oper_sub_ver = 1;
     for (ds = 0; ds < SR_DS_COUNT; ++ds) {
         if ((err_info = sr_rwlock_init(&shm_mod->change_sub[ds].lock, 1))) {
             return err_info;
@@ -697,22 +812,31 @@ sr_shmmain_add_module_deps(const struct lyd_node *sr_mod, size_t shm_mod_idx, sr
     struct lyd_node *sr_child, *sr_dep, *sr_instid;
     sr_mod_t *shm_mod, *ref_shm_mod;
     sr_dep_t *shm_deps;
-    off_t *shm_inv_deps;
+    off_t *shm_inv_deps, *shm_refs;
     sr_main_shm_t *main_shm;
     char *shm_end;
     const char *str;
-    size_t paths_len, dep_i, inv_dep_i, old_shm_size;
+    size_t paths_len, dep_i, inv_dep_i, ref_i, old_shm_size;
 
     shm_mod = SR_SHM_MOD_IDX(shm_main->addr, shm_mod_idx);
 
     assert(!shm_mod->dep_count);
     assert(!shm_mod->inv_dep_count);
+    assert(!shm_mod->ref_count);
 
     /* count arrays and paths length */
     paths_len = 0;
     LY_TREE_FOR(sr_mod->child, sr_child) {
         if (!strcmp(sr_child->schema->name, "deps")) {
             LY_TREE_FOR(sr_child->child, sr_dep) {
+                if (!strcmp(sr_dep->schema->name, "ref")) {
+                    /* another referenced node, a string */
+                    ++shm_mod->ref_count;
+                    str = sr_ly_leaf_value_str(sr_dep);
+                    paths_len += sr_strshmlen(str);
+                    continue;
+                }
+
                 /* another data dependency */
                 ++shm_mod->dep_count;
 
@@ -738,7 +862,7 @@ sr_shmmain_add_module_deps(const struct lyd_node *sr_mod, size_t shm_mod_idx, sr
 
     /* enlarge and possibly remap main SHM */
     if ((err_info = sr_shm_remap(shm_main, shm_main->size + paths_len + SR_SHM_SIZE(shm_mod->dep_count * sizeof(sr_dep_t))
-            + SR_SHM_SIZE(shm_mod->inv_dep_count * sizeof(off_t))))) {
+            + SR_SHM_SIZE(shm_mod->inv_dep_count * sizeof(off_t)) + SR_SHM_SIZE(shm_mod->ref_count * sizeof(off_t))))) {
         return err_info;
     }
     shm_mod = SR_SHM_MOD_IDX(shm_main->addr, shm_mod_idx);
@@ -754,12 +878,25 @@ sr_shmmain_add_module_deps(const struct lyd_node *sr_mod, size_t shm_mod_idx, sr
     shm_inv_deps = (off_t *)(shm_main->addr + shm_mod->inv_deps);
     inv_dep_i = 0;
 
+    shm_mod->refs = sr_shmcpy(shm_main->addr, NULL, shm_mod->ref_count * sizeof(off_t), &shm_end);
+    shm_refs = (off_t *)(shm_main->addr + shm_mod->refs);
+    ref_i = 0;
+
     LY_TREE_FOR(sr_mod->child, sr_child) {
         if (!strcmp(sr_child->schema->name, "deps")) {
             /* now fill the dependency array */
             if ((err_info = sr_shmmain_fill_deps(main_shm, sr_child, shm_deps, &dep_i, &shm_end))) {
                 return err_info;
             }
+
+            /* and the referenced nodes */
+            LY_TREE_FOR(sr_child->child, sr_dep) {
+                if (!strcmp(sr_dep->schema->name, "ref")) {
+                    str = sr_ly_leaf_value_str(sr_dep);
+                    shm_refs[ref_i] = sr_shmstrcpy(shm_main->addr, str, &shm_end);
+                    ++ref_i;
+                }
+            }
         } else if (!strcmp(sr_child->schema->name, "inverse-deps")) {
             /* now fill module references */
             str = sr_ly_leaf_value_str(sr_child);
@@ -772,6 +909,7 @@ sr_shmmain_add_module_deps(const struct lyd_node *sr_mod, size_t shm_mod_idx, sr
     }
     SR_CHECK_INT_RET(dep_i != shm_mod->dep_count, err_info);
     SR_CHECK_INT_RET(inv_dep_i != shm_mod->inv_dep_count, err_info);
+    SR_CHECK_INT_RET(ref_i != shm_mod->ref_count, err_info);
 
     /* main SHM size must be exactly what we allocated */
     assert(shm_end == shm_main->addr + shm_main->size);
@@ -379,6 +379,9 @@ sr_shmmod_recover_cb(sr_lock_mode_t mode, sr_cid_t cid, void *data)
         }
 
         /* copy startup data to running */
+        if ((err_info = sr_module_file_idx_del(path))) {
+            goto cleanup;
+        }
         if ((err_info = sr_cp_path(path, bck_path, 0))) {
             SR_ERRINFO_SYSERRNO(&err_info, "rename");
             goto cleanup;
@@ -517,6 +520,100 @@ sr_shmmod_unlock(struct sr_mod_lock_s *shm_lock, int timeout_ms, sr_lock_mode_t
     sr_rwunlock(&shm_lock->lock, timeout_ms, mode, cid, __func__);
 }
 
+/**
+ * @brief Copy startup data of a module into its running data file, if not done yet.
+ *
+ * @param[in] mod Mod info module.
+ * @param[in] cid Connection ID.
+ * @param[in] sid Sysrepo session ID.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmmod_run_copy(struct sr_mod_info_mod_s *mod, sr_cid_t cid, sr_sid_t sid)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_lock_s *shm_lock;
+    char *startup_path = NULL, *running_path = NULL;
+
+    if (!ATOMIC_LOAD_RELAXED(mod->shm_mod->run_pending)) {
+        /* already copied */
+        return NULL;
+    }
+
+    shm_lock = &mod->shm_mod->data_lock_info[SR_DS_RUNNING];
+
+    /* MOD WRITE LOCK */
+    if ((err_info = sr_shmmod_lock(mod->ly_mod, SR_DS_RUNNING, shm_lock, SR_MOD_LOCK_TIMEOUT, SR_LOCK_WRITE, cid, sid, 0))) {
+        return err_info;
+    }
+
+    if (!ATOMIC_LOAD_RELAXED(mod->shm_mod->run_pending)) {
+        /* copied in the meantime */
+        goto cleanup_unlock;
+    }
+
+    /* copy the data file */
+    if ((err_info = sr_path_startup_file(mod->ly_mod->name, &startup_path))) {
+        goto cleanup_unlock;
+    }
+    if ((err_info = sr_path_ds_shm(mod->ly_mod->name, SR_DS_RUNNING, &running_path))) {
+        goto cleanup_unlock;
+    }
+    if ((err_info = sr_module_file_idx_del(running_path))) {
+        goto cleanup_unlock;
+    }
+    if ((err_info = sr_cp_path(running_path, startup_path, SR_FILE_PERM))) {
+        goto cleanup_unlock;
+    }
+
+    ATOMIC_STORE_RELAXED(mod->shm_mod->run_pending, 0);
+
+cleanup_unlock:
+    /* MOD UNLOCK */
+    sr_shmmod_unlock(shm_lock, SR_MOD_LOCK_TIMEOUT, SR_LOCK_WRITE, cid, sid);
+
+    free(startup_path);
+    free(running_path);
+    return err_info;
+}
+
+/**
+ * @brief Copy startup data of all mod info modules into their running data files, if not done yet.
+ * Every module is WRITE-locked only for the copy so it must be called before any mod info modules are locked.
+ *
+ * @param[in] mod_info Mod info with modules to copy.
+ * @param[in] sid Session ID.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_shmmod_modinfo_run_copy(struct sr_mod_info_s *mod_info, sr_sid_t sid)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t i;
+    struct sr_mod_info_mod_s *mod;
+
+    /* running data are copied from startup on the first access (candidate can be only a reference to running) */
+    if ((mod_info->ds != SR_DS_RUNNING) && (mod_info->ds != SR_DS_CANDIDATE) && (mod_info->ds2 != SR_DS_RUNNING)
+            && (mod_info->ds2 != SR_DS_CANDIDATE)) {
+        return NULL;
+    }
+
+    for (i = 0; i < mod_info->mod_count; ++i) {
+        mod = &mod_info->mods[i];
+
+        if (mod->state & (MOD_INFO_RLOCK | MOD_INFO_RLOCK_UPGR | MOD_INFO_WLOCK | MOD_INFO_RLOCK2)) {
+            /* module is already locked so its data were copied before */
+            continue;
+        }
+
+        if ((err_info = sr_shmmod_run_copy(mod, mod_info->conn->cid, sid))) {
+            return err_info;
+        }
+    }
+
+    return NULL;
+}
+
 /**
  * @brief Lock all modules in a mod info.
  *
@@ -569,6 +666,11 @@ sr_shmmod_modinfo_rdlock(struct sr_mod_info_s *mod_info, int upgradeable, sr_sid
 {
     sr_error_info_t *err_info = NULL;
 
+    /* copy running data before any module is locked */
+    if ((err_info = sr_shmmod_modinfo_run_copy(mod_info, sid))) {
+        return err_info;
+    }
+
     if (upgradeable) {
         /* read-upgr-lock main DS */
         if ((err_info = sr_shmmod_modinfo_lock(mod_info, mod_info->ds, MOD_INFO_RLOCK | MOD_INFO_RLOCK_UPGR
@@ -599,6 +701,11 @@ sr_shmmod_modinfo_wrlock(struct sr_mod_info_s *mod_info, sr_sid_t sid)
 {
     sr_error_info_t *err_info = NULL;
 
+    /* copy running data before any module is locked */
+    if ((err_info = sr_shmmod_modinfo_run_copy(mod_info, sid))) {
+        return err_info;
+    }
+
     /* write-lock main DS */
     if ((err_info = sr_shmmod_modinfo_lock(mod_info, mod_info->ds, MOD_INFO_RLOCK | MOD_INFO_RLOCK_UPGR
             | MOD_INFO_WLOCK, 0, SR_LOCK_WRITE, MOD_INFO_WLOCK, sid))) {
@@ -825,7 +932,7 @@ sr_shmmod_oper_stored_del_conn(sr_conn_ctx_t *conn, sr_cid_t cid)
             if ((err_info = sr_diff_del_conn(&diff, cid))) {
                 goto cleanup;
             }
-            if ((err_info = sr_module_file_data_set(mod->ly_mod->name, SR_DS_OPERATIONAL, diff, 0, SR_FILE_PERM))) {
+            if ((err_info = sr_module_file_oper_data_store(conn, mod, diff))) {
                 goto cleanup;
             }
             lyd_free_withsiblings(diff);
@@ -2755,8 +2755,6 @@ sr_shmsub_rpc_listen_call_callback(struct opsub_rpcsub_s *rpc_sub, sr_session_ct
         sr_sub_event_t event, uint32_t request_id, struct lyd_node **output_op, sr_error_t *err_code)
 {
     sr_error_info_t *err_info = NULL;
-    const struct lyd_node *next, *elem;
-    void *mem;
     char buf[22], *val_str, *op_xpath = NULL;
     sr_val_t *input_vals = NULL, *output_vals = NULL;
     size_t i, input_val_count = 0, output_val_count = 0;
@@ -2786,27 +2784,9 @@ sr_shmsub_rpc_listen_call_callback(struct opsub_rpcsub_s *rpc_sub, sr_session_ct
         op_xpath = lyd_path(input_op);
         SR_CHECK_INT_GOTO(!op_xpath, err_info, cleanup);
 
-        /* prepare input for sr_val CB */
-        input_vals = NULL;
-        input_val_count = 0;
-        LY_TREE_DFS_BEGIN(input_op, next, elem) {
-            /* skip op node */
-            if (elem != input_op) {
-                mem = realloc(input_vals, (input_val_count + 1) * sizeof *input_vals);
-                if (!mem) {
-                    SR_ERRINFO_MEM(&err_info);
-                    goto cleanup;
-                }
-                input_vals = mem;
-
-                if ((err_info = sr_val_ly2sr(elem, &input_vals[input_val_count]))) {
-                    goto cleanup;
-                }
-
-                ++input_val_count;
-            }
-
-            LY_TREE_DFS_END(input_op, next, elem);
+        /* prepare input for sr_val CB, skip op node */
+        if ((err_info = sr_vals_ly2sr_arena(input_op, &input_vals, &input_val_count))) {
+            goto cleanup;
         }
 
         /* callback */
@@ -2859,7 +2839,7 @@ fake_cb_error:
 
 cleanup:
     free(op_xpath);
-    sr_free_values(input_vals, input_val_count);
+    free(input_vals);
     sr_free_values(output_vals, output_val_count);
     if (*err_code && *output_op) {
         /* free the whole output in case of an error */
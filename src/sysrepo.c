@@ -83,9 +83,25 @@ sr_conn_new(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
         goto error5;
     }
 
+    if ((conn->opts & SR_CONN_CACHE_RUNNING) && (err_info = sr_mutex_init(&conn->mod_cache.borrow_lock, 0))) {
+        goto error6;
+    }
+
+    if ((err_info = sr_mutex_init(&conn->oper_cache.lock, 0))) {
+        goto error7;
+    }
+
     *conn_p = conn;
     return NULL;
 
+error7:
+    if (conn->opts & SR_CONN_CACHE_RUNNING) {
+        pthread_mutex_destroy(&conn->mod_cache.borrow_lock);
+    }
+error6:
+    if (conn->opts & SR_CONN_CACHE_RUNNING) {
+        sr_rwlock_destroy(&conn->mod_cache.lock);
+    }
 error5:
     sr_rwlock_destroy(&conn->ext_remap_lock);
 error4:
@@ -111,9 +127,12 @@ sr_conn_free(sr_conn_ctx_t *conn)
         /* free cache before context */
         if (conn->opts & SR_CONN_CACHE_RUNNING) {
             sr_rwlock_destroy(&conn->mod_cache.lock);
+            pthread_mutex_destroy(&conn->mod_cache.borrow_lock);
             lyd_free_withsiblings(conn->mod_cache.data);
             free(conn->mod_cache.mods);
         }
+        pthread_mutex_destroy(&conn->oper_cache.lock);
+        sr_opercache_free(&conn->oper_cache);
 
         ly_ctx_destroy(conn->ly_ctx, NULL);
         pthread_mutex_destroy(&conn->ptr_lock);
@@ -137,6 +156,8 @@ sr_connect(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
     int created = 0, changed;
     sr_main_shm_t *main_shm;
     sr_ext_hole_t *hole;
+    char **run_pending = NULL;
+    uint32_t i, run_pending_count = 0;
 
     SR_CHECK_ARG_APIRET(!conn_p, NULL, err_info);
 
@@ -180,6 +201,11 @@ sr_connect(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
         /* recover anything left in ext SHM */
         sr_shmext_recover_subs_all(conn);
 
+        /* remember modules with running data not yet copied from startup */
+        if ((err_info = sr_shmmain_files_run_pending_get(main_shm, &run_pending, &run_pending_count))) {
+            goto cleanup_unlock;
+        }
+
         /* clear all main SHM modules (if main SHM was just created, there aren't any anyway) */
         if ((err_info = sr_shm_remap(&conn->main_shm, sizeof(sr_main_shm_t)))) {
             goto cleanup_unlock;
@@ -192,6 +218,11 @@ sr_connect(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
             goto cleanup_unlock;
         }
 
+        /* restore the modules with running data not yet copied */
+        sr_shmmain_files_run_pending_set(SR_CONN_MAIN_SHM(conn), run_pending, run_pending_count);
+        run_pending = NULL;
+        run_pending_count = 0;
+
         assert((conn->ext_shm.size == SR_SHM_SIZE(sizeof(sr_ext_shm_t))) || sr_ext_hole_next(NULL, SR_CONN_EXT_SHM(conn)));
         if ((hole = sr_ext_hole_next(NULL, SR_CONN_EXT_SHM(conn)))) {
             /* there is something in ext SHM, is it only a single memory hole? */
@@ -207,6 +238,11 @@ sr_connect(const sr_conn_options_t opts, sr_conn_ctx_t **conn_p)
             SR_CONN_EXT_SHM(conn)->first_hole_off = 0;
         }
 
+        /* remove temporary startup files of interrupted writes */
+        if ((err_info = sr_shmmain_files_startup_clean(SR_CONN_MAIN_SHM(conn), conn->cid))) {
+            goto cleanup_unlock;
+        }
+
         /* copy full datastore from <startup> to <running> */
         if ((err_info = sr_shmmain_files_startup2running(SR_CONN_MAIN_SHM(conn), created))) {
             goto cleanup_unlock;
@@ -231,6 +267,10 @@ cleanup_unlock:
 
 cleanup:
     lyd_free_withsiblings(sr_mods);
+    for (i = 0; i < run_pending_count; ++i) {
+        free(run_pending[i]);
+    }
+    free(run_pending);
     if (err_info) {
         sr_conn_free(conn);
         if (created) {
@@ -499,6 +539,8 @@ _sr_session_stop(sr_session_ctx_t *session)
         lyd_free_withsiblings(session->dt[i].edit);
         lyd_free_withsiblings(session->dt[i].diff);
     }
+    lyd_free_withsiblings(session->snapshot.data);
+    ly_set_clean(&session->snapshot.mod_set);
     sr_errinfo_free(&session->err_info);
     pthread_mutex_destroy(&session->ptr_lock);
     sr_rwlock_destroy(&session->notif_buf.lock);
@@ -863,52 +905,95 @@ cleanup:
     return ly_mod;
 }
 
-API int
-sr_install_module(sr_conn_ctx_t *conn, const char *schema_path, const char *search_dirs, const char **features,
-        int feat_count)
+/**
+ * @brief Parse a YANG module into a context that may already contain it as an import of another parsed module.
+ *
+ * @param[in] ly_ctx Context to use.
+ * @param[in] mod_name Name of the module.
+ * @param[in] schema_path Path to the module file.
+ * @param[in] format Module format.
+ * @param[in] search_dirs Optional search dirs, in format <dir>[:<dir>]*.
+ * @return Parsed (implemented) module, NULL on error.
+ */
+static const struct lys_module *
+sr_parse_module_implement(struct ly_ctx *ly_ctx, const char *mod_name, const char *schema_path, LYS_INFORMAT format,
+        const char *search_dirs)
+{
+    const struct lys_module *ly_mod;
+
+    ly_mod = ly_ctx_get_module(ly_ctx, mod_name, NULL, 0);
+    if (ly_mod) {
+        /* loaded as an import of a module installed in the same batch, it only needs to be implemented */
+        if (!ly_mod->implemented && lys_set_implemented(ly_mod)) {
+            return NULL;
+        }
+        return ly_mod;
+    }
+
+    return sr_parse_module(ly_ctx, schema_path, format, search_dirs);
+}
+
+/**
+ * @brief Parse and check a new module to be installed. Nothing is changed in sysrepo.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] tmp_ly_ctx Temporary context to parse the module into, may already contain other new modules.
+ * @param[in] schema_path Path to the module file.
+ * @param[in] search_dirs Optional search dirs, in format <dir>[:<dir>]*.
+ * @param[in] features Array of enabled features.
+ * @param[in] feat_count Number of enabled features.
+ * @param[out] ly_mod_p Parsed module.
+ * @param[out] installed Set if the module is already installed and can only be unscheduled from deletion.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_install_module_prepare(sr_conn_ctx_t *conn, struct ly_ctx *tmp_ly_ctx, const char *schema_path,
+        const char *search_dirs, const char **features, int feat_count, const struct lys_module **ly_mod_p, int *installed)
 {
     sr_error_info_t *err_info = NULL;
-    struct ly_ctx *tmp_ly_ctx = NULL;
     const struct lys_module *ly_mod, *ly_iter, *ly_iter2;
+    struct ly_set *impl_set = NULL;
     LYS_INFORMAT format;
     char *mod_name = NULL;
     uint32_t i;
 
-    SR_CHECK_ARG_APIRET(!conn || !schema_path, NULL, err_info);
-
-    /* create new temporary context */
-    if ((err_info = sr_ly_ctx_new(&tmp_ly_ctx))) {
-        return sr_api_ret(NULL, err_info);
-    }
+    *ly_mod_p = NULL;
+    *installed = 0;
 
     /* learn module name and format */
     if ((err_info = sr_get_module_name_format(schema_path, &mod_name, &format))) {
         goto cleanup;
     }
 
+    /* remember the modules implemented so far so that only the ones implemented by this module are checked */
+    impl_set = ly_set_new();
+    SR_CHECK_MEM_GOTO(!impl_set, err_info, cleanup);
+    i = 0;
+    while ((ly_iter = ly_ctx_get_module_iter(tmp_ly_ctx, &i))) {
+        if (ly_iter->implemented) {
+            ly_set_add(impl_set, (void *)ly_iter, LY_SET_OPT_USEASLIST);
+        }
+    }
+
     /* check whether the module is not already in the context */
     ly_mod = ly_ctx_get_module(conn->ly_ctx, mod_name, NULL, 1);
     if (ly_mod && ly_mod->implemented) {
         /* it is currently in the context, try to parse it again to check revisions */
-        ly_mod = sr_parse_module(tmp_ly_ctx, schema_path, format, search_dirs);
+        ly_mod = sr_parse_module_implement(tmp_ly_ctx, mod_name, schema_path, format, search_dirs);
         if (!ly_mod) {
             sr_errinfo_new_ly_first(&err_info, tmp_ly_ctx);
             sr_errinfo_new(&err_info, SR_ERR_EXISTS, NULL, "Module \"%s\" is already in sysrepo.", mod_name);
             goto cleanup;
         }
 
-        /* same modules, so if it is scheduled for deletion, we can unschedule it */
-        err_info = sr_lydmods_unsched_del_module_with_imps(SR_CONN_MAIN_SHM(conn), conn->ly_ctx, ly_mod);
-        if (err_info && (err_info->err_code == SR_ERR_NOT_FOUND)) {
-            sr_errinfo_free(&err_info);
-            sr_errinfo_new(&err_info, SR_ERR_EXISTS, NULL, "Module \"%s\" is already in sysrepo.", ly_mod->name);
-            goto cleanup;
-        }
+        /* same modules, so if it is scheduled for deletion, it can be unscheduled */
+        *ly_mod_p = ly_mod;
+        *installed = 1;
         goto cleanup;
     }
 
     /* parse the module */
-    if (!(ly_mod = sr_parse_module(tmp_ly_ctx, schema_path, format, search_dirs))) {
+    if (!(ly_mod = sr_parse_module_implement(tmp_ly_ctx, mod_name, schema_path, format, search_dirs))) {
         sr_errinfo_new_ly(&err_info, tmp_ly_ctx);
         goto cleanup;
     }
@@ -925,7 +1010,8 @@ sr_install_module(sr_conn_ctx_t *conn, const char *schema_path, const char *sear
     /* check that the module does not implement some other modules in different revisions than already in the context */
     i = 0;
     while ((ly_iter = ly_ctx_get_module_iter(tmp_ly_ctx, &i))) {
-        if (!ly_iter->implemented) {
+        if (!ly_iter->implemented || (ly_set_contains(impl_set, (void *)ly_iter) > -1)) {
+            /* not implemented or implemented by a previous module in the batch */
             continue;
         }
 
@@ -944,21 +1030,137 @@ sr_install_module(sr_conn_ctx_t *conn, const char *schema_path, const char *sear
         }
     }
 
-    /* schedule module installation */
-    if ((err_info = sr_lydmods_deferred_add_module(SR_CONN_MAIN_SHM(conn), conn->ly_ctx, ly_mod, features, feat_count))) {
-        goto cleanup;
+    /* success */
+    *ly_mod_p = ly_mod;
+
+cleanup:
+    ly_set_free(impl_set);
+    free(mod_name);
+    return err_info;
+}
+
+/**
+ * @brief Install new modules into sysrepo. All the modules are parsed into a single temporary context
+ * and checked first, only then are they scheduled for installation at once.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] schema_paths Array of paths to the module files.
+ * @param[in] count Number of modules.
+ * @param[in] search_dirs Optional search dirs, in format <dir>[:<dir>]*.
+ * @param[in] features Optional array of arrays of enabled features for each module.
+ * @param[in] feat_counts Array of numbers of enabled features for each module, must be set if @p features are.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_install_modules(sr_conn_ctx_t *conn, const char **schema_paths, uint32_t count, const char *search_dirs,
+        const char ***features, const int *feat_counts)
+{
+    sr_error_info_t *err_info = NULL, *exists_err = NULL;
+    struct ly_ctx *tmp_ly_ctx = NULL;
+    const struct lys_module **ly_mods = NULL, **unsched_mods = NULL, *ly_mod;
+    const char ***mod_features = NULL;
+    int *mod_feat_counts = NULL, installed;
+    uint32_t i, mod_count = 0, unsched_count = 0;
+
+    /* create new temporary context */
+    if ((err_info = sr_ly_ctx_new(&tmp_ly_ctx))) {
+        return err_info;
     }
 
-    /* store new module imports */
-    if ((err_info = sr_create_module_imps_incs_r(ly_mod))) {
+    ly_mods = malloc(count * sizeof *ly_mods);
+    unsched_mods = malloc(count * sizeof *unsched_mods);
+    mod_features = malloc(count * sizeof *mod_features);
+    mod_feat_counts = malloc(count * sizeof *mod_feat_counts);
+    if (!ly_mods || !unsched_mods || !mod_features || !mod_feat_counts) {
+        SR_ERRINFO_MEM(&err_info);
         goto cleanup;
     }
 
+    /* parse and check all the modules, nothing is changed yet */
+    for (i = 0; i < count; ++i) {
+        mod_features[mod_count] = features ? features[i] : NULL;
+        mod_feat_counts[mod_count] = features ? feat_counts[i] : 0;
+        err_info = sr_install_module_prepare(conn, tmp_ly_ctx, schema_paths[i], search_dirs, mod_features[mod_count],
+                mod_feat_counts[mod_count], &ly_mod, &installed);
+        if (err_info && (err_info->err_code == SR_ERR_EXISTS)) {
+            /* remember the error but install the other modules */
+            sr_errinfo_merge(&exists_err, err_info);
+            err_info = NULL;
+            continue;
+        } else if (err_info) {
+            goto cleanup;
+        }
+
+        if (installed) {
+            unsched_mods[unsched_count++] = ly_mod;
+        } else {
+            ly_mods[mod_count++] = ly_mod;
+        }
+    }
+
+    if (mod_count) {
+        /* schedule installation of all the modules */
+        if ((err_info = sr_lydmods_deferred_add_modules(SR_CONN_MAIN_SHM(conn), conn->ly_ctx, ly_mods, mod_features,
+                mod_feat_counts, mod_count))) {
+            goto cleanup;
+        }
+
+        /* store new module imports */
+        for (i = 0; i < mod_count; ++i) {
+            if ((err_info = sr_create_module_imps_incs_r(ly_mods[i]))) {
+                goto cleanup;
+            }
+        }
+    }
+
+    /* everything else succeeded, unschedule deletion of the installed ones */
+    for (i = 0; i < unsched_count; ++i) {
+        err_info = sr_lydmods_unsched_del_module_with_imps(SR_CONN_MAIN_SHM(conn), conn->ly_ctx, unsched_mods[i]);
+        if (err_info && (err_info->err_code == SR_ERR_NOT_FOUND)) {
+            /* not scheduled for deletion */
+            sr_errinfo_free(&err_info);
+            sr_errinfo_new(&exists_err, SR_ERR_EXISTS, NULL, "Module \"%s\" is already in sysrepo.", unsched_mods[i]->name);
+        } else if (err_info) {
+            goto cleanup;
+        }
+    }
+
     /* success */
 
 cleanup:
     ly_ctx_destroy(tmp_ly_ctx, NULL);
-    free(mod_name);
+    free(ly_mods);
+    free(unsched_mods);
+    free(mod_features);
+    free(mod_feat_counts);
+    if (err_info) {
+        sr_errinfo_free(&exists_err);
+        return err_info;
+    }
+    return exists_err;
+}
+
+API int
+sr_install_module(sr_conn_ctx_t *conn, const char *schema_path, const char *search_dirs, const char **features,
+        int feat_count)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!conn || !schema_path, NULL, err_info);
+
+    err_info = _sr_install_modules(conn, &schema_path, 1, search_dirs, &features, &feat_count);
+    return sr_api_ret(NULL, err_info);
+}
+
+API int
+sr_install_modules(sr_conn_ctx_t *conn, const char **schema_paths, uint32_t count, const char *search_dirs,
+        const char ***features, const int *feat_counts)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!conn || !schema_paths || !count || (features && !feat_counts), NULL, err_info);
+
+    err_info = _sr_install_modules(conn, schema_paths, count, search_dirs, features, feat_counts);
     return sr_api_ret(NULL, err_info);
 }
 
@@ -1356,6 +1558,74 @@ sr_get_module_info(sr_conn_ctx_t *conn, struct lyd_node **sysrepo_data)
     return sr_api_ret(NULL, err_info);
 }
 
+/**
+ * @brief Get mod info options for loading data of a get request.
+ *
+ * @param[in] session Session to use.
+ * @return Mod info options.
+ */
+static int
+sr_get_mi_opts(sr_session_ctx_t *session)
+{
+    int mi_opts = SR_MI_DATA_CACHE | SR_MI_PERM_READ;
+
+    if (!session->dt[session->ds].edit && (session->ev != SR_SUB_EV_CHANGE) && (session->ev != SR_SUB_EV_UPDATE)) {
+        /* no changes that could reference any other data will be applied on the loaded data */
+        mi_opts |= SR_MI_DATA_PRUNE;
+    }
+
+    return mi_opts;
+}
+
+/**
+ * @brief Select data from the session snapshot, if there is one covering all the required modules.
+ *
+ * @param[in] session Session to use.
+ * @param[in] mod_set Set of the required modules.
+ * @param[in] xpath XPath selecting the data.
+ * @param[in] opts Get oper data options.
+ * @param[out] set Set of the selected nodes, NULL if the snapshot cannot be used.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_session_snapshot_filter(sr_session_ctx_t *session, const struct ly_set *mod_set, const char *xpath,
+        sr_get_oper_options_t opts, struct ly_set **set)
+{
+    sr_error_info_t *err_info = NULL;
+    uint32_t i;
+
+    *set = NULL;
+
+    if (!session->snapshot.active || (session->snapshot.ds != session->ds) || (session->snapshot.opts != opts)) {
+        /* no usable snapshot */
+        return NULL;
+    }
+
+    if (session->snapshot.mod_set.number) {
+        if (!mod_set->number) {
+            /* all the modules are required */
+            return NULL;
+        }
+        for (i = 0; i < mod_set->number; ++i) {
+            if (ly_set_contains(&session->snapshot.mod_set, mod_set->set.g[i]) == -1) {
+                /* module not in the snapshot */
+                return NULL;
+            }
+        }
+    }
+
+    /* filter the pinned data */
+    if (session->snapshot.data) {
+        *set = lyd_find_path(session->snapshot.data, xpath);
+        SR_CHECK_LY_RET(!*set, session->conn->ly_ctx, err_info);
+    } else {
+        *set = ly_set_new();
+        SR_CHECK_MEM_RET(!*set, err_info);
+    }
+
+    return NULL;
+}
+
 API int
 sr_get_item(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr_val_t **value)
 {
@@ -1377,15 +1647,22 @@ sr_get_item(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms, sr
         goto cleanup;
     }
 
-    /* add modules into mod_info with deps, locking, and their data */
-    if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_READ, SR_MI_DATA_CACHE | SR_MI_PERM_READ,
-            session->sid, path, timeout_ms, 0))) {
+    /* use the session snapshot, if possible */
+    if ((err_info = sr_session_snapshot_filter(session, &mod_set, path, 0, &set))) {
         goto cleanup;
     }
 
-    /* filter the required data */
-    if ((err_info = sr_modinfo_get_filter(&mod_info, path, session, &set))) {
-        goto cleanup;
+    if (!set) {
+        /* add modules into mod_info with deps, locking, and their data */
+        if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_READ, sr_get_mi_opts(session),
+                session->sid, path, timeout_ms, 0))) {
+            goto cleanup;
+        }
+
+        /* filter the required data */
+        if ((err_info = sr_modinfo_get_filter(&mod_info, path, session, &set))) {
+            goto cleanup;
+        }
     }
 
     if (set->number > 1) {
@@ -1416,18 +1693,27 @@ cleanup:
     return sr_api_ret(session, err_info);
 }
 
-API int
-sr_get_items(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms, const sr_get_oper_options_t opts,
+/**
+ * @brief Get items selected by an XPath.
+ *
+ * @param[in] session Session to use.
+ * @param[in] xpath XPath of the items.
+ * @param[in] prepared Prepared @p xpath, if any.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds.
+ * @param[out] values Array of the items.
+ * @param[out] value_cnt Count of @p values.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_get_items(sr_session_ctx_t *session, const char *xpath, struct sr_xpath_prepared_s *prepared, uint32_t timeout_ms,
         sr_val_t **values, size_t *value_cnt)
 {
     sr_error_info_t *err_info = NULL;
     struct ly_set *set = NULL, mod_set = {0};
+    const struct ly_set *mod_set_p;
     struct sr_mod_info_s mod_info;
     uint32_t i;
 
-    SR_CHECK_ARG_APIRET(!session || !xpath || !values || !value_cnt || ((session->ds != SR_DS_OPERATIONAL) && opts),
-            session, err_info);
-
     if (!timeout_ms) {
         timeout_ms = SR_OPER_CB_TIMEOUT;
     }
@@ -1435,21 +1721,35 @@ sr_get_items(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms,
     *value_cnt = 0;
     /* for operational, use operational and running datastore */
     SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
+    mod_info.prepared = prepared;
 
-    /* collect all required modules */
-    if ((err_info = sr_shmmod_collect_xpath(session->conn->ly_ctx, xpath, session->ds, &mod_set))) {
-        goto cleanup;
+    if (prepared) {
+        /* required modules were collected when preparing */
+        mod_set_p = SR_IS_CONVENTIONAL_DS(session->ds) ? &prepared->conv_mod_set : &prepared->oper_mod_set;
+    } else {
+        /* collect all required modules */
+        if ((err_info = sr_shmmod_collect_xpath(session->conn->ly_ctx, xpath, session->ds, &mod_set))) {
+            goto cleanup;
+        }
+        mod_set_p = &mod_set;
     }
 
-    /* add modules into mod_info with deps, locking, and their data */
-    if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_READ, SR_MI_DATA_CACHE | SR_MI_PERM_READ,
-            session->sid, xpath, timeout_ms, 0))) {
+    /* use the session snapshot, if possible */
+    if ((err_info = sr_session_snapshot_filter(session, mod_set_p, xpath, 0, &set))) {
         goto cleanup;
     }
 
-    /* filter the required data */
-    if ((err_info = sr_modinfo_get_filter(&mod_info, xpath, session, &set))) {
-        goto cleanup;
+    if (!set) {
+        /* add modules into mod_info with deps, locking, and their data */
+        if ((err_info = sr_modinfo_add_modules(&mod_info, mod_set_p, 0, SR_LOCK_READ, sr_get_mi_opts(session),
+                session->sid, xpath, timeout_ms, 0))) {
+            goto cleanup;
+        }
+
+        /* filter the required data */
+        if ((err_info = sr_modinfo_get_filter(&mod_info, xpath, session, &set))) {
+            goto cleanup;
+        }
     }
 
     if (set->number) {
@@ -1478,6 +1778,19 @@ cleanup:
         *values = NULL;
         *value_cnt = 0;
     }
+    return err_info;
+}
+
+API int
+sr_get_items(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms, const sr_get_oper_options_t opts,
+        sr_val_t **values, size_t *value_cnt)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !xpath || !values || !value_cnt || ((session->ds != SR_DS_OPERATIONAL) && opts),
+            session, err_info);
+
+    err_info = _sr_get_items(session, xpath, NULL, timeout_ms, values, value_cnt);
     return sr_api_ret(session, err_info);
 }
 
@@ -1501,15 +1814,22 @@ sr_get_subtree(sr_session_ctx_t *session, const char *path, uint32_t timeout_ms,
         goto cleanup;
     }
 
-    /* add modules into mod_info with deps, locking, and their data */
-    if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_READ, SR_MI_DATA_CACHE | SR_MI_PERM_READ,
-            session->sid, path, timeout_ms, 0))) {
+    /* use the session snapshot, if possible */
+    if ((err_info = sr_session_snapshot_filter(session, &mod_set, path, 0, &set))) {
         goto cleanup;
     }
 
-    /* filter the required data */
-    if ((err_info = sr_modinfo_get_filter(&mod_info, path, session, &set))) {
-        goto cleanup;
+    if (!set) {
+        /* add modules into mod_info with deps, locking, and their data */
+        if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_READ, sr_get_mi_opts(session),
+                session->sid, path, timeout_ms, 0))) {
+            goto cleanup;
+        }
+
+        /* filter the required data */
+        if ((err_info = sr_modinfo_get_filter(&mod_info, path, session, &set))) {
+            goto cleanup;
+        }
     }
 
     if (set->number > 1) {
@@ -1539,18 +1859,26 @@ cleanup:
     return sr_api_ret(session, err_info);
 }
 
-API int
-sr_get_data(sr_session_ctx_t *session, const char *xpath, uint32_t max_depth, uint32_t timeout_ms,
-        const sr_get_oper_options_t opts, struct lyd_node **data)
+/**
+ * @brief Get data selected by an XPath.
+ *
+ * @param[in] session Session to use.
+ * @param[in] xpath XPath of the data.
+ * @param[in] prepared Prepared @p xpath, if any.
+ * @param[in] max_depth Maximum depth of the selected subtrees.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds.
+ * @param[in] opts Get oper data options.
+ * @param[out] data Selected data.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_get_data(sr_session_ctx_t *session, const char *xpath, struct sr_xpath_prepared_s *prepared, uint32_t max_depth,
+        uint32_t timeout_ms, const sr_get_oper_options_t opts, struct lyd_node **data)
 {
     sr_error_info_t *err_info = NULL;
-    uint32_t i;
-    int dup_opts;
     struct sr_mod_info_s mod_info;
     struct ly_set *subtrees = NULL, mod_set = {0};
-    struct lyd_node *node;
-
-    SR_CHECK_ARG_APIRET(!session || !xpath || !data || ((session->ds != SR_DS_OPERATIONAL) && opts), session, err_info);
+    const struct ly_set *mod_set_p;
 
     if (!timeout_ms) {
         timeout_ms = SR_OPER_CB_TIMEOUT;
@@ -1558,59 +1886,40 @@ sr_get_data(sr_session_ctx_t *session, const char *xpath, uint32_t max_depth, ui
     *data = NULL;
     /* for operational, use operational and running datastore */
     SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
+    mod_info.prepared = prepared;
 
-    /* collect all required modules */
-    if ((err_info = sr_shmmod_collect_xpath(session->conn->ly_ctx, xpath, session->ds, &mod_set))) {
-        goto cleanup;
-    }
-
-    /* add modules into mod_info with deps, locking, and their data */
-    if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_READ, SR_MI_DATA_CACHE | SR_MI_PERM_READ,
-            session->sid, xpath, timeout_ms, opts))) {
-        goto cleanup;
+    if (prepared) {
+        /* required modules were collected when preparing */
+        mod_set_p = SR_IS_CONVENTIONAL_DS(session->ds) ? &prepared->conv_mod_set : &prepared->oper_mod_set;
+    } else {
+        /* collect all required modules */
+        if ((err_info = sr_shmmod_collect_xpath(session->conn->ly_ctx, xpath, session->ds, &mod_set))) {
+            goto cleanup;
+        }
+        mod_set_p = &mod_set;
     }
 
-    /* filter the required data */
-    if ((err_info = sr_modinfo_get_filter(&mod_info, xpath, session, &subtrees))) {
+    /* use the session snapshot, if possible */
+    if ((err_info = sr_session_snapshot_filter(session, mod_set_p, xpath, opts, &subtrees))) {
         goto cleanup;
     }
 
-    /* duplicate all returned subtrees with their parents and merge into one data tree */
-    for (i = 0; i < subtrees->number; ++i) {
-        dup_opts = (max_depth ? 0 : LYD_DUP_OPT_RECURSIVE) | LYD_DUP_OPT_WITH_PARENTS | LYD_DUP_OPT_WITH_KEYS | LYD_DUP_OPT_WITH_WHEN;
-        node = lyd_dup(subtrees->set.d[i], dup_opts);
-        if (!node) {
-            sr_errinfo_new_ly(&err_info, session->conn->ly_ctx);
-            lyd_free_withsiblings(*data);
-            *data = NULL;
+    if (!subtrees) {
+        /* add modules into mod_info with deps, locking, and their data */
+        if ((err_info = sr_modinfo_add_modules(&mod_info, mod_set_p, 0, SR_LOCK_READ, sr_get_mi_opts(session),
+                session->sid, xpath, timeout_ms, opts))) {
             goto cleanup;
         }
 
-        /* duplicate only to the specified depth */
-        if ((err_info = sr_lyd_dup(subtrees->set.d[i], max_depth ? max_depth - 1 : 0, node))) {
-            lyd_free_withsiblings(node);
-            lyd_free_withsiblings(*data);
-            *data = NULL;
+        /* filter the required data */
+        if ((err_info = sr_modinfo_get_filter(&mod_info, xpath, session, &subtrees))) {
             goto cleanup;
         }
+    }
 
-        /* always find parent */
-        while (node->parent) {
-            node = node->parent;
-        }
-
-        /* connect to the result */
-        if (!*data) {
-            *data = node;
-        } else {
-            if (lyd_merge(*data, node, LYD_OPT_DESTRUCT | LYD_OPT_EXPLICIT)) {
-                sr_errinfo_new_ly(&err_info, session->conn->ly_ctx);
-                lyd_free_withsiblings(node);
-                lyd_free_withsiblings(*data);
-                *data = NULL;
-                goto cleanup;
-            }
-        }
+    /* duplicate all returned subtrees with their parents into one data tree */
+    if ((err_info = sr_lyd_dup_subtrees(subtrees, max_depth, data))) {
+        goto cleanup;
     }
 
     /* success */
@@ -1622,17 +1931,179 @@ cleanup:
     ly_set_free(subtrees);
     ly_set_clean(&mod_set);
     sr_modinfo_free(&mod_info);
-    return sr_api_ret(session, err_info);
+    return err_info;
 }
 
-API void
-sr_free_val(sr_val_t *value)
-{
-    if (!value) {
+API int
+sr_get_data(sr_session_ctx_t *session, const char *xpath, uint32_t max_depth, uint32_t timeout_ms,
+        const sr_get_oper_options_t opts, struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !xpath || !data || ((session->ds != SR_DS_OPERATIONAL) && opts), session, err_info);
+
+    err_info = _sr_get_data(session, xpath, NULL, max_depth, timeout_ms, opts, data);
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_get_data_multi(sr_session_ctx_t *session, const char **xpaths, uint32_t xpath_count, uint32_t max_depth,
+        uint32_t timeout_ms, const sr_get_oper_options_t opts, struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+    char *xpath = NULL;
+    size_t len;
+    uint32_t i;
+
+    SR_CHECK_ARG_APIRET(!session || !xpaths || !xpath_count || !data || ((session->ds != SR_DS_OPERATIONAL) && opts),
+            session, err_info);
+
+    /* unite all the XPaths so that modules are collected, loaded, and providers called only once */
+    len = 1;
+    for (i = 0; i < xpath_count; ++i) {
+        SR_CHECK_ARG_APIRET(!xpaths[i], session, err_info);
+        len += strlen(xpaths[i]) + 3;
+    }
+    xpath = malloc(len);
+    SR_CHECK_MEM_GOTO(!xpath, err_info, cleanup);
+
+    len = 0;
+    for (i = 0; i < xpath_count; ++i) {
+        len += sprintf(xpath + len, "%s%s", i ? " | " : "", xpaths[i]);
+    }
+
+    err_info = _sr_get_data(session, xpath, NULL, max_depth, timeout_ms, opts, data);
+
+cleanup:
+    free(xpath);
+    return sr_api_ret(session, err_info);
+}
+
+/**
+ * @brief Borrow data selected by an XPath.
+ *
+ * @param[in] session Session to use.
+ * @param[in] xpath XPath of the data.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds.
+ * @param[in] opts Get oper data options.
+ * @param[out] data Borrowed data with the selected nodes.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+_sr_get_data_borrowed(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms,
+        const sr_get_oper_options_t opts, sr_borrowed_data_t **data)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_info_s mod_info;
+    struct ly_set *set = NULL, mod_set = {0};
+
+    if (!timeout_ms) {
+        timeout_ms = SR_OPER_CB_TIMEOUT;
+    }
+    *data = NULL;
+    /* for operational, use operational and running datastore */
+    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
+
+    /* collect all required modules */
+    if ((err_info = sr_shmmod_collect_xpath(session->conn->ly_ctx, xpath, session->ds, &mod_set))) {
+        goto cleanup;
+    }
+
+    /* use the session snapshot, if possible */
+    if ((err_info = sr_session_snapshot_filter(session, &mod_set, xpath, opts, &set))) {
+        goto cleanup;
+    }
+
+    if (!set) {
+        /* add modules into mod_info with deps, locking, and their data */
+        if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_READ, sr_get_mi_opts(session),
+                session->sid, xpath, timeout_ms, opts))) {
+            goto cleanup;
+        }
+
+        /* filter the required data */
+        if ((err_info = sr_modinfo_get_filter(&mod_info, xpath, session, &set))) {
+            goto cleanup;
+        }
+    }
+
+    *data = calloc(1, sizeof **data);
+    SR_CHECK_MEM_GOTO(!*data, err_info, cleanup);
+    (*data)->conn = session->conn;
+
+    /* take over the data, cached data are only referenced so that they are not freed until released */
+    if (mod_info.data_cached) {
+        if ((err_info = sr_modcache_borrow(session->conn, *data))) {
+            goto cleanup;
+        }
+    } else {
+        (*data)->data = mod_info.data;
+        mod_info.data = NULL;
+    }
+
+    (*data)->nodes = set;
+    set = NULL;
+
+    /* success */
+
+cleanup:
+    /* MODULES UNLOCK */
+    sr_shmmod_modinfo_unlock(&mod_info, session->sid);
+
+    if (err_info && *data) {
+        free(*data);
+        *data = NULL;
+    }
+    ly_set_free(set);
+    ly_set_clean(&mod_set);
+    sr_modinfo_free(&mod_info);
+    return err_info;
+}
+
+API int
+sr_get_data_borrowed(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms,
+        const sr_get_oper_options_t opts, sr_borrowed_data_t **data, const struct ly_set **nodes)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !xpath || !data || !nodes || ((session->ds != SR_DS_OPERATIONAL) && opts),
+            session, err_info);
+
+    *nodes = NULL;
+    if ((err_info = _sr_get_data_borrowed(session, xpath, timeout_ms, opts, data))) {
+        return sr_api_ret(session, err_info);
+    }
+
+    *nodes = (*data)->nodes;
+    return sr_api_ret(session, NULL);
+}
+
+API void
+sr_release_data(sr_borrowed_data_t *data)
+{
+    if (!data) {
         return;
     }
 
+    ly_set_free(data->nodes);
+    if (data->cache_borrow) {
+        sr_modcache_borrow_release(data);
+    } else {
+        lyd_free_withsiblings(data->data);
+    }
+    free(data);
+}
+
+/**
+ * @brief Free all memory allocated within a value.
+ *
+ * @param[in] value Value to free the content of.
+ */
+static void
+sr_free_val_content(sr_val_t *value)
+{
     free(value->xpath);
+    free(value->origin);
     switch (value->type) {
     case SR_BINARY_T:
     case SR_BITS_T:
@@ -1648,7 +2119,236 @@ sr_free_val(sr_val_t *value)
         /* nothing to free */
         break;
     }
+}
+
+API int
+sr_get_items_iter(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms, const sr_get_oper_options_t opts,
+        sr_val_iter_t **iter)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !xpath || !iter || ((session->ds != SR_DS_OPERATIONAL) && opts), session, err_info);
+
+    *iter = calloc(1, sizeof **iter);
+    SR_CHECK_MEM_GOTO(!*iter, err_info, cleanup);
+
+    /* only select the nodes, values are created one by one */
+    if ((err_info = _sr_get_data_borrowed(session, xpath, timeout_ms, opts, &(*iter)->data))) {
+        goto cleanup;
+    }
+
+cleanup:
+    if (err_info) {
+        free(*iter);
+        *iter = NULL;
+    }
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_get_item_next(sr_session_ctx_t *session, sr_val_iter_t *iter, sr_val_t **value)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !iter || !value, session, err_info);
+
+    /* free the previous value */
+    sr_free_val_content(&iter->val);
+    memset(&iter->val, 0, sizeof iter->val);
+    *value = NULL;
+
+    if (iter->idx == iter->data->nodes->number) {
+        return SR_ERR_NOT_FOUND;
+    }
+
+    /* create the next value */
+    if ((err_info = sr_val_ly2sr(iter->data->nodes->set.d[iter->idx], &iter->val))) {
+        memset(&iter->val, 0, sizeof iter->val);
+        return sr_api_ret(session, err_info);
+    }
+    ++iter->idx;
+
+    *value = &iter->val;
+    return sr_api_ret(session, NULL);
+}
+
+API void
+sr_free_val_iter(sr_val_iter_t *iter)
+{
+    if (!iter) {
+        return;
+    }
+
+    sr_free_val_content(&iter->val);
+    sr_release_data(iter->data);
+    free(iter);
+}
 
+API int
+sr_xpath_prepare(sr_conn_ctx_t *conn, const char *xpath, sr_xpath_prepared_t **prepared)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!conn || !xpath || !prepared, NULL, err_info);
+
+    *prepared = calloc(1, sizeof **prepared);
+    SR_CHECK_MEM_GOTO(!*prepared, err_info, cleanup);
+    (*prepared)->conn = conn;
+    (*prepared)->xpath = strdup(xpath);
+    SR_CHECK_MEM_GOTO(!(*prepared)->xpath, err_info, cleanup);
+
+    /* collect all required modules for both kinds of datastores */
+    if ((err_info = sr_shmmod_collect_xpath(conn->ly_ctx, xpath, SR_DS_RUNNING, &(*prepared)->conv_mod_set))) {
+        goto cleanup;
+    }
+    if ((err_info = sr_shmmod_collect_xpath(conn->ly_ctx, xpath, SR_DS_OPERATIONAL, &(*prepared)->oper_mod_set))) {
+        goto cleanup;
+    }
+
+cleanup:
+    if (err_info) {
+        sr_xpath_prepared_free(*prepared);
+        *prepared = NULL;
+    }
+    return sr_api_ret(NULL, err_info);
+}
+
+API int
+sr_get_items_prepared(sr_session_ctx_t *session, sr_xpath_prepared_t *prepared, uint32_t timeout_ms,
+        const sr_get_oper_options_t opts, sr_val_t **values, size_t *value_cnt)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !prepared || (prepared->conn != session->conn) || !values || !value_cnt ||
+            ((session->ds != SR_DS_OPERATIONAL) && opts), session, err_info);
+
+    err_info = _sr_get_items(session, prepared->xpath, prepared, timeout_ms, values, value_cnt);
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_get_data_prepared(sr_session_ctx_t *session, sr_xpath_prepared_t *prepared, uint32_t max_depth,
+        uint32_t timeout_ms, const sr_get_oper_options_t opts, struct lyd_node **data)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !prepared || (prepared->conn != session->conn) || !data ||
+            ((session->ds != SR_DS_OPERATIONAL) && opts), session, err_info);
+
+    err_info = _sr_get_data(session, prepared->xpath, prepared, max_depth, timeout_ms, opts, data);
+    return sr_api_ret(session, err_info);
+}
+
+API void
+sr_xpath_prepared_free(sr_xpath_prepared_t *prepared)
+{
+    uint32_t i;
+
+    if (!prepared) {
+        return;
+    }
+
+    for (i = 0; i < prepared->mod_count; ++i) {
+        free(prepared->mods[i].oper_required);
+    }
+    free(prepared->mods);
+    ly_set_clean(&prepared->conv_mod_set);
+    ly_set_clean(&prepared->oper_mod_set);
+    free(prepared->xpath);
+    free(prepared);
+}
+
+API int
+sr_session_snapshot_begin(sr_session_ctx_t *session, const char **module_names, uint32_t module_count,
+        uint32_t timeout_ms, const sr_get_oper_options_t opts)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_info_s mod_info;
+    struct ly_set mod_set = {0};
+    const struct lys_module *ly_mod;
+    struct lyd_node *data = NULL;
+    uint32_t i;
+
+    SR_CHECK_ARG_APIRET(!session || (module_count && !module_names) || ((session->ds != SR_DS_OPERATIONAL) && opts),
+            session, err_info);
+
+    if (session->snapshot.active) {
+        sr_errinfo_new(&err_info, SR_ERR_EXISTS, NULL, "Session snapshot was already started.");
+        return sr_api_ret(session, err_info);
+    }
+
+    if (!timeout_ms) {
+        timeout_ms = SR_OPER_CB_TIMEOUT;
+    }
+    /* for operational, use operational and running datastore */
+    SR_MODINFO_INIT(mod_info, session->conn, session->ds, session->ds == SR_DS_OPERATIONAL ? SR_DS_RUNNING : session->ds);
+
+    /* collect all the modules, none means all of them */
+    for (i = 0; i < module_count; ++i) {
+        ly_mod = ly_ctx_get_module(session->conn->ly_ctx, module_names[i], NULL, 1);
+        if (!ly_mod) {
+            sr_errinfo_new(&err_info, SR_ERR_NOT_FOUND, NULL, "Module \"%s\" was not found in sysrepo.", module_names[i]);
+            goto cleanup;
+        }
+        ly_set_add(&mod_set, (void *)ly_mod, 0);
+    }
+
+    /* add modules into mod_info, locking, and load all their data */
+    if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_READ, SR_MI_DATA_CACHE | SR_MI_PERM_READ,
+            session->sid, NULL, timeout_ms, opts))) {
+        goto cleanup;
+    }
+
+    /* pin the data, they must stay valid after unlocking */
+    if (mod_info.data_cached) {
+        if (mod_info.data) {
+            data = lyd_dup_withsiblings(mod_info.data, LYD_DUP_OPT_RECURSIVE | LYD_DUP_OPT_WITH_WHEN);
+            SR_CHECK_LY_GOTO(!data, session->conn->ly_ctx, err_info, cleanup);
+        }
+    } else {
+        data = mod_info.data;
+        mod_info.data = NULL;
+    }
+
+    /* success, the snapshot is started */
+    session->snapshot.active = 1;
+    session->snapshot.ds = session->ds;
+    session->snapshot.opts = opts;
+    session->snapshot.mod_set = mod_set;
+    memset(&mod_set, 0, sizeof mod_set);
+    session->snapshot.data = data;
+
+cleanup:
+    /* MODULES UNLOCK */
+    sr_shmmod_modinfo_unlock(&mod_info, session->sid);
+
+    ly_set_clean(&mod_set);
+    sr_modinfo_free(&mod_info);
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_session_snapshot_end(sr_session_ctx_t *session)
+{
+    sr_error_info_t *err_info = NULL;
+
+    SR_CHECK_ARG_APIRET(!session || !session->snapshot.active, session, err_info);
+
+    lyd_free_withsiblings(session->snapshot.data);
+    ly_set_clean(&session->snapshot.mod_set);
+    memset(&session->snapshot, 0, sizeof session->snapshot);
+
+    return sr_api_ret(session, NULL);
+}
+
+API void
+sr_free_val(sr_val_t *value)
+{
+    if (!value) {
+        return;
+    }
+
+    sr_free_val_content(value);
     free(value);
 }
 
@@ -1662,22 +2362,7 @@ sr_free_values(sr_val_t *values, size_t count)
     }
 
     for (i = 0; i < count; ++i) {
-        free(values[i].xpath);
-        switch (values[i].type) {
-        case SR_BINARY_T:
-        case SR_BITS_T:
-        case SR_ENUM_T:
-        case SR_IDENTITYREF_T:
-        case SR_INSTANCEID_T:
-        case SR_STRING_T:
-        case SR_ANYXML_T:
-        case SR_ANYDATA_T:
-            free(values[i].data.string_val);
-            break;
-        default:
-            /* nothing to free */
-            break;
-        }
+        sr_free_val_content(&values[i]);
     }
 
     free(values);
@@ -1710,8 +2395,61 @@ sr_set_item_str(sr_session_ctx_t *session, const char *path, const char *value,
     /* we do not need any lock, ext SHM is not accessed */
 
     /* add the operation into edit */
-    err_info = sr_edit_add(session, path, value, opts & SR_EDIT_STRICT ? "create" : "merge",
-            opts & SR_EDIT_NON_RECURSIVE ? "none" : "merge", NULL, NULL, NULL, origin, opts & SR_EDIT_ISOLATE);
+    err_info = sr_edit_add(session, NULL, path, value, opts & SR_EDIT_STRICT ? "create" : "merge",
+            opts & SR_EDIT_NON_RECURSIVE ? "none" : "merge", NULL, NULL, NULL, origin, opts & SR_EDIT_ISOLATE, NULL);
+
+    return sr_api_ret(session, err_info);
+}
+
+API int
+sr_set_items(sr_session_ctx_t *session, const sr_edit_item_t *items, size_t item_count)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *prev_node = NULL, *parent;
+    const char *prev_xpath = NULL, *xpath;
+    size_t i, len;
+    uint32_t depth, prev_depth;
+
+    SR_CHECK_ARG_APIRET(!session || (!items && item_count), session, err_info);
+
+    for (i = 0; i < item_count; ++i) {
+        if (!items[i].xpath) {
+            sr_errinfo_new(&err_info, SR_ERR_INVAL_ARG, NULL, "Item %zu without an xpath.", i);
+            break;
+        }
+
+        parent = NULL;
+        xpath = items[i].xpath;
+        if (prev_node && !(items[i].opts & SR_EDIT_ISOLATE)) {
+            /* find the node shared with the previous item */
+            depth = sr_xpath_common_parent(prev_xpath, items[i].xpath, &len, &prev_depth);
+            if (depth) {
+                /* create the node relative to it */
+                for (parent = prev_node; parent && (prev_depth > depth); --prev_depth) {
+                    parent = parent->parent;
+                }
+                if (parent) {
+                    xpath = items[i].xpath + len + 1;
+                }
+            }
+        }
+
+        /* add the operation into edit */
+        err_info = sr_edit_add(session, parent, xpath, items[i].value, items[i].opts & SR_EDIT_STRICT ? "create" : "merge",
+                items[i].opts & SR_EDIT_NON_RECURSIVE ? "none" : "merge", NULL, NULL, NULL, items[i].origin,
+                items[i].opts & SR_EDIT_ISOLATE, &prev_node);
+        if (err_info) {
+            break;
+        }
+
+        if (items[i].opts & SR_EDIT_ISOLATE) {
+            /* the following items cannot be added into the isolated edit subtree */
+            prev_node = NULL;
+            prev_xpath = NULL;
+        } else {
+            prev_xpath = items[i].xpath;
+        }
+    }
 
     return sr_api_ret(session, err_info);
 }
@@ -1741,8 +2479,8 @@ sr_delete_item(sr_session_ctx_t *session, const char *path, const sr_edit_option
     ly_log_options(ly_log_opts);
 
     /* add the operation into edit */
-    err_info = sr_edit_add(session, path, NULL, operation, opts & SR_EDIT_STRICT ? "none" : "ether", NULL, NULL, NULL,
-            NULL, opts & SR_EDIT_ISOLATE);
+    err_info = sr_edit_add(session, NULL, path, NULL, operation, opts & SR_EDIT_STRICT ? "none" : "ether", NULL, NULL,
+            NULL, NULL, opts & SR_EDIT_ISOLATE, NULL);
 
     return sr_api_ret(session, err_info);
 }
@@ -1756,8 +2494,9 @@ sr_move_item(sr_session_ctx_t *session, const char *path, const sr_move_position
     SR_CHECK_ARG_APIRET(!session || !path, session, err_info);
 
     /* add the operation into edit */
-    err_info = sr_edit_add(session, path, NULL, opts & SR_EDIT_STRICT ? "create" : "merge",
-            opts & SR_EDIT_NON_RECURSIVE ? "none" : "merge", &position, list_keys, leaflist_value, origin, opts & SR_EDIT_ISOLATE);
+    err_info = sr_edit_add(session, NULL, path, NULL, opts & SR_EDIT_STRICT ? "create" : "merge",
+            opts & SR_EDIT_NON_RECURSIVE ? "none" : "merge", &position, list_keys, leaflist_value, origin,
+            opts & SR_EDIT_ISOLATE, NULL);
 
     return sr_api_ret(session, err_info);
 }
@@ -2334,6 +3073,243 @@ cleanup:
     return sr_api_ret(session, err_info);
 }
 
+/**
+ * @brief Copy stored running data files of all or some modules directly into startup, if possible.
+ * The data can be copied only if there are no startup change subscribers (that need a diff) and
+ * the module data do not need to be validated with other modules.
+ *
+ * @param[in] session Session to use.
+ * @param[in] ly_mod Optional specific module.
+ * @param[out] done Whether the data were copied.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_copy_config_files(sr_session_ctx_t *session, const struct lys_module *ly_mod, int *done)
+{
+    sr_error_info_t *err_info = NULL;
+    struct sr_mod_info_s mod_info;
+    struct sr_mod_info_mod_s *mod;
+    struct ly_set mod_set = {0};
+    char **tmp_paths = NULL;
+    uint32_t i;
+    int changesub_lock = 0;
+
+    *done = 0;
+
+    if (session->conn->diff_check_cb) {
+        /* the diff is needed */
+        return NULL;
+    }
+
+    SR_MODINFO_INIT(mod_info, session->conn, SR_DS_STARTUP, SR_DS_RUNNING);
+
+    /* single module/all modules */
+    if (ly_mod) {
+        ly_set_add(&mod_set, (void *)ly_mod, 0);
+    }
+
+    /* add modules into mod_info without data, startup is write-locked and running read-locked */
+    if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_WRITE, SR_MI_DATA_NO | SR_MI_PERM_NO,
+            session->sid, NULL, 0, 0))) {
+        goto cleanup;
+    }
+
+    for (i = 0; i < mod_info.mod_count; ++i) {
+        mod = &mod_info.mods[i];
+        if (ly_mod && (mod->shm_mod->dep_count || mod->shm_mod->inv_dep_count)) {
+            /* data must be validated together with other modules */
+            goto cleanup;
+        }
+
+        /* all the modules are changed */
+        mod->state |= MOD_INFO_CHANGED;
+    }
+
+    /* check write perm */
+    if ((err_info = sr_modinfo_perm_check(&mod_info, 1, 1))) {
+        goto cleanup;
+    }
+
+    /* CHANGE SUB READ LOCK */
+    if ((err_info = sr_modinfo_changesub_rdlock(&mod_info))) {
+        goto cleanup;
+    }
+    changesub_lock = 1;
+
+    for (i = 0; i < mod_info.mod_count; ++i) {
+        if (mod_info.mods[i].shm_mod->change_sub[SR_DS_STARTUP].sub_count) {
+            /* subscribers need a diff */
+            goto cleanup;
+        }
+    }
+
+    /* copy all the data files and replace the startup files at once */
+    tmp_paths = calloc(mod_info.mod_count, sizeof *tmp_paths);
+    SR_CHECK_MEM_GOTO(!tmp_paths, err_info, cleanup);
+    for (i = 0; i < mod_info.mod_count; ++i) {
+        if ((err_info = sr_module_file_startup_prepare_copy(mod_info.mods[i].ly_mod->name, SR_DS_RUNNING, &tmp_paths[i]))) {
+            goto cleanup;
+        }
+    }
+    if ((err_info = sr_module_file_startup_commit(tmp_paths, mod_info.mod_count))) {
+        goto cleanup;
+    }
+
+    /* success */
+    *done = 1;
+
+cleanup:
+    if (changesub_lock) {
+        /* CHANGE SUB READ UNLOCK */
+        sr_modinfo_changesub_rdunlock(&mod_info);
+    }
+
+    /* MODULES UNLOCK */
+    sr_shmmod_modinfo_unlock(&mod_info, session->sid);
+
+    if (tmp_paths) {
+        sr_module_file_startup_discard(tmp_paths, mod_info.mod_count);
+        free(tmp_paths);
+    }
+    ly_set_clean(&mod_set);
+    sr_modinfo_free(&mod_info);
+    return err_info;
+}
+
+/**
+ * @brief Apply stored candidate diffs of all or some modules directly on running, if possible.
+ * The diffs can be used only if they are relative to the current running data.
+ *
+ * @param[in] session Session to use.
+ * @param[in] ly_mod Optional specific module.
+ * @param[in] timeout_ms Change callback timeout in milliseconds.
+ * @param[out] done Whether the diffs were applied.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_copy_config_candidate_diff(sr_session_ctx_t *session, const struct lys_module *ly_mod, uint32_t timeout_ms, int *done)
+{
+    sr_error_info_t *err_info = NULL, *cb_err_info = NULL;
+    struct sr_mod_info_s cand_info, mod_info;
+    struct sr_mod_info_mod_s *mod;
+    struct ly_set mod_set = {0};
+    struct lyd_node *cand_diff = NULL, *mod_diff;
+    uint32_t i, j, *run_vers = NULL;
+    int exists;
+
+    *done = 0;
+
+    SR_MODINFO_INIT(cand_info, session->conn, SR_DS_CANDIDATE, SR_DS_CANDIDATE);
+    SR_MODINFO_INIT(mod_info, session->conn, SR_DS_RUNNING, SR_DS_RUNNING);
+
+    /* single module/all modules */
+    if (ly_mod) {
+        ly_set_add(&mod_set, (void *)ly_mod, 0);
+    }
+
+    /* add modules into mod_info without data */
+    if ((err_info = sr_modinfo_add_modules(&cand_info, &mod_set, 0, SR_LOCK_READ, SR_MI_DATA_NO | SR_MI_PERM_NO,
+            session->sid, NULL, 0, 0))) {
+        goto cleanup;
+    }
+
+    /* load all the candidate diffs with the running data versions they are relative to */
+    run_vers = calloc(cand_info.mod_count, sizeof *run_vers);
+    SR_CHECK_MEM_GOTO(!run_vers, err_info, cleanup);
+    for (i = 0; i < cand_info.mod_count; ++i) {
+        mod = &cand_info.mods[i];
+
+        mod_diff = NULL;
+        if ((err_info = sr_module_file_candidate_diff_load(mod->ly_mod, &mod_diff, &exists))) {
+            goto cleanup;
+        }
+        if (!exists) {
+            /* candidate is the same as running */
+            continue;
+        }
+
+        if (mod->shm_mod->cand_run_ver != mod->shm_mod->ver) {
+            /* the diff is outdated */
+            lyd_free_withsiblings(mod_diff);
+            goto cleanup;
+        }
+        run_vers[i] = mod->shm_mod->ver;
+
+        if (cand_diff && mod_diff) {
+            sr_ly_link(cand_diff, mod_diff);
+        } else if (mod_diff) {
+            cand_diff = mod_diff;
+        }
+    }
+
+    /* MODULES UNLOCK */
+    sr_shmmod_modinfo_unlock(&cand_info, session->sid);
+
+    /* add running modules into mod_info */
+    if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, MOD_INFO_DEP | MOD_INFO_INV_DEP, SR_LOCK_READ,
+            SR_MI_LOCK_UPGRADEABLE | SR_MI_PERM_NO, session->sid, NULL, 0, 0))) {
+        goto cleanup;
+    }
+
+    /* check that running data have not changed meanwhile */
+    for (i = 0; i < cand_info.mod_count; ++i) {
+        if (!run_vers[i]) {
+            continue;
+        }
+        for (j = 0; j < mod_info.mod_count; ++j) {
+            if (mod_info.mods[j].ly_mod == cand_info.mods[i].ly_mod) {
+                break;
+            }
+        }
+        assert(j < mod_info.mod_count);
+        if (mod_info.mods[j].shm_mod->ver != run_vers[i]) {
+            goto cleanup;
+        }
+    }
+
+    /* the candidate diffs are exactly the changes to perform, apply them */
+    assert(!mod_info.data_cached);
+    for (i = 0; i < mod_info.mod_count; ++i) {
+        mod = &mod_info.mods[i];
+        if (!(mod->state & MOD_INFO_REQ) || !(mod_diff = sr_module_data_unlink(&cand_diff, mod->ly_mod))) {
+            continue;
+        }
+
+        /* use the diff as the diff of the changes */
+        mod->state |= MOD_INFO_CHANGED;
+        if (mod_info.diff) {
+            sr_ly_link(mod_info.diff, mod_diff);
+        } else {
+            mod_info.diff = mod_diff;
+        }
+
+        if ((err_info = sr_diff_mod_apply(mod_diff, mod->ly_mod, 0, &mod_info.data))) {
+            goto cleanup;
+        }
+    }
+    *done = 1;
+
+    /* notify all the subscribers and store the changes */
+    err_info = sr_changes_notify_store(&mod_info, session, timeout_ms, &cb_err_info);
+
+cleanup:
+    /* MODULES UNLOCK */
+    sr_shmmod_modinfo_unlock(&mod_info, session->sid);
+    sr_shmmod_modinfo_unlock(&cand_info, session->sid);
+
+    free(run_vers);
+    lyd_free_withsiblings(cand_diff);
+    ly_set_clean(&mod_set);
+    sr_modinfo_free(&mod_info);
+    sr_modinfo_free(&cand_info);
+    if (cb_err_info) {
+        /* return callback error if some was generated */
+        sr_errinfo_merge(&err_info, cb_err_info);
+        err_info->err_code = SR_ERR_CALLBACK_FAILED;
+    }
+    return err_info;
+}
+
 API int
 sr_copy_config(sr_session_ctx_t *session, const char *module_name, sr_datastore_t src_datastore, uint32_t timeout_ms,
         int wait)
@@ -2342,6 +3318,7 @@ sr_copy_config(sr_session_ctx_t *session, const char *module_name, sr_datastore_
     struct sr_mod_info_s mod_info;
     struct ly_set mod_set = {0};
     const struct lys_module *ly_mod = NULL;
+    int done;
 
     SR_CHECK_ARG_APIRET(!session || !SR_IS_CONVENTIONAL_DS(src_datastore) || !SR_IS_CONVENTIONAL_DS(session->ds),
             session, err_info);
@@ -2366,19 +3343,34 @@ sr_copy_config(sr_session_ctx_t *session, const char *module_name, sr_datastore_
         }
     }
 
+    if ((src_datastore == SR_DS_RUNNING) && (session->ds == SR_DS_STARTUP)) {
+        /* try to copy the stored data directly */
+        if ((err_info = sr_copy_config_files(session, ly_mod, &done)) || done) {
+            goto cleanup;
+        }
+    }
+
+    done = 0;
+    if ((src_datastore == SR_DS_CANDIDATE) && (session->ds == SR_DS_RUNNING)) {
+        /* try to apply the stored candidate diffs directly */
+        if ((err_info = sr_copy_config_candidate_diff(session, ly_mod, timeout_ms, &done))) {
+            goto cleanup;
+        }
+    }
+
     /* collect all required modules */
     if (ly_mod) {
         ly_set_add(&mod_set, (void *)ly_mod, 0);
     }
 
-    if ((src_datastore == SR_DS_RUNNING) && (session->ds == SR_DS_CANDIDATE)) {
+    if (((src_datastore == SR_DS_RUNNING) && (session->ds == SR_DS_CANDIDATE)) || done) {
         /* add modules into mod_info without data */
         if ((err_info = sr_modinfo_add_modules(&mod_info, &mod_set, 0, SR_LOCK_WRITE, SR_MI_DATA_NO | SR_MI_PERM_NO,
                 session->sid, NULL, 0, 0))) {
             goto cleanup;
         }
 
-        /* special case, just reset candidate */
+        /* special case or candidate already applied in running, just reset candidate */
         err_info = sr_modinfo_candidate_reset(&mod_info);
         goto cleanup;
     }
@@ -3140,6 +4132,34 @@ cleanup:
     return sr_api_ret(session, err_info);
 }
 
+/**
+ * @brief Find an annotation definition of a module.
+ *
+ * @param[in] ly_ctx libyang context.
+ * @param[in] mod_name Name of the module with the annotation.
+ * @param[in] name Annotation name.
+ * @return Annotation definition, NULL if not found.
+ */
+static const struct lys_ext_instance_complex *
+sr_ly_annotation_find(const struct ly_ctx *ly_ctx, const char *mod_name, const char *name)
+{
+    const struct lys_module *ly_mod;
+    uint8_t i;
+
+    ly_mod = ly_ctx_get_module(ly_ctx, mod_name, NULL, 0);
+    if (!ly_mod) {
+        return NULL;
+    }
+
+    for (i = 0; i < ly_mod->ext_size; ++i) {
+        if (!strcmp(ly_mod->ext[i]->def->name, "annotation") && !strcmp(ly_mod->ext[i]->arg_value, name)) {
+            return (const struct lys_ext_instance_complex *)ly_mod->ext[i];
+        }
+    }
+
+    return NULL;
+}
+
 static int
 _sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, int dup, sr_change_iter_t **iter)
 {
@@ -3170,6 +4190,12 @@ _sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, int dup, sr_c
     SR_CHECK_MEM_GOTO(!(*iter)->set, err_info, error);
     (*iter)->idx = 0;
 
+    /* resolve the diff annotations so that they can be found by a pointer comparison */
+    (*iter)->orig_value_annot = sr_ly_annotation_find(session->conn->ly_ctx, SR_YANG_MOD, "orig-value");
+    (*iter)->orig_dflt_annot = sr_ly_annotation_find(session->conn->ly_ctx, SR_YANG_MOD, "orig-dflt");
+    (*iter)->key_annot = sr_ly_annotation_find(session->conn->ly_ctx, "yang", "key");
+    (*iter)->value_annot = sr_ly_annotation_find(session->conn->ly_ctx, "yang", "value");
+
     return sr_api_ret(session, NULL);
 
 error:
@@ -3183,10 +4209,146 @@ sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter
     return _sr_get_changes_iter(session, xpath, 0, iter);
 }
 
-API int
-sr_dup_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter_t **iter)
-{
-    return _sr_get_changes_iter(session, xpath, 1, iter);
+API int
+sr_dup_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter_t **iter)
+{
+    return _sr_get_changes_iter(session, xpath, 1, iter);
+}
+
+/**
+ * @brief Set type and value of a sysrepo value from a libyang leaf or leaf-list node.
+ *
+ * @param[in] node libyang leaf or leaf-list node.
+ * @param[in] value_str Optional value to override.
+ * @param[in] dup Whether to duplicate string values or only reference the libyang strings.
+ * @param[in,out] sr_val sysrepo value to fill.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_val_leaf_set(const struct lyd_node *node, const char *value_str, int dup, sr_val_t *sr_val)
+{
+    sr_error_info_t *err_info = NULL;
+    char *ptr, **str_p = NULL;
+    LY_DATA_TYPE value_type;
+    const struct lyd_node_leaf_list *leaf;
+    struct lys_type *type;
+
+    /* find the actual leaf */
+    leaf = (const struct lyd_node_leaf_list *)node;
+    while (leaf->value_type == LY_TYPE_LEAFREF) {
+        leaf = (const struct lyd_node_leaf_list *)leaf->value.leafref;
+    }
+
+    if (value_str) {
+        /* learn value_str value_type */
+        SR_CHECK_INT_RET(lyd_value_type(node->schema, value_str, &type), err_info);
+        value_type = type->base;
+    } else {
+        /* use attributes from the leaf */
+        value_str = leaf->value_str;
+        value_type = leaf->value_type;
+    }
+
+    switch (value_type) {
+    case LY_TYPE_BINARY:
+        sr_val->type = SR_BINARY_T;
+        str_p = &sr_val->data.binary_val;
+        break;
+    case LY_TYPE_BITS:
+        sr_val->type = SR_BITS_T;
+        str_p = &sr_val->data.bits_val;
+        break;
+    case LY_TYPE_BOOL:
+        sr_val->type = SR_BOOL_T;
+        if (!strcmp(value_str, "true")) {
+            sr_val->data.bool_val = true;
+        } else {
+            sr_val->data.bool_val = false;
+        }
+        break;
+    case LY_TYPE_DEC64:
+        sr_val->type = SR_DECIMAL64_T;
+        sr_val->data.decimal64_val = strtod(value_str, &ptr);
+        if (ptr[0]) {
+            sr_errinfo_new(&err_info, SR_ERR_INTERNAL, NULL, "Conversion of \"%s\" to double failed (%s).",
+                    value_str, strerror(errno));
+            return err_info;
+        }
+        break;
+    case LY_TYPE_EMPTY:
+        sr_val->type = SR_LEAF_EMPTY_T;
+        break;
+    case LY_TYPE_ENUM:
+        sr_val->type = SR_ENUM_T;
+        str_p = &sr_val->data.enum_val;
+        break;
+    case LY_TYPE_IDENT:
+        sr_val->type = SR_IDENTITYREF_T;
+        str_p = &sr_val->data.identityref_val;
+        break;
+    case LY_TYPE_INST:
+        sr_val->type = SR_INSTANCEID_T;
+        str_p = &sr_val->data.instanceid_val;
+        break;
+    case LY_TYPE_STRING:
+        sr_val->type = SR_STRING_T;
+        str_p = &sr_val->data.string_val;
+        break;
+    case LY_TYPE_INT8:
+        sr_val->type = SR_INT8_T;
+        sr_val->data.int8_val = strtoll(value_str, &ptr, 10);
+        SR_CHECK_INT_RET(ptr[0], err_info);
+        break;
+    case LY_TYPE_INT16:
+        sr_val->type = SR_INT16_T;
+        sr_val->data.int16_val = strtoll(value_str, &ptr, 10);
+        SR_CHECK_INT_RET(ptr[0], err_info);
+        break;
+    case LY_TYPE_INT32:
+        sr_val->type = SR_INT32_T;
+        sr_val->data.int32_val = strtoll(value_str, &ptr, 10);
+        SR_CHECK_INT_RET(ptr[0], err_info);
+        break;
+    case LY_TYPE_INT64:
+        sr_val->type = SR_INT64_T;
+        sr_val->data.int64_val = strtoll(value_str, &ptr, 10);
+        SR_CHECK_INT_RET(ptr[0], err_info);
+        break;
+    case LY_TYPE_UINT8:
+        sr_val->type = SR_UINT8_T;
+        sr_val->data.uint8_val = strtoull(value_str, &ptr, 10);
+        SR_CHECK_INT_RET(ptr[0], err_info);
+        break;
+    case LY_TYPE_UINT16:
+        sr_val->type = SR_UINT16_T;
+        sr_val->data.uint16_val = strtoull(value_str, &ptr, 10);
+        SR_CHECK_INT_RET(ptr[0], err_info);
+        break;
+    case LY_TYPE_UINT32:
+        sr_val->type = SR_UINT32_T;
+        sr_val->data.uint32_val = strtoull(value_str, &ptr, 10);
+        SR_CHECK_INT_RET(ptr[0], err_info);
+        break;
+    case LY_TYPE_UINT64:
+        sr_val->type = SR_UINT64_T;
+        sr_val->data.uint64_val = strtoull(value_str, &ptr, 10);
+        SR_CHECK_INT_RET(ptr[0], err_info);
+        break;
+    default:
+        SR_ERRINFO_INT(&err_info);
+        return err_info;
+    }
+
+    if (str_p) {
+        if (dup) {
+            *str_p = strdup(value_str);
+            SR_CHECK_MEM_RET(!*str_p, err_info);
+        } else {
+            *str_p = (char *)value_str;
+        }
+    }
+
+    return NULL;
 }
 
 /**
@@ -3205,10 +4367,7 @@ sr_lyd_node2sr_val(const struct lyd_node *node, const char *value_str, const cha
     sr_error_info_t *err_info = NULL;
     uint32_t start, end;
     sr_val_t *sr_val;
-    LY_DATA_TYPE value_type;
-    const struct lyd_node_leaf_list *leaf;
     struct lyd_node_anydata *any;
-    struct lys_type *type;
     struct lys_node_list *slist;
     struct lyd_node *tree;
 
@@ -3324,109 +4483,7 @@ sr_lyd_node2sr_val(const struct lyd_node *node, const char *value_str, const cha
 
     /* fallthrough */
     case LYS_LEAF:
-        /* find the actual leaf */
-        leaf = (const struct lyd_node_leaf_list *)node;
-        while (leaf->value_type == LY_TYPE_LEAFREF) {
-            leaf = (const struct lyd_node_leaf_list *)leaf->value.leafref;
-        }
-
-        if (value_str) {
-            /* learn value_str value_type */
-            SR_CHECK_INT_GOTO(lyd_value_type(node->schema, value_str, &type), err_info, error);
-            value_type = type->base;
-        } else {
-            /* use attributes from the leaf */
-            value_str = leaf->value_str;
-            value_type = leaf->value_type;
-        }
-
-        switch (value_type) {
-        case LY_TYPE_BINARY:
-            sr_val->type = SR_BINARY_T;
-            sr_val->data.binary_val = strdup(value_str);
-            break;
-        case LY_TYPE_BITS:
-            sr_val->type = SR_BITS_T;
-            sr_val->data.bits_val = strdup(value_str);
-            break;
-        case LY_TYPE_BOOL:
-            sr_val->type = SR_BOOL_T;
-            if (!strcmp(value_str, "true")) {
-                sr_val->data.bool_val = true;
-            } else {
-                sr_val->data.bool_val = false;
-            }
-            break;
-        case LY_TYPE_DEC64:
-            sr_val->type = SR_DECIMAL64_T;
-            sr_val->data.decimal64_val = strtod(value_str, &ptr);
-            if (ptr[0]) {
-                sr_errinfo_new(&err_info, SR_ERR_INTERNAL, NULL, "Conversion of \"%s\" to double failed (%s).",
-                        value_str, strerror(errno));
-                goto error;
-            }
-            break;
-        case LY_TYPE_EMPTY:
-            sr_val->type = SR_LEAF_EMPTY_T;
-            break;
-        case LY_TYPE_ENUM:
-            sr_val->type = SR_ENUM_T;
-            sr_val->data.enum_val = strdup(value_str);
-            break;
-        case LY_TYPE_IDENT:
-            sr_val->type = SR_IDENTITYREF_T;
-            sr_val->data.identityref_val = strdup(value_str);
-            break;
-        case LY_TYPE_INST:
-            sr_val->type = SR_INSTANCEID_T;
-            sr_val->data.instanceid_val = strdup(value_str);
-            break;
-        case LY_TYPE_STRING:
-            sr_val->type = SR_STRING_T;
-            sr_val->data.string_val = strdup(value_str);
-            break;
-        case LY_TYPE_INT8:
-            sr_val->type = SR_INT8_T;
-            sr_val->data.int8_val = strtoll(value_str, &ptr, 10);
-            SR_CHECK_INT_GOTO(ptr[0], err_info, error);
-            break;
-        case LY_TYPE_INT16:
-            sr_val->type = SR_INT16_T;
-            sr_val->data.int16_val = strtoll(value_str, &ptr, 10);
-            SR_CHECK_INT_GOTO(ptr[0], err_info, error);
-            break;
-        case LY_TYPE_INT32:
-            sr_val->type = SR_INT32_T;
-            sr_val->data.int32_val = strtoll(value_str, &ptr, 10);
-            SR_CHECK_INT_GOTO(ptr[0], err_info, error);
-            break;
-        case LY_TYPE_INT64:
-            sr_val->type = SR_INT64_T;
-            sr_val->data.int64_val = strtoll(value_str, &ptr, 10);
-            SR_CHECK_INT_GOTO(ptr[0], err_info, error);
-            break;
-        case LY_TYPE_UINT8:
-            sr_val->type = SR_UINT8_T;
-            sr_val->data.uint8_val = strtoull(value_str, &ptr, 10);
-            SR_CHECK_INT_GOTO(ptr[0], err_info, error);
-            break;
-        case LY_TYPE_UINT16:
-            sr_val->type = SR_UINT16_T;
-            sr_val->data.uint16_val = strtoull(value_str, &ptr, 10);
-            SR_CHECK_INT_GOTO(ptr[0], err_info, error);
-            break;
-        case LY_TYPE_UINT32:
-            sr_val->type = SR_UINT32_T;
-            sr_val->data.uint32_val = strtoull(value_str, &ptr, 10);
-            SR_CHECK_INT_GOTO(ptr[0], err_info, error);
-            break;
-        case LY_TYPE_UINT64:
-            sr_val->type = SR_UINT64_T;
-            sr_val->data.uint64_val = strtoull(value_str, &ptr, 10);
-            SR_CHECK_INT_GOTO(ptr[0], err_info, error);
-            break;
-        default:
-            SR_ERRINFO_INT(&err_info);
+        if ((err_info = sr_val_leaf_set(node, value_str, 1, sr_val))) {
             goto error;
         }
         break;
@@ -3447,14 +4504,34 @@ error:
     return err_info;
 }
 
+/**
+ * @brief Get the value of a diff node attribute.
+ *
+ * @param[in] node Diff node.
+ * @param[in] annot Resolved annotation of the attribute.
+ * @return Attribute value, NULL if the node does not have the attribute.
+ */
+static const char *
+sr_change_attr_value(const struct lyd_node *node, const struct lys_ext_instance_complex *annot)
+{
+    const struct lyd_attr *attr;
+
+    for (attr = node->attr; attr; attr = attr->next) {
+        if (attr->annotation == annot) {
+            return attr->value_str;
+        }
+    }
+
+    return NULL;
+}
+
 API int
 sr_get_change_next(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_change_oper_t *operation,
         sr_val_t **old_value, sr_val_t **new_value)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_attr *attr, *attr2;
     struct lyd_node *node;
-    const char *attr_name;
+    const char *attr_value;
     sr_change_oper_t op;
 
     SR_CHECK_ARG_APIRET(!session || !iter || !operation || !old_value || !new_value, session, err_info);
@@ -3479,23 +4556,18 @@ sr_get_change_next(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_change_
         break;
     case SR_OP_MODIFIED:
         /* "orig-value" attribute contains the previous value */
-        for (attr = node->attr;
-                attr && (strcmp(attr->annotation->module->name, SR_YANG_MOD) || strcmp(attr->name, "orig-value"));
-                attr = attr->next) {}
-        if (!attr) {
+        attr_value = sr_change_attr_value(node, iter->orig_value_annot);
+        if (!attr_value) {
             SR_ERRINFO_INT(&err_info);
             return sr_api_ret(session, err_info);
         }
 
-        /* "orig-dflt" is present only if the previous value was default */
-        for (attr2 = node->attr;
-                attr2 && (strcmp(attr2->annotation->module->name, SR_YANG_MOD) || strcmp(attr2->name, "orig-dflt"));
-                attr2 = attr2->next) {}
-
-        if ((err_info = sr_lyd_node2sr_val(node, attr->value_str, NULL, old_value))) {
+        if ((err_info = sr_lyd_node2sr_val(node, attr_value, NULL, old_value))) {
             return sr_api_ret(session, err_info);
         }
-        if (attr2) {
+
+        /* "orig-dflt" is present only if the previous value was default */
+        if (sr_change_attr_value(node, iter->orig_dflt_annot)) {
             (*old_value)->dflt = 1;
         } else {
             (*old_value)->dflt = 0;
@@ -3515,26 +4587,23 @@ sr_get_change_next(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_change_
         }
     /* fallthrough */
     case SR_OP_MOVED:
+        /* attribute contains the value of the node before in the order */
         if (node->schema->nodetype == LYS_LEAFLIST) {
-            attr_name = "value";
+            attr_value = sr_change_attr_value(node, iter->value_annot);
         } else {
             assert(node->schema->nodetype == LYS_LIST);
-            attr_name = "key";
+            attr_value = sr_change_attr_value(node, iter->key_annot);
         }
-        /* attribute contains the value of the node before in the order */
-        for (attr = node->attr;
-                attr && (strcmp(attr->annotation->module->name, "yang") || strcmp(attr->name, attr_name));
-                attr = attr->next) {}
-        if (!attr) {
+        if (!attr_value) {
             SR_ERRINFO_INT(&err_info);
             return sr_api_ret(session, err_info);
         }
 
-        if (attr->value_str[0]) {
+        if (attr_value[0]) {
             if (node->schema->nodetype == LYS_LEAFLIST) {
-                err_info = sr_lyd_node2sr_val(node, attr->value_str, NULL, old_value);
+                err_info = sr_lyd_node2sr_val(node, attr_value, NULL, old_value);
             } else {
-                err_info = sr_lyd_node2sr_val(node, NULL, attr->value_str, old_value);
+                err_info = sr_lyd_node2sr_val(node, NULL, attr_value, old_value);
             }
             if (err_info) {
                 return sr_api_ret(session, err_info);
@@ -3558,8 +4627,6 @@ sr_get_change_tree_next(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_ch
         const struct lyd_node **node, const char **prev_value, const char **prev_list, bool *prev_dflt)
 {
     sr_error_info_t *err_info = NULL;
-    struct lyd_attr *attr, *attr2;
-    const char *attr_name;
 
     SR_CHECK_ARG_APIRET(!session || !iter || !operation || !node || !prev_value || !prev_list || !prev_dflt, session, err_info);
 
@@ -3584,20 +4651,14 @@ sr_get_change_tree_next(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_ch
         break;
     case SR_OP_MODIFIED:
         /* "orig-value" attribute contains the previous value */
-        for (attr = (*node)->attr;
-                attr && (strcmp(attr->annotation->module->name, SR_YANG_MOD) || strcmp(attr->name, "orig-value"));
-                attr = attr->next) {}
-        if (!attr) {
+        *prev_value = sr_change_attr_value(*node, iter->orig_value_annot);
+        if (!*prev_value) {
             SR_ERRINFO_INT(&err_info);
             return sr_api_ret(session, err_info);
         }
-        *prev_value = attr->value_str;
 
         /* "orig-dflt" is present only if the previous value was default */
-        for (attr2 = (*node)->attr;
-                attr2 && (strcmp(attr2->annotation->module->name, SR_YANG_MOD) || strcmp(attr2->name, "orig-dflt"));
-                attr2 = attr2->next) {}
-        if (attr2) {
+        if (sr_change_attr_value(*node, iter->orig_dflt_annot)) {
             *prev_dflt = 1;
         }
         break;
@@ -3608,30 +4669,393 @@ sr_get_change_tree_next(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_ch
         }
     /* fallthrough */
     case SR_OP_MOVED:
+        /* attribute contains the value (predicates) of the preceding instance in the order */
         if ((*node)->schema->nodetype == LYS_LEAFLIST) {
-            attr_name = "value";
+            *prev_value = sr_change_attr_value(*node, iter->value_annot);
+            if (!*prev_value) {
+                SR_ERRINFO_INT(&err_info);
+                return sr_api_ret(session, err_info);
+            }
         } else {
             assert((*node)->schema->nodetype == LYS_LIST);
-            attr_name = "key";
+            *prev_list = sr_change_attr_value(*node, iter->key_annot);
+            if (!*prev_list) {
+                SR_ERRINFO_INT(&err_info);
+                return sr_api_ret(session, err_info);
+            }
         }
+        break;
+    }
 
-        /* attribute contains the value (predicates) of the preceding instance in the order */
-        for (attr = (*node)->attr;
-                attr && (strcmp(attr->annotation->module->name, "yang") || strcmp(attr->name, attr_name));
-                attr = attr->next) {}
-        if (!attr) {
+    return sr_api_ret(session, NULL);
+}
+
+/**
+ * @brief Make sure a change path buffer is large enough.
+ *
+ * @param[in,out] buf Buffer to enlarge.
+ * @param[in,out] buf_size Size of @p buf.
+ * @param[in] size Required size.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_change_buf_reserve(char **buf, size_t *buf_size, size_t size)
+{
+    sr_error_info_t *err_info = NULL;
+    size_t new_size;
+
+    if (*buf_size >= size) {
+        return NULL;
+    }
+
+    /* grow geometrically so that the buffer is enlarged only a few times for the whole changeset */
+    new_size = (*buf_size * 2 > size) ? *buf_size * 2 : size;
+    *buf = sr_realloc(*buf, new_size);
+    if (!*buf) {
+        *buf_size = 0;
+        SR_ERRINFO_MEM(&err_info);
+        return err_info;
+    }
+    *buf_size = new_size;
+
+    return NULL;
+}
+
+/**
+ * @brief Append a path segment of a diff node to a change path buffer, the same as generated by lyd_path()
+ * except that leaf-list segments have no predicate.
+ *
+ * @param[in] node Diff node.
+ * @param[in] keys_predicate Optional list keys predicate to use instead of the actual keys.
+ * @param[in,out] buf Path buffer, enlarged if needed.
+ * @param[in,out] buf_size Size of @p buf.
+ * @param[in,out] len Length of the path in @p buf, the segment is appended to it.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_change_path_append(const struct lyd_node *node, const char *keys_predicate, char **buf, size_t *buf_size, uint32_t *len)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lys_node_list *slist = NULL;
+    const struct lys_module *mod = NULL;
+    const struct lyd_node *key, *iter;
+    const char *val;
+    char quot, *ptr;
+    size_t size;
+    uint32_t pos = 0;
+    uint8_t i;
+
+    /* learn the segment size */
+    if (!node->parent || (lyd_node_module(node) != lyd_node_module(node->parent))) {
+        mod = lyd_node_module(node);
+    }
+    size = 1 + (mod ? strlen(mod->name) + 1 : 0) + strlen(node->schema->name);
+    if (keys_predicate) {
+        size += strlen(keys_predicate);
+    } else if (node->schema->nodetype == LYS_LIST) {
+        slist = (const struct lys_node_list *)node->schema;
+        if (slist->keys_size) {
+            for (i = 0; i < slist->keys_size; ++i) {
+                LY_TREE_FOR(node->child, key) {
+                    if (key->schema == (struct lys_node *)slist->keys[i]) {
+                        /* [name='value'] */
+                        size += 1 + strlen(slist->keys[i]->name) + 2 + strlen(((struct lyd_node_leaf_list *)key)->value_str) + 2;
+                        break;
+                    }
+                }
+            }
+        } else {
+            /* key-less list, use the instance position */
+            pos = 1;
+            for (iter = node; iter->prev->next; iter = iter->prev) {
+                if (iter->prev->schema == node->schema) {
+                    ++pos;
+                }
+            }
+            size += 2 + 10;
+        }
+    }
+
+    /* enlarge the buffer, keep space for the terminating zero */
+    if ((err_info = sr_change_buf_reserve(buf, buf_size, *len + size + 1))) {
+        return err_info;
+    }
+    ptr = *buf + *len;
+
+    /* print the segment */
+    *ptr++ = '/';
+    if (mod) {
+        ptr = stpcpy(ptr, mod->name);
+        *ptr++ = ':';
+    }
+    ptr = stpcpy(ptr, node->schema->name);
+    if (keys_predicate) {
+        ptr = stpcpy(ptr, keys_predicate);
+    } else if (slist && slist->keys_size) {
+        for (i = 0; i < slist->keys_size; ++i) {
+            LY_TREE_FOR(node->child, key) {
+                if (key->schema == (struct lys_node *)slist->keys[i]) {
+                    val = ((struct lyd_node_leaf_list *)key)->value_str;
+                    quot = strchr(val, '\'') ? '\"' : '\'';
+
+                    *ptr++ = '[';
+                    ptr = stpcpy(ptr, slist->keys[i]->name);
+                    *ptr++ = '=';
+                    *ptr++ = quot;
+                    ptr = stpcpy(ptr, val);
+                    *ptr++ = quot;
+                    *ptr++ = ']';
+                    break;
+                }
+            }
+        }
+    } else if (slist) {
+        ptr += sprintf(ptr, "[%" PRIu32 "]", pos);
+    }
+    *ptr = '\0';
+
+    *len = ptr - *buf;
+    return NULL;
+}
+
+/**
+ * @brief Build the path of a diff node in a change path buffer. The path segments of the previous node
+ * that are shared with this node are reused.
+ *
+ * @param[in] iter Change iterator.
+ * @param[in] node Diff node.
+ * @param[in,out] buf Path buffer, enlarged if needed.
+ * @param[in,out] buf_size Size of @p buf.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_change_path_build(sr_change_iter_t *iter, const struct lyd_node *node, char **buf, size_t *buf_size)
+{
+    sr_error_info_t *err_info = NULL;
+    const struct lyd_node *parent;
+    uint32_t depth, valid, len, i;
+    void *mem;
+
+    /* learn the node depth */
+    depth = 0;
+    for (parent = node->parent; parent; parent = parent->parent) {
+        ++depth;
+    }
+
+    if (iter->path_size < depth + 1) {
+        mem = realloc(iter->path, (depth + 1) * sizeof *iter->path);
+        SR_CHECK_MEM_RET(!mem, err_info);
+        iter->path = mem;
+        iter->path_size = depth + 1;
+    }
+
+    if (iter->path_buf != *buf) {
+        /* a different buffer, nothing can be reused */
+        iter->path_count = 0;
+    }
+
+    /* find the segments shared with the previous path, bottom-up */
+    valid = 0;
+    for (i = depth + 1, parent = node; i; --i, parent = parent->parent) {
+        if ((i - 1 < iter->path_count) && (iter->path[i - 1].node == parent)) {
+            /* this and all the preceding segments are already in the buffer */
+            valid = i;
+            break;
+        }
+        iter->path[i - 1].node = parent;
+    }
+
+    /* append the rest */
+    len = valid ? iter->path[valid - 1].len : 0;
+    for (i = valid; i < depth + 1; ++i) {
+        if ((err_info = sr_change_path_append(iter->path[i].node, NULL, buf, buf_size, &len))) {
+            iter->path_count = 0;
+            return err_info;
+        }
+        iter->path[i].len = len;
+    }
+    (*buf)[len] = '\0';
+
+    iter->path_count = depth + 1;
+    iter->path_buf = *buf;
+    return NULL;
+}
+
+/**
+ * @brief Fill a sysrepo value referencing the strings of a diff node.
+ *
+ * @param[in] iter Change iterator.
+ * @param[in] node Diff node.
+ * @param[in] value_str Optional value to override.
+ * @param[out] sr_val sysrepo value to fill, except its path.
+ * @return err_info, NULL on success.
+ */
+static sr_error_info_t *
+sr_change_val_fill(sr_change_iter_t *iter, const struct lyd_node *node, const char *value_str, sr_val_t *sr_val)
+{
+    sr_error_info_t *err_info = NULL;
+
+    switch (node->schema->nodetype) {
+    case LYS_LIST:
+        sr_val->type = SR_LIST_T;
+        break;
+    case LYS_CONTAINER:
+        if (((struct lys_node_container *)node->schema)->presence) {
+            sr_val->type = SR_CONTAINER_PRESENCE_T;
+        } else {
+            sr_val->type = SR_CONTAINER_T;
+        }
+        break;
+    case LYS_NOTIF:
+        sr_val->type = SR_NOTIFICATION_T;
+        break;
+    case LYS_ANYXML:
+    case LYS_ANYDATA:
+        /* the only case that needs an allocation, the value is printed once for the change */
+        if (!iter->any_str && (err_info = sr_val_ly2sr_any(node, &iter->any_str))) {
+            return err_info;
+        }
+        if (node->schema->nodetype == LYS_ANYXML) {
+            sr_val->type = SR_ANYXML_T;
+            sr_val->data.anyxml_val = iter->any_str;
+        } else {
+            sr_val->type = SR_ANYDATA_T;
+            sr_val->data.anydata_val = iter->any_str;
+        }
+        break;
+    case LYS_LEAF:
+    case LYS_LEAFLIST:
+        if ((err_info = sr_val_leaf_set(node, value_str, 0, sr_val))) {
+            return err_info;
+        }
+        break;
+    default:
+        SR_ERRINFO_INT(&err_info);
+        return err_info;
+    }
+
+    sr_val->dflt = node->dflt;
+    return NULL;
+}
+
+API int
+sr_get_change_next_buf(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_change_oper_t *operation,
+        sr_val_t *old_value, sr_val_t *new_value, char **buf, size_t *buf_size)
+{
+    sr_error_info_t *err_info = NULL;
+    struct lyd_node *node;
+    const char *attr_value;
+    uint32_t len, parent_len, old_len = 0;
+    int has_old = 0, has_new = 1;
+    sr_change_oper_t op;
+
+    SR_CHECK_ARG_APIRET(!session || !iter || !operation || !old_value || !new_value || !buf || !buf_size, session, err_info);
+
+    memset(old_value, 0, sizeof *old_value);
+    memset(new_value, 0, sizeof *new_value);
+    free(iter->any_str);
+    iter->any_str = NULL;
+
+    /* get next change */
+    if ((err_info = sr_diff_set_getnext(iter->set, &iter->idx, &node, &op))) {
+        return sr_api_ret(session, err_info);
+    }
+
+    if (!node) {
+        /* no more changes */
+        return SR_ERR_NOT_FOUND;
+    }
+
+    /* build the path */
+    if ((err_info = sr_change_path_build(iter, node, buf, buf_size))) {
+        return sr_api_ret(session, err_info);
+    }
+    len = iter->path[iter->path_count - 1].len;
+
+    /* fill values */
+    switch (op) {
+    case SR_OP_DELETED:
+        has_old = 1;
+        has_new = 0;
+        if ((err_info = sr_change_val_fill(iter, node, NULL, old_value))) {
+            return sr_api_ret(session, err_info);
+        }
+        break;
+    case SR_OP_MODIFIED:
+        /* "orig-value" attribute contains the previous value */
+        attr_value = sr_change_attr_value(node, iter->orig_value_annot);
+        if (!attr_value) {
             SR_ERRINFO_INT(&err_info);
             return sr_api_ret(session, err_info);
         }
-        if ((*node)->schema->nodetype == LYS_LEAFLIST) {
-            *prev_value = attr->value_str;
+
+        has_old = 1;
+        if ((err_info = sr_change_val_fill(iter, node, attr_value, old_value))) {
+            return sr_api_ret(session, err_info);
+        }
+
+        /* "orig-dflt" is present only if the previous value was default */
+        old_value->dflt = sr_change_attr_value(node, iter->orig_dflt_annot) ? 1 : 0;
+        break;
+    case SR_OP_CREATED:
+        if (!sr_ly_is_userord(node)) {
+            /* not a user-ordered list, so the operation is a simple creation */
+            break;
+        }
+    /* fallthrough */
+    case SR_OP_MOVED:
+        /* attribute contains the value of the node before in the order */
+        if (node->schema->nodetype == LYS_LEAFLIST) {
+            attr_value = sr_change_attr_value(node, iter->value_annot);
         } else {
-            assert((*node)->schema->nodetype == LYS_LIST);
-            *prev_list = attr->value_str;
+            assert(node->schema->nodetype == LYS_LIST);
+            attr_value = sr_change_attr_value(node, iter->key_annot);
+        }
+        if (!attr_value) {
+            SR_ERRINFO_INT(&err_info);
+            return sr_api_ret(session, err_info);
+        }
+
+        if (!attr_value[0]) {
+            /* inserted as the first item */
+            break;
+        }
+
+        has_old = 1;
+        if (node->schema->nodetype == LYS_LEAFLIST) {
+            err_info = sr_change_val_fill(iter, node, attr_value, old_value);
+        } else {
+            /* the previous list instance path is stored after this path, with the previous keys */
+            parent_len = (iter->path_count > 1) ? iter->path[iter->path_count - 2].len : 0;
+            old_len = len + 1;
+            if (!(err_info = sr_change_buf_reserve(buf, buf_size, old_len + parent_len + 1))) {
+                memcpy(*buf + old_len, *buf, parent_len);
+                len = old_len + parent_len;
+                if (!(err_info = sr_change_path_append(node, attr_value, buf, buf_size, &len))) {
+                    iter->path_buf = *buf;
+                    err_info = sr_change_val_fill(iter, node, NULL, old_value);
+                }
+            }
+        }
+        if (err_info) {
+            return sr_api_ret(session, err_info);
         }
         break;
     }
 
+    if (has_new && (err_info = sr_change_val_fill(iter, node, NULL, new_value))) {
+        return sr_api_ret(session, err_info);
+    }
+
+    /* the buffer is not reallocated anymore, set the paths */
+    if (has_old) {
+        old_value->xpath = *buf + old_len;
+    }
+    if (has_new) {
+        new_value->xpath = *buf;
+    }
+
+    *operation = op;
     return sr_api_ret(session, NULL);
 }
 
@@ -3646,6 +5070,8 @@ sr_free_change_iter(sr_change_iter_t *iter)
         lyd_free_withsiblings(iter->diff);
     }
     ly_set_free(iter->set);
+    free(iter->path);
+    free(iter->any_str);
     free(iter);
 }
 
@@ -491,6 +491,26 @@ const char *sr_get_repo_path(void);
 int sr_install_module(sr_conn_ctx_t *conn, const char *schema_path, const char *search_dirs, const char **features,
         int feat_count);
 
+/**
+ * @brief Install several new schemas (modules) into sysrepo at once. Deferred until there are no connections!
+ *
+ * All the modules are parsed in a single context and scheduled together so that installing many modules
+ * costs roughly the same as installing a single one. Once there are no connections, all the scheduled
+ * modules are installed in a single context rebuild. Modules that are already installed are skipped and
+ * ::SR_ERR_EXISTS is returned after all the other modules were scheduled. On any other error, no module
+ * is scheduled.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] schema_paths Array of paths to the new schemas. Can have either YANG or YIN extension/format.
+ * @param[in] count Number of schemas in @p schema_paths.
+ * @param[in] search_dirs Optional search directories for import schemas, supports the format `<dir>[:<dir>]*`.
+ * @param[in] features Optional array of arrays of enabled features for each schema.
+ * @param[in] feat_counts Array of numbers of enabled features for each schema, must be set if @p features is.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_install_modules(sr_conn_ctx_t *conn, const char **schema_paths, uint32_t count, const char *search_dirs,
+        const char ***features, const int *feat_counts);
+
 /**
  * @brief Set newly installed module startup and running data. It is necessary in case empty data are not valid
  * for the particular schema (module).
@@ -825,6 +845,196 @@ int sr_get_subtree(sr_session_ctx_t *session, const char *path, uint32_t timeout
 int sr_get_data(sr_session_ctx_t *session, const char *xpath, uint32_t max_depth, uint32_t timeout_ms,
         const sr_get_oper_options_t opts, struct lyd_node **data);
 
+/**
+ * @brief Retrieve a tree whose root nodes match any of the provided XPaths.
+ * Data are represented as _libyang_ subtrees.
+ *
+ * Equivalent to calling ::sr_get_data for each XPath and merging the results but the data of all
+ * the modules are loaded together only once and every operational data provider relevant for at least
+ * one of the XPaths is called only once.
+ *
+ * Required READ access, but if the access check fails, the module data are simply ignored without an error.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] xpaths Array of [XPaths](@ref paths) selecting root nodes of subtrees to be retrieved.
+ * @param[in] xpath_count Count of @p xpaths.
+ * @param[in] max_depth Maximum depth of the selected subtrees. 0 is unlimited, 1 will not return any
+ * descendant nodes. If a list should be returned, its keys are always returned as well.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds. If 0, default is used.
+ * @param[in] opts Options overriding default get behaviour.
+ * @param[out] data Connected top-level trees with all the requested data, allocated dynamically. NULL if none found.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_get_data_multi(sr_session_ctx_t *session, const char **xpaths, uint32_t xpath_count, uint32_t max_depth,
+        uint32_t timeout_ms, const sr_get_oper_options_t opts, struct lyd_node **data);
+
+/**
+ * @brief Read-only data borrowed using ::sr_get_data_borrowed.
+ */
+typedef struct sr_borrowed_data_s sr_borrowed_data_t;
+
+/**
+ * @brief Retrieve nodes matching the provided XPath without duplicating them. The nodes must not be modified
+ * and are valid only until released using ::sr_release_data.
+ *
+ * With ::SR_CONN_CACHE_RUNNING and no changes prepared in the session, the nodes are directly those in
+ * the running data cache of the connection. No lock is held while they are borrowed, if the cache needs
+ * to be updated meanwhile, the whole cached data tree is copied first and the borrowed nodes stay unchanged
+ * until released. Keep the data borrowed only as long as necessary and release them before disconnecting.
+ * If served from the session snapshot (::sr_session_snapshot_begin), the nodes are those in the snapshot and
+ * must not be used after it ends. In all the other cases the nodes are in a data tree owned by @p data.
+ *
+ * Required READ access, but if the access check fails, the module data are simply ignored without an error.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] xpath [XPath](@ref paths) selecting the nodes to be retrieved.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds. If 0, default is used.
+ * @param[in] opts Options overriding default get behaviour.
+ * @param[out] data Borrowed data to be released.
+ * @param[out] nodes Set of the selected nodes, valid until @p data are released.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_get_data_borrowed(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms,
+        const sr_get_oper_options_t opts, sr_borrowed_data_t **data, const struct ly_set **nodes);
+
+/**
+ * @brief Release data borrowed using ::sr_get_data_borrowed.
+ *
+ * @param[in] data Borrowed data to release.
+ */
+void sr_release_data(sr_borrowed_data_t *data);
+
+/**
+ * @brief Iterator used for retrieval of values using ::sr_get_items_iter call.
+ */
+typedef struct sr_val_iter_s sr_val_iter_t;
+
+/**
+ * @brief Create an iterator for retrieving the values of all the nodes matching the provided XPath.
+ * The nodes are only selected and every value is created only when retrieved by ::sr_get_item_next.
+ *
+ * The selected data are borrowed the same way as by ::sr_get_data_borrowed until the iterator is freed,
+ * no lock is held meanwhile so the data can be changed even from the same thread while iterating. The iterator
+ * then returns the values as they were when it was created.
+ *
+ * Required READ access, but if the access check fails, the module data are simply ignored without an error.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] xpath [XPath](@ref paths) of the data elements to be retrieved.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds. If 0, default is used.
+ * @param[in] opts Options overriding default get behaviour.
+ * @param[out] iter Iterator context that can be used to retrieve individual values using
+ * ::sr_get_item_next calls. Allocated by the function, should be freed with ::sr_free_val_iter.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_get_items_iter(sr_session_ctx_t *session, const char *xpath, uint32_t timeout_ms,
+        const sr_get_oper_options_t opts, sr_val_iter_t **iter);
+
+/**
+ * @brief Return the next value from the provided iterator created by ::sr_get_items_iter call.
+ *
+ * The value is owned by the iterator and reused for every next value so it must not be freed
+ * and is valid only until the next call or until the iterator is freed.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) acquired with ::sr_session_start call.
+ * @param[in,out] iter Iterator acquired with ::sr_get_items_iter call.
+ * @param[out] value Next value.
+ * @return Error code (::SR_ERR_OK on success, ::SR_ERR_NOT_FOUND in case that there are no more values).
+ */
+int sr_get_item_next(sr_session_ctx_t *session, sr_val_iter_t *iter, sr_val_t **value);
+
+/**
+ * @brief Frees ::sr_val_iter_t iterator and all memory allocated within it.
+ *
+ * @param[in] iter Iterator to be freed.
+ */
+void sr_free_val_iter(sr_val_iter_t *iter);
+
+/**
+ * @brief XPath prepared for repeated data retrieval using ::sr_xpath_prepare.
+ */
+typedef struct sr_xpath_prepared_s sr_xpath_prepared_t;
+
+/**
+ * @brief Prepare an XPath for repeated data retrieval. Modules with the selected data are learned only once
+ * and the decision which operational data subscriptions provide the selected data is remembered until
+ * the subscriptions of the module change.
+ *
+ * A prepared XPath can be used with any session of the connection but not concurrently by more threads.
+ *
+ * @param[in] conn Connection to use.
+ * @param[in] xpath [XPath](@ref paths) of the data to be retrieved.
+ * @param[out] prepared Prepared XPath, free using ::sr_xpath_prepared_free.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_xpath_prepare(sr_conn_ctx_t *conn, const char *xpath, sr_xpath_prepared_t **prepared);
+
+/**
+ * @brief Retrieve an array of data elements selected by a prepared XPath. Equivalent to ::sr_get_items.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] prepared XPath prepared for the connection of @p session.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds. If 0, default is used.
+ * @param[in] opts Options overriding default get behaviour.
+ * @param[out] values Array of requested nodes, if any, allocated dynamically (free using ::sr_free_values).
+ * @param[out] value_cnt Number of returned elements in the values array.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_get_items_prepared(sr_session_ctx_t *session, sr_xpath_prepared_t *prepared, uint32_t timeout_ms,
+        const sr_get_oper_options_t opts, sr_val_t **values, size_t *value_cnt);
+
+/**
+ * @brief Retrieve a tree whose root nodes match a prepared XPath. Equivalent to ::sr_get_data.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] prepared XPath prepared for the connection of @p session.
+ * @param[in] max_depth Maximum depth of the selected subtrees. 0 is unlimited, 1 will not return any
+ * descendant nodes. If a list should be returned, its keys are always returned as well.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds. If 0, default is used.
+ * @param[in] opts Options overriding default get behaviour.
+ * @param[out] data Connected top-level trees with all the requested data, allocated dynamically. NULL if none found.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_get_data_prepared(sr_session_ctx_t *session, sr_xpath_prepared_t *prepared, uint32_t max_depth,
+        uint32_t timeout_ms, const sr_get_oper_options_t opts, struct lyd_node **data);
+
+/**
+ * @brief Free a prepared XPath.
+ *
+ * @param[in] prepared Prepared XPath to free.
+ */
+void sr_xpath_prepared_free(sr_xpath_prepared_t *prepared);
+
+/**
+ * @brief Start a read snapshot of the session datastore. All the data of the selected modules are loaded
+ * (and for ::SR_DS_OPERATIONAL all the operational callbacks called) only once and any following
+ * ::sr_get_item, ::sr_get_items, ::sr_get_subtree, ::sr_get_data, and their prepared variants
+ * requiring only these modules are then served from the pinned data without any locking or callbacks.
+ *
+ * The snapshot is used only while the session datastore is the same as when it was started and
+ * with the same @p opts. Neither any changes of other sessions nor changes prepared by this session
+ * are visible in it. End it using ::sr_session_snapshot_end.
+ *
+ * Required READ access for all the modules, the data of others are not part of the snapshot.
+ *
+ * @param[in] session Session (not [DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] module_names Array of names of the modules to include, NULL for all the modules.
+ * @param[in] module_count Count of @p module_names.
+ * @param[in] timeout_ms Operational callback timeout in milliseconds. If 0, default is used.
+ * @param[in] opts Options overriding default get behaviour.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_session_snapshot_begin(sr_session_ctx_t *session, const char **module_names, uint32_t module_count,
+        uint32_t timeout_ms, const sr_get_oper_options_t opts);
+
+/**
+ * @brief End a read snapshot of the session started by ::sr_session_snapshot_begin and free its data.
+ *
+ * @param[in] session Session (not [DS](@ref sr_datastore_t)-specific) to use.
+ * @return Error code (::SR_ERR_OK on success).
+ */
+int sr_session_snapshot_end(sr_session_ctx_t *session);
+
 /**
  * @brief Free ::sr_val_t structure and all memory allocated within it.
  *
@@ -925,6 +1135,34 @@ int sr_set_item(sr_session_ctx_t *session, const char *path, const sr_val_t *val
 int sr_set_item_str(sr_session_ctx_t *session, const char *path, const char *value, const char *origin,
         const sr_edit_options_t opts);
 
+/**
+ * @brief Single change of a bulk edit, see ::sr_set_items.
+ */
+typedef struct sr_edit_item_s {
+    const char *xpath;          /**< [Path](@ref paths) identifier of the data element to be set. */
+    const char *value;          /**< String representation of the value to be set. */
+    const char *origin;         /**< Origin of the value, used only for ::SR_DS_OPERATIONAL edits. */
+    sr_edit_options_t opts;     /**< Options overriding default behavior for this item. */
+} sr_edit_item_t;
+
+/**
+ * @brief Prepare to set (create) the values of several leaves, leaf-lists, lists, or presence containers.
+ * These changes are applied only after calling ::sr_apply_changes.
+ *
+ * Function provides the same functionality as calling ::sr_set_item_str for every item in the order
+ * they are given but it is faster for large edits. Items sharing a parent with the previous item
+ * (ordered so that the same subtrees follow one another) are created directly in the already created parent
+ * without resolving the whole path.
+ *
+ * If an error occurs, all the previous items remain in the edit, unless the whole edit was discarded.
+ *
+ * @param[in] session Session ([DS](@ref sr_datastore_t)-specific) to use.
+ * @param[in] items Array of changes.
+ * @param[in] item_count Count of @p items.
+ * @return Error code (::SR_ERR_OK on success, ::SR_ERR_OPERATION_FAILED if the whole edit was discarded).
+ */
+int sr_set_items(sr_session_ctx_t *session, const sr_edit_item_t *items, size_t item_count);
+
 /**
  * @brief Prepare to selete the nodes matching the specified xpath. These changes are applied only
  * after calling ::sr_apply_changes. The accepted values are the same as for ::sr_set_item_str.
@@ -1413,6 +1651,31 @@ int sr_dup_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_
 int sr_get_change_next(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_change_oper_t *operation,
         sr_val_t **old_value, sr_val_t **new_value);
 
+/**
+ * @brief Return the next change from the provided iterator created
+ * by ::sr_get_changes_iter call into caller-provided storage. Unlike ::sr_get_change_next, no memory is allocated
+ * for every change so it is suitable for iterating over large changesets.
+ *
+ * Meaning of the values is the same as for ::sr_get_change_next with the values that are not set
+ * (such as old value of a created item) having their xpath set to NULL. All the paths are stored in @p buf
+ * and all the string values reference the change data so they are valid only until the next call or until
+ * the iterator is freed and must not be modified or freed.
+ *
+ * @note Pass the same buffer in all the calls and do not modify its content, the path of the previous change
+ * is reused for the next one.
+ *
+ * @param[in] session Implicit session provided in the callbacks (::sr_module_change_cb). Will not work with other sessions.
+ * @param[in,out] iter Iterator acquired with ::sr_get_changes_iter call.
+ * @param[out] operation Type of the operation made on the returned item.
+ * @param[out] old_value Old value of the item (the value before the change).
+ * @param[out] new_value New (modified) value of the the item.
+ * @param[in,out] buf Path buffer, may be NULL initially, enlarged as needed. Free it when the iteration is finished.
+ * @param[in,out] buf_size Size of @p buf.
+ * @return Error code (::SR_ERR_OK on success, ::SR_ERR_NOT_FOUND on no more changes).
+ */
+int sr_get_change_next_buf(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_change_oper_t *operation,
+        sr_val_t *old_value, sr_val_t *new_value, char **buf, size_t *buf_size);
+
 /**
  * @brief Returns the next change from the provided iterator created
  * by ::sr_get_changes_iter call. Data are represented as _libyang_ subtrees.
@@ -429,9 +429,33 @@ perf_get_items_iter_test(void **state, int op_num, int *items)
 {
     sr_conn_ctx_t *conn = *state;
     assert_non_null(conn);
-    (void)op_num;
 
-    *items = 0;
+    sr_session_ctx_t *session = NULL;
+    sr_val_iter_t *iter = NULL;
+    sr_val_t *value = NULL;
+    size_t count = 0;
+    int rc = 0;
+
+    /* start a session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* perform a get-items_iter request */
+    for (int i = 0; i<op_num; i++){
+        count = 0;
+        /* existing leaf */
+        rc = sr_get_items_iter(session, "/example-module:container/list/leaf", 0, 0, &iter);
+        assert_int_equal(SR_ERR_OK, rc);
+        while (sr_get_item_next(session, iter, &value) == SR_ERR_OK) {
+            ++count;
+        }
+        sr_free_val_iter(iter);
+    }
+
+    /* stop the session */
+    rc = sr_session_stop(session);
+    assert_int_equal(rc, SR_ERR_OK);
+    *items = count;
 }
 
 static size_t
@@ -606,6 +630,37 @@ perf_get_ietf_intefaces_tree_test(void **state, int op_num, int *items)
     *items = total_cnt;
 }
 
+static void
+perf_get_ietf_intefaces_wide_test(void **state, int op_num, int *items)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+
+    sr_session_ctx_t *session = NULL;
+    struct lyd_node *trees = NULL;
+    size_t total_cnt = 0;
+    int rc = 0;
+
+    /* start a session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* perform a get-subtrees request selecting a leaf of every list instance */
+    for (int i = 0; i<op_num; i++){
+        rc = sr_get_data(session, "/ietf-interfaces:interfaces/interface/ietf-ip:ipv4/ietf-ip:mtu", 0, 0, 0, &trees);
+        assert_int_equal(rc, SR_ERR_OK);
+        if (0 == i) {
+            total_cnt = get_nodes_cnt(trees);
+        }
+        lyd_free_withsiblings(trees);
+    }
+
+    /* stop the session */
+    rc = sr_session_stop(session);
+    assert_int_equal(rc, SR_ERR_OK);
+    *items = total_cnt;
+}
+
 static void
 perf_set_delete_test(void **state, int op_num, int *items)
 {
@@ -690,6 +745,91 @@ perf_set_delete_100_test(void **state, int op_num, int *items)
     *items = 0;
 }
 
+#define SET_ITEMS_IF_COUNT 100
+#define SET_ITEMS_XPATH_LEN 80
+
+static void
+set_items_prepare(char xpaths[][SET_ITEMS_XPATH_LEN], sr_edit_item_t *edit_items)
+{
+    const char *leaves[] = {"type", "description", "enabled"};
+    const char *values[] = {"iana-if-type:ethernetCsmacd", "ethernet interface", "true"};
+    size_t i, j, idx;
+
+    for (i = 0; i < SET_ITEMS_IF_COUNT; ++i) {
+        for (j = 0; j < 3; ++j) {
+            idx = i * 3 + j;
+            snprintf(xpaths[idx], SET_ITEMS_XPATH_LEN, "/ietf-interfaces:interfaces/interface[name='set%zu']/%s", i,
+                    leaves[j]);
+            edit_items[idx].xpath = xpaths[idx];
+            edit_items[idx].value = values[j];
+            edit_items[idx].origin = NULL;
+            edit_items[idx].opts = SR_EDIT_DEFAULT;
+        }
+    }
+}
+
+static void
+perf_set_item_str_100_test(void **state, int op_num, int *items)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    char xpaths[SET_ITEMS_IF_COUNT * 3][SET_ITEMS_XPATH_LEN];
+    sr_edit_item_t edit_items[SET_ITEMS_IF_COUNT * 3];
+    int rc = 0;
+
+    set_items_prepare(xpaths, edit_items);
+
+    /* start a session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* create the edit item by item */
+    for (int i = 0; i < op_num; i++) {
+        for (size_t j = 0; j < SET_ITEMS_IF_COUNT * 3; j++) {
+            rc = sr_set_item_str(session, edit_items[j].xpath, edit_items[j].value, NULL, SR_EDIT_DEFAULT);
+            assert_int_equal(rc, SR_ERR_OK);
+        }
+        rc = sr_discard_changes(session);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+
+    /* stop the session */
+    rc = sr_session_stop(session);
+    assert_int_equal(rc, SR_ERR_OK);
+    *items = SET_ITEMS_IF_COUNT * 3;
+}
+
+static void
+perf_set_items_100_test(void **state, int op_num, int *items)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    char xpaths[SET_ITEMS_IF_COUNT * 3][SET_ITEMS_XPATH_LEN];
+    sr_edit_item_t edit_items[SET_ITEMS_IF_COUNT * 3];
+    int rc = 0;
+
+    set_items_prepare(xpaths, edit_items);
+
+    /* start a session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* create the edit at once */
+    for (int i = 0; i < op_num; i++) {
+        rc = sr_set_items(session, edit_items, SET_ITEMS_IF_COUNT * 3);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_discard_changes(session);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+
+    /* stop the session */
+    rc = sr_session_stop(session);
+    assert_int_equal(rc, SR_ERR_OK);
+    *items = SET_ITEMS_IF_COUNT * 3;
+}
+
 static void
 perf_commit_test(void **state, int op_num, int *items)
 {
@@ -1073,8 +1213,11 @@ main(int argc, char **argv)
         {perf_get_subtree_with_data_load_test, "Get subtree incl session start", OP_COUNT, sysrepo_setup, sysrepo_teardown},
         {perf_get_subtrees_test, "Get subtrees all lists", OP_COUNT, sysrepo_setup, sysrepo_teardown},
         {perf_get_ietf_intefaces_tree_test, "Get subtrees ietf-if config", OP_COUNT, sysrepo_setup, sysrepo_teardown},
+        {perf_get_ietf_intefaces_wide_test, "Get subtrees ietf-if wide selection", OP_COUNT, sysrepo_setup, sysrepo_teardown},
         {perf_set_delete_test, "Set & delete one list", OP_COUNT, sysrepo_setup, sysrepo_teardown},
         {perf_set_delete_100_test, "Set & delete 100 lists", OP_COUNT_COMMIT, sysrepo_setup, sysrepo_teardown},
+        {perf_set_item_str_100_test, "Set 100 ietf-if items one by one", OP_COUNT_COMMIT, sysrepo_setup, sysrepo_teardown},
+        {perf_set_items_100_test, "Set 100 ietf-if items in bulk", OP_COUNT_COMMIT, sysrepo_setup, sysrepo_teardown},
         {perf_commit_test, "Commit one leaf change", OP_COUNT_COMMIT, sysrepo_setup, sysrepo_teardown},
         {perf_data_provide_test, "Operational data provide", OP_COUNT_COMMIT, data_provide_setup, data_provide_teardown},
         {perf_rpc_test, "RPC", OP_COUNT_COMMIT, sysrepo_setup, sysrepo_teardown},
@@ -36,6 +36,7 @@
 #include "common.h"
 #include "tests/config.h"
 #include "sysrepo.h"
+#include "utils/values.h"
 
 struct state {
     sr_conn_ctx_t *conn;
@@ -133,6 +134,71 @@ teardown_f(void **state)
     return 0;
 }
 
+/* compare sr_get_change_next_buf() values with those of sr_get_change_next() */
+static void
+check_change_val_buf(const sr_val_t *val, const sr_val_t *val_buf)
+{
+    char *str, *str_buf;
+
+    if (!val) {
+        assert_null(val_buf->xpath);
+        return;
+    }
+
+    assert_non_null(val_buf->xpath);
+    assert_string_equal(val->xpath, val_buf->xpath);
+    assert_int_equal(val->type, val_buf->type);
+    assert_int_equal(val->dflt, val_buf->dflt);
+
+    str = sr_val_to_str(val);
+    str_buf = sr_val_to_str(val_buf);
+    if (str) {
+        assert_non_null(str_buf);
+        assert_string_equal(str, str_buf);
+    } else {
+        assert_null(str_buf);
+    }
+    free(str);
+    free(str_buf);
+}
+
+static void
+check_changes_buf(sr_session_ctx_t *session, const char *xpath)
+{
+    sr_change_oper_t op, op_buf;
+    sr_change_iter_t *iter, *iter_buf;
+    sr_val_t *old_val, *new_val, old_val_buf, new_val_buf;
+    char *buf = NULL;
+    size_t buf_size = 0;
+    int ret, ret_buf;
+
+    ret = sr_get_changes_iter(session, xpath, &iter);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_changes_iter(session, xpath, &iter_buf);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    while (1) {
+        ret = sr_get_change_next(session, iter, &op, &old_val, &new_val);
+        ret_buf = sr_get_change_next_buf(session, iter_buf, &op_buf, &old_val_buf, &new_val_buf, &buf, &buf_size);
+        assert_int_equal(ret, ret_buf);
+        if (ret == SR_ERR_NOT_FOUND) {
+            break;
+        }
+        assert_int_equal(ret, SR_ERR_OK);
+
+        assert_int_equal(op, op_buf);
+        check_change_val_buf(old_val, &old_val_buf);
+        check_change_val_buf(new_val, &new_val_buf);
+
+        sr_free_val(old_val);
+        sr_free_val(new_val);
+    }
+
+    free(buf);
+    sr_free_change_iter(iter);
+    sr_free_change_iter(iter_buf);
+}
+
 /* TEST */
 static int
 module_change_done_cb(sr_session_ctx_t *session, const char *module_name, const char *xpath, sr_event_t event,
@@ -2688,6 +2754,9 @@ module_change_dflt_leaf_cb(sr_session_ctx_t *session, const char *module_name, c
         assert_int_equal(ret, SR_ERR_NOT_FOUND);
 
         sr_free_change_iter(iter);
+
+        /* the same changes using reusable buffers */
+        check_changes_buf(session, "/defaults:*//.");
         break;
     case 4:
     case 5:
@@ -5425,6 +5494,9 @@ module_change_userord_cb(sr_session_ctx_t *session, const char *module_name, con
 
         sr_free_change_iter(iter);
 
+        /* the same changes using reusable buffers */
+        check_changes_buf(session, "/test:*//.");
+
         /* check data */
         ret = sr_get_items(session, "/test:l1//.", 0, 0, &new_val, &val_count);
         assert_int_equal(ret, SR_ERR_OK);
@@ -26,6 +26,7 @@
 #include <pthread.h>
 #include <stdlib.h>
 #include <setjmp.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdlib.h>
@@ -2208,6 +2209,101 @@ test_replace_when(void **state)
     pthread_join(tid[1], NULL);
 }
 
+/* TEST */
+static size_t
+read_file(const char *path, char *buf, size_t size)
+{
+    FILE *f;
+    size_t len;
+
+    f = fopen(path, "r");
+    assert_non_null(f);
+    len = fread(buf, 1, size, f);
+    assert_true(len < size);
+    fclose(f);
+
+    return len;
+}
+
+static void
+test_startup2running_lazy(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
+    sr_val_t *val;
+    char *shm_path, *run_path, buf[4096], buf2[4096];
+    const char *prefix;
+    size_t len, len2;
+    uint32_t conn_count;
+    int ret;
+
+    prefix = getenv(SR_SHM_PREFIX_ENV) ? getenv(SR_SHM_PREFIX_ENV) : SR_SHM_PREFIX_DEFAULT;
+    ret = asprintf(&shm_path, "%s/%s_main", SR_SHM_DIR, prefix);
+    assert_int_not_equal(ret, -1);
+    ret = asprintf(&run_path, "%s/%s_test.running", SR_SHM_DIR, prefix);
+    assert_int_not_equal(ret, -1);
+
+    /* set different running and startup data */
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:test-leaf", "1", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_switch_ds(sess, SR_DS_STARTUP);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:test-leaf", "2", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_session_stop(sess);
+
+    len = read_file(run_path, buf, sizeof buf);
+
+    /* simulate a reboot, main SHM is created again and startup data are copied into running */
+    sr_disconnect(st->conn);
+    st->conn = NULL;
+    ret = sr_connection_count(&conn_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(conn_count, 0);
+    ret = unlink(shm_path);
+    assert_int_equal(ret, 0);
+    ret = sr_connect(0, &st->conn);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* running data file was not touched yet */
+    len2 = read_file(run_path, buf2, sizeof buf2);
+    assert_int_equal(len, len2);
+    assert_memory_equal(buf, buf2, len);
+
+    /* it is filled on the first access */
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_item(sess, "/test:test-leaf", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 2);
+    sr_free_val(val);
+
+    len2 = read_file(run_path, buf2, sizeof buf2);
+    assert_false((len == len2) && !memcmp(buf, buf2, len));
+
+    /* cleanup */
+    ret = sr_delete_item(sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_switch_ds(sess, SR_DS_STARTUP);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_session_stop(sess);
+
+    free(shm_path);
+    free(run_path);
+}
+
 /* MAIN */
 int
 main(void)
@@ -2221,6 +2317,7 @@ main(void)
         cmocka_unit_test_setup_teardown(test_replace_dflt, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_replace_case, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_replace_when, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_startup2running_lazy, setup_f, teardown_f),
     };
 
     setenv("CMOCKA_TEST_ABORT", "1", 1);
@@ -187,6 +187,88 @@ test_edit_item(void **state)
     assert_false(sr_has_changes(st->sess));
 }
 
+static void
+test_set_items(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_val_t *val;
+    int ret;
+    const sr_edit_item_t items[] = {
+        {"/ietf-interfaces:interfaces/interface[name='eth64']/type", "iana-if-type:ethernetCsmacd", NULL, 0},
+        {"/ietf-interfaces:interfaces/interface[name='eth64']/description", "", NULL, 0},
+        {"/ietf-interfaces:interfaces/interface[name='eth64']/enabled", "false", NULL, 0},
+        {"/ietf-interfaces:interfaces/interface[name='eth65']/type", "iana-if-type:ethernetCsmacd", NULL, 0}
+    };
+    const sr_edit_item_t bad_items[] = {
+        {"/ietf-interfaces:interfaces/interface[name='eth66']/type", "iana-if-type:ethernetCsmacd", NULL, 0},
+        {"/ietf-interfaces:interfaces/interface[name='eth66']/no", "15", NULL, 0},
+        {"/ietf-interfaces:interfaces/interface[name='eth67']/type", "iana-if-type:ethernetCsmacd", NULL, 0}
+    };
+    const sr_edit_item_t isolated_items[] = {
+        {"/ietf-interfaces:interfaces/interface[name='eth68']/type", "iana-if-type:ethernetCsmacd", NULL, 0},
+        {"/ietf-interfaces:interfaces/interface[name='eth68']/description", "isolated", NULL, SR_EDIT_ISOLATE},
+        {"/ietf-interfaces:interfaces/interface[name='eth68']/enabled", "false", NULL, 0},
+        {"/ietf-interfaces:interfaces/interface[name='eth68']/description", "last", NULL, SR_EDIT_ISOLATE},
+        {"/ietf-interfaces:interfaces/interface[name='eth69']/type", "iana-if-type:ethernetCsmacd", NULL, 0}
+    };
+    const sr_edit_item_t null_item = {NULL, "15", NULL, 0};
+
+    /* items sharing their parents */
+    ret = sr_set_items(st->sess, items, 4);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces/interface[name='eth64']/description", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(val->data.string_val, "");
+    sr_free_val(val);
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces/interface[name='eth64']/enabled", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_false(val->data.bool_val);
+    sr_free_val(val);
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces/interface[name='eth65']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(val->data.identityref_val, "iana-if-type:ethernetCsmacd");
+    sr_free_val(val);
+
+    /* isolated items mixed with items sharing their parents */
+    ret = sr_set_items(st->sess, isolated_items, 5);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces/interface[name='eth68']/description", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(val->data.string_val, "last");
+    sr_free_val(val);
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces/interface[name='eth68']/enabled", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_false(val->data.bool_val);
+    sr_free_val(val);
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces/interface[name='eth69']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val(val);
+
+    /* item without an xpath */
+    ret = sr_set_items(st->sess, &null_item, 1);
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+    assert_false(sr_has_changes(st->sess));
+
+    /* invalid item, the previous items remain in the edit and the following items are not added */
+    ret = sr_set_items(st->sess, bad_items, 3);
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+    assert_true(sr_has_changes(st->sess));
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces/interface[name='eth66']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val(val);
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces/interface[name='eth67']", 0, &val);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+}
+
 static void
 test_delete(void **state)
 {
@@ -1202,6 +1284,7 @@ main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_edit_item),
+        cmocka_unit_test_teardown(test_set_items, clear_interfaces),
         cmocka_unit_test_teardown(test_delete, clear_interfaces),
         cmocka_unit_test_teardown(test_create1, clear_interfaces),
         cmocka_unit_test_teardown(test_create2, clear_interfaces),
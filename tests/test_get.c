@@ -68,6 +68,9 @@ setup(void **state, int cached)
     if (sr_install_module(st->conn, TESTS_DIR "/files/defaults.yang", TESTS_DIR "/files", NULL, 0) != SR_ERR_OK) {
         return 1;
     }
+    if (sr_install_module(st->conn, TESTS_DIR "/files/test.yang", TESTS_DIR "/files", NULL, 0) != SR_ERR_OK) {
+        return 1;
+    }
     sr_disconnect(st->conn);
 
     if (sr_connect(cached ? SR_CONN_CACHE_RUNNING : 0, &(st->conn)) != SR_ERR_OK) {
@@ -101,6 +104,7 @@ teardown_f(void **state)
     sr_remove_module(st->conn, "simple");
     sr_remove_module(st->conn, "simple-aug");
     sr_remove_module(st->conn, "defaults");
+    sr_remove_module(st->conn, "test");
 
     sr_disconnect(st->conn);
     free(st);
@@ -453,6 +457,293 @@ test_union(void **state)
     sr_unsubscribe(subscr);
 }
 
+/* TEST */
+static void
+test_keys_union(void **state)
+{
+    struct state *st = (struct state *)*state;
+    struct lyd_node *data;
+    struct ly_set *set;
+    char path[64], value[8];
+    int ret, i;
+
+    for (i = 0; i < 3; ++i) {
+        sprintf(path, "/test:l1[k='k%d']/v", i);
+        sprintf(value, "%d", i);
+        ret = sr_set_item_str(st->sess, path, value, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* only keys, each with its list */
+    ret = sr_get_data(st->sess, "/test:l1/k", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    set = lyd_find_path(data, "/test:l1");
+    assert_int_equal(set->number, 3);
+    ly_set_free(set);
+    set = lyd_find_path(data, "/test:l1/k");
+    assert_int_equal(set->number, 3);
+    ly_set_free(set);
+    set = lyd_find_path(data, "/test:l1/v");
+    assert_int_equal(set->number, 0);
+    ly_set_free(set);
+    lyd_free_withsiblings(data);
+
+    /* union not in the document order, overlapping, with keys */
+    ret = sr_get_data(st->sess, "/test:l1[k='k2']/v | /test:l1[k='k0'] | /test:l1[k='k2']/k | /test:l1[k='k0']/k",
+            0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    set = lyd_find_path(data, "/test:l1");
+    assert_int_equal(set->number, 2);
+    ly_set_free(set);
+    set = lyd_find_path(data, "/test:l1/k");
+    assert_int_equal(set->number, 2);
+    ly_set_free(set);
+    set = lyd_find_path(data, "/test:l1/v");
+    assert_int_equal(set->number, 2);
+    ly_set_free(set);
+    lyd_free_withsiblings(data);
+
+    /* the same with limited depth */
+    ret = sr_get_data(st->sess, "/test:l1[k='k1']/k | /test:l1[k='k2'] | /test:l1[k='k1']", 1, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    set = lyd_find_path(data, "/test:l1/k");
+    assert_int_equal(set->number, 2);
+    ly_set_free(set);
+    lyd_free_withsiblings(data);
+
+    /* cleanup */
+    ret = sr_delete_item(st->sess, "/test:l1", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
+/* TEST */
+static void
+test_list_instance(void **state)
+{
+    struct state *st = (struct state *)*state;
+    struct lyd_node *data;
+    sr_val_t *val, *vals;
+    size_t val_count;
+    char path[64], value[8];
+    int ret, i;
+
+    /* create enough top-level list instances for them to be indexed */
+    for (i = 0; i < 100; ++i) {
+        sprintf(path, "/test:l1[k='k%d']/v", i);
+        sprintf(value, "%d", i);
+        ret = sr_set_item_str(st->sess, path, value, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_set_item_str(st->sess, "/test:test-leaf", "5", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* get a leaf of a single instance */
+    ret = sr_get_item(st->sess, "/test:l1[k='k50']/v", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->type, SR_UINT8_T);
+    assert_int_equal(val->data.uint8_val, 50);
+    sr_free_val(val);
+
+    ret = sr_get_item(st->sess, "/test:l1[k=\"k99\"]/v", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 99);
+    sr_free_val(val);
+
+    /* get a whole instance */
+    ret = sr_get_items(st->sess, "/test:l1[k='k7']//.", 0, 0, &vals, &val_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val_count, 3);
+    assert_string_equal(vals[0].xpath, "/test:l1[k='k7']");
+    sr_free_values(vals, val_count);
+
+    ret = sr_get_data(st->sess, "/test:l1[k='k3']", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_non_null(data);
+    assert_string_equal(data->schema->name, "l1");
+    assert_null(data->next);
+    lyd_free_withsiblings(data);
+
+    /* non-existing instance */
+    ret = sr_get_item(st->sess, "/test:l1[k='k100']/v", 0, &val);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+
+    /* other data of the module are still available */
+    ret = sr_get_item(st->sess, "/test:test-leaf", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 5);
+    sr_free_val(val);
+
+    ret = sr_get_items(st->sess, "/test:l1[k='k1']/v | /test:l1[k='k2']/v", 0, 0, &vals, &val_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val_count, 2);
+    sr_free_values(vals, val_count);
+
+    /* pending changes of other instances are applied */
+    ret = sr_delete_item(st->sess, "/test:l1[k='k10']", SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_item(st->sess, "/test:l1[k='k20']/v", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 20);
+    sr_free_val(val);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_item(st->sess, "/test:l1[k='k10']/v", 0, &val);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+    ret = sr_get_item(st->sess, "/test:l1[k='k11']/v", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 11);
+    sr_free_val(val);
+
+    /* cleanup */
+    ret = sr_delete_item(st->sess, "/test:l1", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(st->sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
+/* TEST */
+static void
+test_borrowed(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_borrowed_data_t *data, *data2;
+    const struct ly_set *nodes, *nodes2;
+    char path[64], value[8];
+    int ret, i;
+
+    for (i = 0; i < 3; ++i) {
+        sprintf(path, "/test:l1[k='k%d']/v", i);
+        sprintf(value, "%d", i);
+        ret = sr_set_item_str(st->sess, path, value, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* borrow the values */
+    ret = sr_get_data_borrowed(st->sess, "/test:l1/v", 0, 0, &data, &nodes);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(nodes->number, 3);
+    for (i = 0; i < 3; ++i) {
+        sprintf(value, "%d", i);
+        assert_string_equal(((struct lyd_node_leaf_list *)nodes->set.d[i])->value_str, value);
+    }
+
+    /* more data can be borrowed at the same time */
+    ret = sr_get_data_borrowed(st->sess, "/test:l1[k='k1']", 0, 0, &data2, &nodes2);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(nodes2->number, 1);
+    sr_release_data(data2);
+
+    /* data can be changed while borrowed, the borrowed nodes stay the same */
+    ret = sr_set_item_str(st->sess, "/test:l1[k='k1']/v", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(nodes->number, 3);
+    assert_string_equal(((struct lyd_node_leaf_list *)nodes->set.d[1])->value_str, "1");
+
+    ret = sr_get_data_borrowed(st->sess, "/test:l1[k='k1']/v", 0, 0, &data2, &nodes2);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(nodes2->number, 1);
+    assert_string_equal(((struct lyd_node_leaf_list *)nodes2->set.d[0])->value_str, "10");
+    sr_release_data(data);
+    sr_release_data(data2);
+
+    /* pending changes are applied */
+    ret = sr_set_item_str(st->sess, "/test:l1[k='k3']/v", "3", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_data_borrowed(st->sess, "/test:l1/v", 0, 0, &data, &nodes);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(nodes->number, 4);
+    sr_release_data(data);
+
+    /* cleanup */
+    ret = sr_delete_item(st->sess, "/test:l1", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
+/* TEST */
+static void
+test_items_iter(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_val_iter_t *iter;
+    sr_val_t *val;
+    char path[64], value[8];
+    int ret, i;
+
+    for (i = 0; i < 10; ++i) {
+        sprintf(path, "/test:l1[k='k%d']/v", i);
+        sprintf(value, "%d", i);
+        ret = sr_set_item_str(st->sess, path, value, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* iterate over all the values */
+    ret = sr_get_items_iter(st->sess, "/test:l1/v", 0, 0, &iter);
+    assert_int_equal(ret, SR_ERR_OK);
+    for (i = 0; i < 10; ++i) {
+        ret = sr_get_item_next(st->sess, iter, &val);
+        assert_int_equal(ret, SR_ERR_OK);
+        sprintf(path, "/test:l1[k='k%d']/v", i);
+        assert_string_equal(val->xpath, path);
+        assert_int_equal(val->type, SR_UINT8_T);
+        assert_int_equal(val->data.uint8_val, i);
+    }
+    ret = sr_get_item_next(st->sess, iter, &val);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+    assert_null(val);
+    sr_free_val_iter(iter);
+
+    /* no values, freed before the end */
+    ret = sr_get_items_iter(st->sess, "/test:l1[k='k10']/v", 0, 0, &iter);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_item_next(st->sess, iter, &val);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+    sr_free_val_iter(iter);
+
+    ret = sr_get_items_iter(st->sess, "/test:l1/v", 0, 0, &iter);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_item_next(st->sess, iter, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val_iter(iter);
+
+    /* data changed while iterating, the iterator continues with the previous values */
+    ret = sr_get_items_iter(st->sess, "/test:l1/v", 0, 0, &iter);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_item_next(st->sess, iter, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 0);
+    ret = sr_set_item_str(st->sess, "/test:l1[k='k1']/v", "11", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_item_next(st->sess, iter, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 1);
+    sr_free_val_iter(iter);
+
+    /* cleanup */
+    ret = sr_delete_item(st->sess, "/test:l1", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
 int
 main(void)
 {
@@ -464,6 +755,13 @@ main(void)
         cmocka_unit_test_setup_teardown(test_no_read_access, setup_cached_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_explicit_default, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_union, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_keys_union, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_list_instance, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_list_instance, setup_cached_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_borrowed, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_borrowed, setup_cached_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_items_iter, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_items_iter, setup_cached_f, teardown_f),
     };
 
     setenv("CMOCKA_TEST_ABORT", "1", 1);
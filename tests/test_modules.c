@@ -23,6 +23,7 @@
 
 #include <unistd.h>
 #include <setjmp.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdlib.h>
@@ -164,6 +165,58 @@ test_install_module(void **state)
     assert_int_equal(ret, SR_ERR_OK);
 }
 
+static void
+test_install_modules(void **state)
+{
+    struct state *st = (struct state *)*state;
+    const struct lys_module *ly_mod;
+    const char *schema_paths[] = {TESTS_DIR "/files/feature-deps.yang", TESTS_DIR "/files/feature-deps2.yang"};
+    const char *en_feat = "featx";
+    const char **features[] = {NULL, &en_feat};
+    int feat_counts[] = {0, 1}, ret;
+    uint32_t conn_count;
+
+    /* install both modules at once */
+    ret = sr_install_modules(st->conn, schema_paths, 2, TESTS_DIR "/files", features, feat_counts);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* installing them again must fail */
+    ret = sr_install_modules(st->conn, schema_paths, 2, TESTS_DIR "/files", features, feat_counts);
+    assert_int_equal(ret, SR_ERR_EXISTS);
+
+    /* apply scheduled changes */
+    sr_disconnect(st->conn);
+    st->conn = NULL;
+    ret = sr_connection_count(&conn_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(conn_count, 0);
+    ret = sr_connect(SR_CONN_ERR_ON_SCHED_FAIL, &st->conn);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* check both modules are installed */
+    ly_mod = ly_ctx_get_module(sr_get_context(st->conn), "feature-deps", NULL, 1);
+    assert_non_null(ly_mod);
+    ly_mod = ly_ctx_get_module(sr_get_context(st->conn), "feature-deps2", NULL, 1);
+    assert_non_null(ly_mod);
+    assert_int_equal(lys_features_state(ly_mod, "featx"), 1);
+
+    ret = sr_remove_module(st->conn, "feature-deps");
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_remove_module(st->conn, "feature-deps2");
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* an invalid module in the batch must not unschedule the deletion of the previous one */
+    schema_paths[1] = TESTS_DIR "/files/feature-deps2.txt";
+    ret = sr_install_modules(st->conn, schema_paths, 2, TESTS_DIR "/files", NULL, NULL);
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+
+    /* so it can still be unscheduled, and scheduled again */
+    ret = sr_install_module(st->conn, TESTS_DIR "/files/feature-deps.yang", TESTS_DIR "/files", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_remove_module(st->conn, "feature-deps");
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
 static void
 test_data_deps(void **state)
 {
@@ -240,6 +293,7 @@ test_data_deps(void **state)
             "<inst-id>"
                 "<path xmlns:r=\"urn:refs\">/r:inst-id</path>"
             "</inst-id>"
+            "<ref xmlns:t=\"urn:test\">/t:test-leaf</ref>"
         "</deps>"
     "</module>"
     );
@@ -408,11 +462,16 @@ static void
 test_inv_deps(void **state)
 {
     struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
     uint32_t conn_count;
     int ret;
 
     ret = sr_install_module(st->conn, TESTS_DIR "/files/ietf-routing.yang", TESTS_DIR "/files", NULL, 0);
     assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_install_module(st->conn, TESTS_DIR "/files/test.yang", TESTS_DIR "/files", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_install_module(st->conn, TESTS_DIR "/files/refs2.yang", TESTS_DIR "/files", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
 
     /* apply scheduled changes */
     sr_disconnect(st->conn);
@@ -423,12 +482,115 @@ test_inv_deps(void **state)
     ret = sr_connect(0, &st->conn);
     assert_int_equal(ret, SR_ERR_OK);
 
+    ret = sr_session_start(st->conn, SR_DS_RUNNING, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* create valid data of the inverse dependency */
+    ret = sr_set_item_str(sess, "/test:test-leaf", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:ll1", "-1", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:cont/server", "localhost", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/refs2:lref", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/refs2:l", "val", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/refs2:wc/wl", "w", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/refs2:wref", "w", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* change the leafref target, sr_validate() has no diff and validates all the inverse dependencies,
+     * sr_apply_changes() validates only the ones referencing the changed nodes */
+    ret = sr_set_item_str(sess, "/test:test-leaf", "8", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_validate(sess, NULL, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* change the must target */
+    ret = sr_set_item_str(sess, "/test:ll1", "-2", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:ll1", "-3", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_validate(sess, NULL, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* change the when target, the container is removed and the leafref to it is broken */
+    ret = sr_set_item_str(sess, "/test:cont/server", "remotehost", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_validate(sess, NULL, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* change a node not referenced by the inverse dependency */
+    ret = sr_set_item_str(sess, "/test:l1[k='one']/v", "1", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_validate(sess, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* cleanup the data */
+    ret = sr_delete_item(sess, "/refs2:lref", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/refs2:l", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/refs2:wc", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/refs2:wref", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/test:ll1[.='-1']", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/test:l1[k='one']", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_delete_item(sess, "/test:cont", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_session_stop(sess);
+
+    ret = sr_remove_module(st->conn, "refs2");
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_remove_module(st->conn, "test");
+    assert_int_equal(ret, SR_ERR_OK);
     ret = sr_remove_module(st->conn, "ietf-routing");
     assert_int_equal(ret, SR_ERR_OK);
     ret = sr_remove_module(st->conn, "ietf-interfaces");
     assert_int_equal(ret, SR_ERR_OK);
 
     /* check current internal data */
+    cmp_int_data(st->conn, "refs2",
+    "<module xmlns=\"http://www.sysrepo.org/yang/sysrepo\">"
+        "<name>refs2</name>"
+        "<removed/>"
+        "<deps>"
+            "<module>test</module>"
+            "<ref xmlns:t=\"urn:test\">/t:test-leaf</ref>"
+            "<ref xmlns:t=\"urn:test\">/t:ll1</ref>"
+            "<ref xmlns:t=\"urn:test\">/t:cont</ref>"
+            "<ref xmlns:t=\"urn:test\">/t:cont/t:server</ref>"
+        "</deps>"
+    "</module>"
+    );
+
     cmp_int_data(st->conn, "ietf-routing",
     "<module xmlns=\"http://www.sysrepo.org/yang/sysrepo\">"
         "<name>ietf-routing</name>"
@@ -436,6 +598,12 @@ test_inv_deps(void **state)
         "<removed/>"
         "<deps>"
             "<module>ietf-interfaces</module>"
+            "<ref xmlns:if=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">/if:interfaces-state</ref>"
+            "<ref xmlns:if=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">/if:interfaces-state/if:interface</ref>"
+            "<ref xmlns:if=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">/if:interfaces-state/if:interface/if:name</ref>"
+            "<ref xmlns:if=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">/if:interfaces</ref>"
+            "<ref xmlns:if=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">/if:interfaces/if:interface</ref>"
+            "<ref xmlns:if=\"urn:ietf:params:xml:ns:yang:ietf-interfaces\">/if:interfaces/if:interface/if:name</ref>"
         "</deps>"
         "<inverse-deps>ietf-interfaces</inverse-deps>"
         "<rpc>"
@@ -457,6 +625,14 @@ test_inv_deps(void **state)
         "<removed/>"
         "<deps>"
             "<module>ietf-routing</module>"
+            "<ref xmlns:rt=\"urn:ietf:params:xml:ns:yang:ietf-routing\">/rt:routing-state</ref>"
+            "<ref xmlns:rt=\"urn:ietf:params:xml:ns:yang:ietf-routing\">/rt:routing-state/rt:routing-instance</ref>"
+            "<ref xmlns:rt=\"urn:ietf:params:xml:ns:yang:ietf-routing\">"
+                "/rt:routing-state/rt:routing-instance/rt:name</ref>"
+            "<ref xmlns:rt=\"urn:ietf:params:xml:ns:yang:ietf-routing\">"
+                "/rt:routing-state/rt:routing-instance/rt:interfaces</ref>"
+            "<ref xmlns:rt=\"urn:ietf:params:xml:ns:yang:ietf-routing\">"
+                "/rt:routing-state/rt:routing-instance/rt:interfaces/rt:interface</ref>"
         "</deps>"
         "<inverse-deps>ietf-routing</inverse-deps>"
     "</module>"
@@ -980,6 +1156,8 @@ test_foreign_aug(void **state)
         "<name>aug-trg</name>"
         "<deps>"
             "<module>aug</module>"
+            "<ref xmlns:aug=\"aug\">/aug:bc1</ref>"
+            "<ref xmlns:aug=\"aug\">/aug:bc1/aug:bcs1</ref>"
         "</deps>"
     "</module>"
     );
@@ -1030,6 +1208,8 @@ test_foreign_aug(void **state)
         "<name>aug-trg</name>"
         "<deps>"
             "<module>aug</module>"
+            "<ref xmlns:aug=\"aug\">/aug:bc1</ref>"
+            "<ref xmlns:aug=\"aug\">/aug:bc1/aug:bcs1</ref>"
         "</deps>"
     "</module>"
     );
@@ -1125,6 +1305,107 @@ test_empty_invalid(void **state)
     assert_int_equal(ret, SR_ERR_NOT_FOUND);
 }
 
+static void
+test_startup_tmp_file(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_session_ctx_t *sess;
+    sr_val_t *val;
+    char path[1024], tmp_path[1024];
+    FILE *f;
+    int ret;
+    uint32_t conn_count;
+
+    sprintf(path, "%s/data/test.startup", sr_get_repo_path());
+    sprintf(tmp_path, "%s.tmp", path);
+
+    /* install the module */
+    ret = sr_install_module(st->conn, TESTS_DIR "/files/test.yang", TESTS_DIR "/files", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* apply scheduled changes */
+    sr_disconnect(st->conn);
+    st->conn = NULL;
+    ret = sr_connection_count(&conn_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(conn_count, 0);
+    ret = sr_connect(0, &st->conn);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* startup data are replaced by renaming a temporary file, nothing is left behind */
+    ret = sr_session_start(st->conn, SR_DS_STARTUP, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(sess, "/test:test-leaf", "12", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(access(path, F_OK), 0);
+    assert_int_equal(access(tmp_path, F_OK), -1);
+
+    /* simulate a crash while storing the data */
+    f = fopen(tmp_path, "w");
+    assert_non_null(f);
+    fputs("garbage", f);
+    fclose(f);
+
+    /* reading the data neither uses nor removes the temporary file */
+    ret = sr_get_item(sess, "/test:test-leaf", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 12);
+    sr_free_val(val);
+    assert_int_equal(access(tmp_path, F_OK), 0);
+
+    /* a new write overwrites it */
+    ret = sr_set_item_str(sess, "/test:test-leaf", "13", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(access(tmp_path, F_OK), -1);
+    ret = sr_get_item(sess, "/test:test-leaf", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 13);
+    sr_free_val(val);
+    sr_session_stop(sess);
+
+    /* simulate a crash again */
+    f = fopen(tmp_path, "w");
+    assert_non_null(f);
+    fputs("garbage", f);
+    fclose(f);
+
+    /* schedule a change so that main SHM modules are recreated on the next connection */
+    ret = sr_install_module(st->conn, TESTS_DIR "/files/when1.yang", TESTS_DIR "/files", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_disconnect(st->conn);
+    st->conn = NULL;
+    ret = sr_connection_count(&conn_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(conn_count, 0);
+    ret = sr_connect(0, &st->conn);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* the stale temporary file was removed, the data are intact */
+    assert_int_equal(access(tmp_path, F_OK), -1);
+    ret = sr_session_start(st->conn, SR_DS_STARTUP, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_get_item(sess, "/test:test-leaf", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 13);
+    sr_free_val(val);
+
+    /* cleanup */
+    ret = sr_delete_item(sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_session_stop(sess);
+
+    ret = sr_remove_module(st->conn, "when1");
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_remove_module(st->conn, "test");
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
 static void
 test_startup_data_foreign_identityref(void **state)
 {
@@ -1529,6 +1810,7 @@ main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup_teardown(test_install_module, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_install_modules, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_data_deps, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_op_deps, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_inv_deps, setup_f, teardown_f),
@@ -1540,6 +1822,7 @@ main(void)
         cmocka_unit_test_setup_teardown(test_replay_support, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_foreign_aug, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_empty_invalid, setup_f, teardown_f),
+        cmocka_unit_test_setup_teardown(test_startup_tmp_file, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_startup_data_foreign_identityref, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_set_module_access, setup_f, teardown_f),
         cmocka_unit_test_setup_teardown(test_get_module_access, setup_f, teardown_f),
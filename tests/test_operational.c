@@ -1789,6 +1789,202 @@ test_xpath_check(void **state)
     sr_unsubscribe(subscr);
 }
 
+/* TEST */
+static void
+test_xpath_prepared(void **state)
+{
+    struct state *st = (struct state *)*state;
+    struct lyd_node *data;
+    sr_subscription_ctx_t *subscr;
+    sr_xpath_prepared_t *state_xp, *conf_xp;
+    sr_val_t *vals;
+    size_t val_count;
+    int ret;
+
+    ret = sr_xpath_prepare(st->conn, "/ietf-interfaces:interfaces-state", &state_xp);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_xpath_prepare(st->conn, "/ietf-interfaces:interfaces", &conf_xp);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_session_switch_ds(st->sess, SR_DS_OPERATIONAL);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* no subscriptions */
+    ret = sr_get_data_prepared(st->sess, state_xp, 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_null(data);
+
+    /* subscribe as state data provider */
+    ret = sr_oper_get_items_subscribe(st->sess, "ietf-interfaces", "/ietf-interfaces:interfaces-state", xpath_check_oper_cb,
+            st, 0, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read state data, new subscription is used */
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+    ret = sr_get_data_prepared(st->sess, state_xp, 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    lyd_free_withsiblings(data);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    ret = sr_get_items_prepared(st->sess, state_xp, 0, 0, &vals, &val_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_values(vals, val_count);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 2);
+
+    /* read interfaces, callback not called */
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+    ret = sr_get_items_prepared(st->sess, conf_xp, 0, 0, &vals, &val_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_values(vals, val_count);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 0);
+
+    sr_unsubscribe(subscr);
+
+    /* read state data, removed subscription is not used */
+    ret = sr_get_data_prepared(st->sess, state_xp, 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_null(data);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 0);
+
+    sr_xpath_prepared_free(state_xp);
+    sr_xpath_prepared_free(conf_xp);
+}
+
+/* TEST */
+static void
+test_snapshot(void **state)
+{
+    struct state *st = (struct state *)*state;
+    struct lyd_node *data;
+    sr_session_ctx_t *sess;
+    sr_subscription_ctx_t *subscr;
+    sr_val_t *val, *vals;
+    size_t val_count;
+    const char *mod_name = "ietf-interfaces";
+    int ret;
+
+    ret = sr_session_start(st->conn, SR_DS_OPERATIONAL, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_switch_ds(st->sess, SR_DS_OPERATIONAL);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* set some operational data */
+    ret = sr_set_item_str(sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/type",
+            "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* subscribe as state data provider */
+    ret = sr_oper_get_items_subscribe(st->sess, "ietf-interfaces", "/ietf-interfaces:interfaces-state", xpath_check_oper_cb,
+            st, SR_SUBSCR_OPER_MERGE, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* start the snapshot, callback called once */
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+    ret = sr_session_snapshot_begin(st->sess, &mod_name, 1, 0, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    ret = sr_session_snapshot_begin(st->sess, NULL, 0, 0, 0);
+    assert_int_equal(ret, SR_ERR_EXISTS);
+
+    /* change the operational data */
+    ret = sr_set_item_str(sess, "/ietf-interfaces:interfaces-state/interface[name='eth2']/type",
+            "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read from the snapshot, change not visible and callback not called */
+    ret = sr_get_items(st->sess, "/ietf-interfaces:interfaces-state/interface", 0, 0, &vals, &val_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val_count, 1);
+    assert_string_equal(vals[0].xpath, "/ietf-interfaces:interfaces-state/interface[name='eth1']");
+    sr_free_values(vals, val_count);
+
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth2']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+
+    ret = sr_get_data(st->sess, "/ietf-interfaces:interfaces-state", 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_non_null(data);
+    assert_null(data->child->next);
+    lyd_free_withsiblings(data);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    /* end the snapshot, current data read */
+    ret = sr_session_snapshot_end(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_snapshot_end(st->sess);
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+
+    ret = sr_get_items(st->sess, "/ietf-interfaces:interfaces-state/interface", 0, 0, &vals, &val_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val_count, 2);
+    sr_free_values(vals, val_count);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 2);
+
+    sr_unsubscribe(subscr);
+    sr_session_stop(sess);
+}
+
+/* TEST */
+static void
+test_get_data_multi(void **state)
+{
+    struct state *st = (struct state *)*state;
+    struct lyd_node *data;
+    struct ly_set *set;
+    sr_subscription_ctx_t *subscr;
+    const char *xpaths[] = {
+        "/ietf-interfaces:interfaces-state/interface[name='eth1']",
+        "/ietf-interfaces:interfaces-state/interface[name='eth2']/type",
+        "/ietf-interfaces:interfaces"
+    };
+    int ret;
+
+    ret = sr_session_switch_ds(st->sess, SR_DS_OPERATIONAL);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* set some operational data */
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/type",
+            "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth2']/type",
+            "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth3']/type",
+            "iana-if-type:ethernetCsmacd", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* subscribe as state data provider */
+    ret = sr_oper_get_items_subscribe(st->sess, "ietf-interfaces", "/ietf-interfaces:interfaces-state", xpath_check_oper_cb,
+            st, SR_SUBSCR_OPER_MERGE, &subscr);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read all the data at once, callback called only once */
+    ATOMIC_STORE_RELAXED(st->cb_called, 0);
+    ret = sr_get_data_multi(st->sess, xpaths, 3, 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(ATOMIC_LOAD_RELAXED(st->cb_called), 1);
+
+    /* all the selected data are in one tree */
+    set = lyd_find_path(data, "/ietf-interfaces:interfaces-state/interface");
+    assert_non_null(set);
+    assert_int_equal(set->number, 2);
+    ly_set_free(set);
+    lyd_free_withsiblings(data);
+
+    /* invalid arguments */
+    ret = sr_get_data_multi(st->sess, xpaths, 0, 0, 0, 0, &data);
+    assert_int_equal(ret, SR_ERR_INVAL_ARG);
+
+    sr_unsubscribe(subscr);
+}
+
 /* TEST */
 static int
 state_only_oper_cb(sr_session_ctx_t *session, const char *module_name, const char *xpath, const char *request_xpath,
@@ -2330,6 +2526,84 @@ test_stored_state(void **state)
     sr_unsubscribe(subscr);
 }
 
+/* TEST */
+static void
+test_stored_cache(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_conn_ctx_t *conn;
+    sr_session_ctx_t *sess;
+    sr_val_t *val;
+    int ret;
+
+    /* create another connection and session, each with its own stored diff cache */
+    ret = sr_connect(0, &conn);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_session_start(conn, SR_DS_OPERATIONAL, &sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_session_switch_ds(st->sess, SR_DS_OPERATIONAL);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* set some operational data */
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/type",
+            "iana-if-type:ethernetCsmacd", NULL, SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read the data from the other connection, it is cached */
+    ret = sr_get_item(sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val(val);
+
+    /* change the data, the cache of the other connection must be invalidated */
+    ret = sr_set_item_str(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth2']/type",
+            "iana-if-type:ethernetCsmacd", NULL, SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_item(sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val(val);
+    ret = sr_get_item(sess, "/ietf-interfaces:interfaces-state/interface[name='eth2']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val(val);
+
+    /* remove some data, it must disappear from the other connection as well */
+    ret = sr_delete_item(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_item(sess, "/ietf-interfaces:interfaces-state/interface[name='eth1']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+
+    /* change the data from the other connection */
+    ret = sr_set_item_str(sess, "/ietf-interfaces:interfaces-state/interface[name='eth3']/type",
+            "iana-if-type:ethernetCsmacd", NULL, SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth2']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val(val);
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth3']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val(val);
+
+    /* disconnect, its data must be removed from the cache */
+    sr_disconnect(conn);
+
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth3']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_NOT_FOUND);
+    ret = sr_get_item(st->sess, "/ietf-interfaces:interfaces-state/interface[name='eth2']/type", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val(val);
+}
+
 /* TEST */
 static void
 test_stored_state_list(void **state)
@@ -2453,6 +2727,104 @@ test_stored_state_list(void **state)
     free(str1);
 }
 
+/* TEST */
+static void
+test_stored_state_list_many(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_val_t *values;
+    size_t value_count;
+    char val[16], path[64];
+    int ret, i;
+
+    /* switch to operational DS */
+    ret = sr_session_switch_ds(st->sess, SR_DS_OPERATIONAL);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* push many state leaf-list instances, each value twice */
+    for (i = 0; i < 2000; ++i) {
+        sprintf(val, "val%d", i % 1000);
+        ret = sr_set_item_str(st->sess, "/mixed-config:test-state/ll", val, NULL, SR_EDIT_STRICT);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* push some more in a separate edit */
+    for (i = 0; i < 10; ++i) {
+        sprintf(val, "val%d", i);
+        ret = sr_set_item_str(st->sess, "/mixed-config:test-state/ll", val, NULL, SR_EDIT_STRICT);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read the data */
+    ret = sr_get_items(st->sess, "/mixed-config:test-state/ll", 0, 0, &values, &value_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_count, 2010);
+    assert_string_equal(values[0].data.string_val, "val0");
+    assert_string_equal(values[1000].data.string_val, "val0");
+    assert_string_equal(values[2000].data.string_val, "val0");
+    assert_string_equal(values[2009].data.string_val, "val9");
+    sr_free_values(values, value_count);
+
+    /* remove all the instances */
+    ret = sr_delete_item(st->sess, "/mixed-config:test-state/ll", SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read the data */
+    ret = sr_get_items(st->sess, "/mixed-config:test-state/ll", 0, 0, &values, &value_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_count, 0);
+    sr_free_values(values, value_count);
+
+    /* push many keyless state list instances, each value twice */
+    for (i = 0; i < 1000; ++i) {
+        sprintf(path, "/mixed-config:test-state/l[%d]/l1", i + 1);
+        sprintf(val, "val%d", i % 500);
+        ret = sr_set_item_str(st->sess, path, val, NULL, SR_EDIT_STRICT);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* push some more in a separate edit, merged using the index */
+    for (i = 0; i < 10; ++i) {
+        sprintf(path, "/mixed-config:test-state/l[%d]/l1", i + 1);
+        sprintf(val, "val%d", i);
+        ret = sr_set_item_str(st->sess, path, val, NULL, SR_EDIT_STRICT);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read the data */
+    ret = sr_get_items(st->sess, "/mixed-config:test-state/l/l1", 0, 0, &values, &value_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_count, 1010);
+    assert_string_equal(values[0].data.string_val, "val0");
+    assert_string_equal(values[500].data.string_val, "val0");
+    assert_string_equal(values[999].data.string_val, "val499");
+    assert_string_equal(values[1000].data.string_val, "val0");
+    assert_string_equal(values[1009].data.string_val, "val9");
+    sr_free_values(values, value_count);
+
+    /* remove all the instances */
+    ret = sr_delete_item(st->sess, "/mixed-config:test-state/l", SR_EDIT_STRICT);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* read the data */
+    ret = sr_get_items(st->sess, "/mixed-config:test-state/l", 0, 0, &values, &value_count);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(value_count, 0);
+    sr_free_values(values, value_count);
+}
+
 /* TEST */
 static void
 test_stored_config(void **state)
@@ -3830,12 +4202,17 @@ main(void)
         cmocka_unit_test_teardown(test_invalid, clear_up),
         cmocka_unit_test_teardown(test_mixed, clear_up),
         cmocka_unit_test_teardown(test_xpath_check, clear_up),
+        cmocka_unit_test_teardown(test_xpath_prepared, clear_up),
+        cmocka_unit_test_teardown(test_snapshot, clear_up),
+        cmocka_unit_test_teardown(test_get_data_multi, clear_up),
         cmocka_unit_test_teardown(test_state_only, clear_up),
         cmocka_unit_test_teardown(test_config_only, clear_up),
         cmocka_unit_test_teardown(test_conn_owner1, clear_up),
         cmocka_unit_test_teardown(test_conn_owner2, clear_up),
         cmocka_unit_test_teardown(test_stored_state, clear_up),
+        cmocka_unit_test_teardown(test_stored_cache, clear_up),
         cmocka_unit_test_teardown(test_stored_state_list, clear_up),
+        cmocka_unit_test_teardown(test_stored_state_list_many, clear_up),
         cmocka_unit_test_teardown(test_stored_config, clear_up),
         cmocka_unit_test_teardown(test_stored_top_list, clear_up),
         cmocka_unit_test_teardown(test_stored_np_cont1, clear_up),
@@ -21,6 +21,7 @@
  */
 #define _GNU_SOURCE
 
+#include <stdio.h>
 #include <string.h>
 #include <unistd.h>
 #include <setjmp.h>
@@ -63,6 +64,22 @@ setup_f(void **state)
     if (sr_install_module(st->conn, TESTS_DIR "/files/refs.yang", TESTS_DIR "/files", NULL, 0) != SR_ERR_OK) {
         return 1;
     }
+    if (sr_install_module(st->conn, TESTS_DIR "/files/refs2.yang", TESTS_DIR "/files", NULL, 0) != SR_ERR_OK) {
+        return 1;
+    }
+    if (sr_install_module(st->conn, TESTS_DIR "/files/defaults.yang", TESTS_DIR "/files", NULL, 0) != SR_ERR_OK) {
+        return 1;
+    }
+    if (sr_install_module(st->conn, TESTS_DIR "/files/example-module.yang", TESTS_DIR "/files", NULL, 0)
+            != SR_ERR_OK) {
+        return 1;
+    }
+    if (sr_install_module(st->conn, TESTS_DIR "/files/mandatory.yang", TESTS_DIR "/files", NULL, 0) != SR_ERR_OK) {
+        return 1;
+    }
+    if (sr_install_module_data(st->conn, "mandatory", "<cont xmlns=\"mand\"><l1/></cont>", NULL, LYD_XML) != SR_ERR_OK) {
+        return 1;
+    }
     sr_disconnect(st->conn);
 
     if (sr_connect(0, &(st->conn)) != SR_ERR_OK) {
@@ -81,6 +98,10 @@ teardown_f(void **state)
 {
     struct state *st = (struct state *)*state;
 
+    sr_remove_module(st->conn, "mandatory");
+    sr_remove_module(st->conn, "example-module");
+    sr_remove_module(st->conn, "defaults");
+    sr_remove_module(st->conn, "refs2");
     sr_remove_module(st->conn, "test");
     sr_remove_module(st->conn, "refs");
 
@@ -109,6 +130,36 @@ clear_test_refs(void **state)
     return 0;
 }
 
+static int
+clear_test_refs2(void **state)
+{
+    struct state *st = (struct state *)*state;
+
+    sr_delete_item(st->sess, "/refs2:lref", 0);
+    sr_delete_item(st->sess, "/refs2:l", 0);
+    sr_apply_changes(st->sess, 0, 1);
+
+    sr_delete_item(st->sess, "/test:test-leaf", 0);
+    sr_delete_item(st->sess, "/test:ll1[.='-1']", 0);
+    sr_delete_item(st->sess, "/test:ll1[.='-2']", 0);
+    sr_delete_item(st->sess, "/test:l1[k='one']", 0);
+    sr_delete_item(st->sess, "/test:cont", 0);
+    sr_apply_changes(st->sess, 0, 1);
+
+    return 0;
+}
+
+static int
+clear_parallel(void **state)
+{
+    struct state *st = (struct state *)*state;
+
+    sr_replace_config(st->sess, "defaults", NULL, 0, 1);
+    sr_replace_config(st->sess, "example-module", NULL, 0, 1);
+
+    return 0;
+}
+
 static void
 test_leafref(void **state)
 {
@@ -217,6 +268,64 @@ test_instid(void **state)
     assert_int_equal(ret, SR_ERR_OK);
 }
 
+static void
+test_inv_dep(void **state)
+{
+    struct state *st = (struct state *)*state;
+    int ret;
+
+    /* create valid data */
+    ret = sr_set_item_str(st->sess, "/test:test-leaf", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/test:ll1", "-1", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/refs2:lref", "10", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/refs2:l", "val", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* change nodes not referenced by the dependent module */
+    ret = sr_set_item_str(st->sess, "/test:cont/ll2", "5", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/test:l1[k='one']/v", "1", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* cause leafref not to point at a node, both with and without a diff */
+    ret = sr_set_item_str(st->sess, "/test:test-leaf", "8", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_validate(st->sess, NULL, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    ret = sr_delete_item(st->sess, "/test:test-leaf", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* break the must condition */
+    ret = sr_set_item_str(st->sess, "/test:ll1", "-2", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_set_item_str(st->sess, "/test:ll1", "-3", NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+    ret = sr_validate(st->sess, NULL, 0);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
 static void
 test_operational(void **state)
 {
@@ -270,13 +379,80 @@ test_operational(void **state)
     assert_int_equal(ret, SR_ERR_OK);
 }
 
+static void
+set_parallel_data(sr_session_ctx_t *sess)
+{
+    char path[128];
+    int ret, i;
+
+    for (i = 0; i < 1000; ++i) {
+        sprintf(path, "/defaults:l1[k='%d']", i);
+        ret = sr_set_item_str(sess, path, NULL, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+
+        sprintf(path, "/example-module:container/list[key1='%d'][key2='%d']", i, i);
+        ret = sr_set_item_str(sess, path, NULL, NULL, 0);
+        assert_int_equal(ret, SR_ERR_OK);
+    }
+    ret = sr_set_item_str(sess, "/defaults:l1[k='when-true']", NULL, NULL, 0);
+    assert_int_equal(ret, SR_ERR_OK);
+}
+
+static void
+test_parallel(void **state)
+{
+    struct state *st = (struct state *)*state;
+    sr_val_t *val;
+    int ret;
+
+    /* enough data of independent modules for them to be validated in parallel, with an invalid change */
+    set_parallel_data(st->sess);
+    ret = sr_delete_item(st->sess, "/mandatory:cont/l1", 0);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* the error of one of the modules is returned */
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_VALIDATION_FAILED);
+
+    ret = sr_discard_changes(st->sess);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* now only valid changes */
+    set_parallel_data(st->sess);
+    ret = sr_apply_changes(st->sess, 0, 1);
+    assert_int_equal(ret, SR_ERR_OK);
+
+    /* defaults created by validation of both the modules were stored */
+    ret = sr_get_item(st->sess, "/defaults:dflt2", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(val->data.string_val, "I exist!");
+    sr_free_val(val);
+
+    ret = sr_get_item(st->sess, "/defaults:l1[k='999']/cont1/cont2/dflt1", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_int_equal(val->data.uint8_val, 10);
+    sr_free_val(val);
+
+    ret = sr_get_item(st->sess, "/example-module:container/list[key1='999'][key2='999']/key2", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    assert_string_equal(val->data.string_val, "999");
+    sr_free_val(val);
+
+    /* the other module was not touched */
+    ret = sr_get_item(st->sess, "/mandatory:cont/l1", 0, &val);
+    assert_int_equal(ret, SR_ERR_OK);
+    sr_free_val(val);
+}
+
 int
 main(void)
 {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_teardown(test_leafref, clear_test_refs),
         cmocka_unit_test_teardown(test_instid, clear_test_refs),
+        cmocka_unit_test_teardown(test_inv_dep, clear_test_refs2),
         cmocka_unit_test(test_operational),
+        cmocka_unit_test_teardown(test_parallel, clear_parallel),
     };
 
     setenv("CMOCKA_TEST_ABORT", "1", 1);